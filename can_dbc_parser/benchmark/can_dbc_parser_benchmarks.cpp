@@ -0,0 +1,709 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Benchmarks for DBC loading, lookups and frame packing/unpacking.
+//
+// Usage: can_dbc_parser_benchmarks [benchmark flags] [dbc file]
+//
+// The dbc file defaults to the DBW DBC shipped with raptor_dbw_can. Results
+// are printed to the console and written as JSON to
+// can_dbc_parser_benchmarks.json unless --benchmark_out is given.
+
+#include <benchmark/benchmark.h>
+
+#include <can_dbc_parser/DbcBuilder.hpp>
+#include <can_dbc_parser/DbcUtilities.hpp>
+
+#include "LegacyUtilities.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef CAN_DBC_PARSER_BENCHMARK_DBC
+#define CAN_DBC_PARSER_BENCHMARK_DBC ""
+#endif
+
+namespace
+{
+const size_t SYNTHETIC_SIGNALS = 8;
+const size_t PAYLOAD_COUNT = 64;
+const size_t BATCH_SIZE = 1024;
+const double SIGNAL_MIN_TIME = 0.05;
+
+std::string dbcFile = CAN_DBC_PARSER_BENCHMARK_DBC;
+
+// DbcBuilder reports the size of every DBC it loads on stdout; keep that out
+// of the timing loops and the console output.
+class QuietStdout
+{
+public:
+  QuietStdout()
+  : _saved(std::cout.rdbuf(nullptr))
+  {
+  }
+
+  ~QuietStdout()
+  {
+    std::cout.rdbuf(_saved);
+  }
+
+private:
+  std::streambuf * _saved;
+};
+
+NewEagle::Dbc LoadDbc(const std::string & file)
+{
+  QuietStdout quiet;
+  return NewEagle::DbcBuilder().NewDbc(file);
+}
+
+// DbcBuilder only loads from files, so generated DBCs are written out first.
+class TempDbcFile
+{
+public:
+  explicit TempDbcFile(const std::string & text)
+  {
+    static int count = 0;
+    _path = (std::filesystem::temp_directory_path() /
+      ("can_dbc_parser_benchmarks_" + std::to_string(count++) + ".dbc")).string();
+
+    std::ofstream file(_path, std::ios::binary);
+    file << text;
+  }
+
+  ~TempDbcFile()
+  {
+    std::remove(_path.c_str());
+  }
+
+  const std::string & Path() const
+  {
+    return _path;
+  }
+
+private:
+  std::string _path;
+};
+
+NewEagle::Dbc ParseDbc(const std::string & text)
+{
+  TempDbcFile file(text);
+  return LoadDbc(file.Path());
+}
+
+// Empty when the DBC cannot be read; the benchmarks that need it are skipped.
+const NewEagle::Dbc & ShippedDbc()
+{
+  static const NewEagle::Dbc dbc = []() {
+      try {
+        return LoadDbc(dbcFile);
+      } catch (std::exception & ex) {
+        std::cerr << ex.what() << std::endl;
+        return NewEagle::Dbc();
+      }
+    }();
+  return dbc;
+}
+
+// Extended-ID messages of SYNTHETIC_SIGNALS 8-bit signals each, alternating
+// byte order, with a comment per message so CM_ parsing is part of the load.
+std::string SyntheticDbcText(size_t messageCount)
+{
+  std::string text = "VERSION \"\"\n\nBS_:\n\nBU_: Node\n\n";
+  char line[128];
+
+  for (size_t m = 0; m < messageCount; m++) {
+    uint32_t rawId = 0x80000000u | static_cast<uint32_t>(0x10000 + m);
+    snprintf(line, sizeof(line), "BO_ %u Message%zu: 8 Node\n", rawId, m);
+    text += line;
+
+    for (size_t s = 0; s < SYNTHETIC_SIGNALS; s++) {
+      bool intel = (0 == (s & 1));
+      snprintf(
+        line, sizeof(line), " SG_ Signal%zu : %zu|8@%c%c (0.5,-10) [0|0] \"unit\" Node\n",
+        s, intel ? s * 8 : s * 8 + 7, intel ? '1' : '0', (s & 2) ? '-' : '+');
+      text += line;
+    }
+
+    text += "\n";
+  }
+
+  for (size_t m = 0; m < messageCount; m++) {
+    uint32_t rawId = 0x80000000u | static_cast<uint32_t>(0x10000 + m);
+    snprintf(line, sizeof(line), "CM_ BO_ %u \"Synthetic message %zu\";\n", rawId, m);
+    text += line;
+  }
+
+  return text;
+}
+
+// Pseudo-random payloads, so no benchmark decodes the same frame every time.
+std::vector<uint8_t> RandomPayloads(size_t frameSize, size_t count)
+{
+  std::vector<uint8_t> payloads(frameSize * count);
+  uint64_t state = 0x9E3779B97F4A7C15ull;
+
+  for (size_t i = 0; i < payloads.size(); i++) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    payloads[i] = static_cast<uint8_t>(state);
+  }
+
+  return payloads;
+}
+
+bool CheckShippedDbc(benchmark::State & state)
+{
+  if (0 == ShippedDbc().GetMessageCount()) {
+    state.SkipWithError("DBC file not found or empty");
+    return false;
+  }
+
+  return true;
+}
+
+// Load time
+
+void BM_LoadShipped(benchmark::State & state)
+{
+  if (!CheckShippedDbc(state)) {
+    return;
+  }
+
+  for (auto _ : state) {
+    NewEagle::Dbc dbc = LoadDbc(dbcFile);
+    benchmark::DoNotOptimize(dbc);
+  }
+}
+BENCHMARK(BM_LoadShipped)->Unit(benchmark::kMicrosecond);
+
+void BM_LoadShippedCached(benchmark::State & state)
+{
+  if (!CheckShippedDbc(state)) {
+    return;
+  }
+
+  std::string cacheFile =
+    (std::filesystem::temp_directory_path() / "can_dbc_parser_benchmarks.cache").string();
+
+  std::remove(cacheFile.c_str());
+  {
+    QuietStdout quiet;
+    NewEagle::DbcBuilder().NewDbc(dbcFile, cacheFile);
+  }
+
+  for (auto _ : state) {
+    QuietStdout quiet;
+    NewEagle::Dbc dbc = NewEagle::DbcBuilder().NewDbc(dbcFile, cacheFile);
+    benchmark::DoNotOptimize(dbc);
+  }
+
+  std::remove(cacheFile.c_str());
+}
+BENCHMARK(BM_LoadShippedCached)->Unit(benchmark::kMicrosecond);
+
+void BM_LoadSynthetic(benchmark::State & state)
+{
+  std::string text = SyntheticDbcText(static_cast<size_t>(state.range(0)));
+  TempDbcFile file(text);
+
+  for (auto _ : state) {
+    NewEagle::Dbc dbc = LoadDbc(file.Path());
+    benchmark::DoNotOptimize(dbc);
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LoadSynthetic)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+// Lookups
+
+void BM_GetMessageById(benchmark::State & state)
+{
+  NewEagle::Dbc dbc = ParseDbc(SyntheticDbcText(static_cast<size_t>(state.range(0))));
+
+  std::vector<uint32_t> ids;
+  for (auto & entry : *dbc.GetMessages()) {
+    ids.push_back(entry.second.GetId());
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dbc.GetMessageById(ids[i]));
+    i = (i + 1 == ids.size()) ? 0 : i + 1;
+  }
+}
+BENCHMARK(BM_GetMessageById)->Arg(36)->Arg(1000)->Arg(10000);
+
+void BM_GetMessageByName(benchmark::State & state)
+{
+  NewEagle::Dbc dbc = ParseDbc(SyntheticDbcText(static_cast<size_t>(state.range(0))));
+
+  std::vector<std::string> names;
+  for (auto & entry : *dbc.GetMessages()) {
+    names.push_back(entry.first);
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dbc.GetMessage(names[i]));
+    i = (i + 1 == names.size()) ? 0 : i + 1;
+  }
+}
+BENCHMARK(BM_GetMessageByName)->Arg(36)->Arg(1000)->Arg(10000);
+
+void BM_GetSignalByName(benchmark::State & state)
+{
+  if (!CheckShippedDbc(state)) {
+    return;
+  }
+
+  NewEagle::Dbc dbc = ShippedDbc();
+
+  std::vector<std::pair<NewEagle::DbcMessage *, std::string>> signals;
+  for (auto & message : *dbc.GetMessages()) {
+    for (auto & signal : *message.second.GetSignals()) {
+      signals.emplace_back(&message.second, signal.first);
+    }
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(signals[i].first->GetSignal(signals[i].second));
+    i = (i + 1 == signals.size()) ? 0 : i + 1;
+  }
+}
+BENCHMARK(BM_GetSignalByName);
+
+void BM_GetSignalByHandle(benchmark::State & state)
+{
+  if (!CheckShippedDbc(state)) {
+    return;
+  }
+
+  NewEagle::Dbc dbc = ShippedDbc();
+
+  std::vector<std::pair<NewEagle::DbcMessage *, NewEagle::SignalHandle>> signals;
+  for (auto & message : *dbc.GetMessages()) {
+    for (uint32_t h = 0; h < message.second.GetSignalCount(); h++) {
+      signals.emplace_back(&message.second, static_cast<NewEagle::SignalHandle>(h));
+    }
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(signals[i].first->GetSignal(signals[i].second));
+    i = (i + 1 == signals.size()) ? 0 : i + 1;
+  }
+}
+BENCHMARK(BM_GetSignalByHandle);
+
+// Unpack/Pack per signal shape: range(0) is 1 for Motorola, range(1) is 1
+// for signed, range(2) is the length in bits.
+
+NewEagle::Dbc ShapeDbc(const benchmark::State & state)
+{
+  bool motorola = (0 != state.range(0));
+  int length = static_cast<int>(state.range(2));
+
+  char text[160];
+  snprintf(
+    text, sizeof(text), "BO_ 256 Shape: 8 Node\n SG_ Value : %d|%d@%c%c (0.5,1) [0|0] \"\" Node\n",
+    motorola ? 7 : 0, length, motorola ? '0' : '1', (0 != state.range(1)) ? '-' : '+');
+
+  return ParseDbc(text);
+}
+
+void ShapeArguments(benchmark::internal::Benchmark * benchmark)
+{
+  benchmark->ArgNames({"motorola", "signed", "bits"});
+
+  for (int64_t motorola = 0; motorola <= 1; motorola++) {
+    for (int64_t isSigned = 0; isSigned <= 1; isSigned++) {
+      for (int64_t bits : {1, 8, 12, 16, 32, 64}) {
+        benchmark->Args({motorola, isSigned, bits});
+      }
+    }
+  }
+}
+
+void BM_Unpack(benchmark::State & state)
+{
+  NewEagle::Dbc dbc = ShapeDbc(state);
+  const NewEagle::DbcSignal & signal = *dbc.GetMessageById(256)->GetSignal("Value");
+  std::vector<uint8_t> payloads = RandomPayloads(8, PAYLOAD_COUNT);
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(NewEagle::Unpack(&payloads[i * 8], signal));
+    i = (i + 1) % PAYLOAD_COUNT;
+  }
+}
+BENCHMARK(BM_Unpack)->Apply(ShapeArguments);
+
+void BM_PackValue(benchmark::State & state)
+{
+  NewEagle::Dbc dbc = ShapeDbc(state);
+  const NewEagle::DbcSignal & signal = *dbc.GetMessageById(256)->GetSignal("Value");
+
+  uint8_t payload[8] = {0};
+  double value = 0.0;
+  for (auto _ : state) {
+    NewEagle::PackValue(payload, signal, value);
+    benchmark::ClobberMemory();
+    value = (value < 100.0) ? value + 0.5 : 0.0;
+  }
+}
+BENCHMARK(BM_PackValue)->Apply(ShapeArguments);
+
+// Whole messages. The shipped DBC gets one benchmark per message, registered
+// in main once the file is known; the synthetic ones cover shapes the shipped
+// DBC lacks.
+
+const char * const MUX_DBC =
+  "BO_ 512 Mux: 8 Node\n"
+  " SG_ Switch M : 0|8@1+ (1,0) [0|0] \"\" Node\n"
+  " SG_ Common : 8|8@1+ (1,0) [0|0] \"\" Node\n"
+  " SG_ A0 m0 : 16|16@1- (0.1,0) [0|0] \"\" Node\n"
+  " SG_ A1 m0 : 39|16@0+ (0.1,0) [0|0] \"\" Node\n"
+  " SG_ B0 m1 : 16|24@1+ (1,0) [0|0] \"\" Node\n"
+  " SG_ B1 m1 : 47|12@0- (0.5,0) [0|0] \"\" Node\n"
+  " SG_ C0 m2 : 16|48@1+ (1,0) [0|0] \"\" Node\n";
+
+const char * const FD_DBC =
+  "BO_ 768 Fd: 64 Node\n"
+  " SG_ Head : 0|16@1+ (1,0) [0|0] \"\" Node\n"
+  " SG_ Mid : 256|32@1- (0.01,0) [0|0] \"\" Node\n"
+  " SG_ Wide : 320|64@1+ (1,0) [0|0] \"\" Node\n"
+  " SG_ Tail : 503|16@0+ (1,0) [0|0] \"\" Node\n";
+
+void SetFrame(benchmark::State & state, NewEagle::DbcMessage message, bool lazy)
+{
+  size_t frameSize = message.GetFrameSize();
+  std::vector<uint8_t> payloads = RandomPayloads(frameSize, PAYLOAD_COUNT);
+  NewEagle::DbcSignal * first = message.GetSignal(NewEagle::SignalHandle(0));
+
+  message.SetLazyDecode(lazy);
+
+  size_t i = 0;
+  for (auto _ : state) {
+    message.SetFrame(&payloads[i * frameSize], frameSize);
+    // A handler reads at least one signal; in lazy mode this is what decodes it.
+    benchmark::DoNotOptimize(first->GetResult());
+    i = (i + 1) % PAYLOAD_COUNT;
+  }
+}
+
+void GetFrame(benchmark::State & state, NewEagle::DbcMessage message)
+{
+  uint8_t payload[64];
+  NewEagle::DbcSignal * first = message.GetSignal(NewEagle::SignalHandle(0));
+
+  // Publishers change a signal or two between frames.
+  int64_t raw = 0;
+  for (auto _ : state) {
+    first->SetRaw(raw);
+    raw ^= 1;
+    benchmark::DoNotOptimize(message.GetFrame(payload, sizeof(payload)));
+  }
+}
+
+void Decode(benchmark::State & state, const NewEagle::DbcMessage & message)
+{
+  size_t frameSize = message.GetFrameSize();
+  std::vector<uint8_t> payloads = RandomPayloads(frameSize, PAYLOAD_COUNT);
+  std::vector<int64_t> values(message.GetSignalCount());
+
+  size_t i = 0;
+  for (auto _ : state) {
+    message.DecodeRaw(&payloads[i * frameSize], values.data());
+    benchmark::ClobberMemory();
+    i = (i + 1) % PAYLOAD_COUNT;
+  }
+}
+
+void Encode(benchmark::State & state, NewEagle::DbcMessage message)
+{
+  std::vector<double> values(message.GetSignalCount());
+  for (uint32_t h = 0; h < message.GetSignalCount(); h++) {
+    values[h] = message.GetSignal(static_cast<NewEagle::SignalHandle>(h))->GetInitialValue();
+  }
+
+  uint8_t payload[64];
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(message.Encode(values.data(), payload, sizeof(payload)));
+  }
+}
+
+void DecodeBatch(benchmark::State & state, const NewEagle::DbcMessage & message)
+{
+  size_t frameSize = message.GetFrameSize();
+  std::vector<uint8_t> payloads = RandomPayloads(frameSize, BATCH_SIZE);
+  std::vector<std::vector<double>> columns(
+    message.GetSignalCount(), std::vector<double>(BATCH_SIZE));
+
+  std::vector<double *> columnPointers;
+  for (auto & column : columns) {
+    columnPointers.push_back(column.data());
+  }
+
+  for (auto _ : state) {
+    message.DecodeBatch(payloads.data(), frameSize, BATCH_SIZE, columnPointers.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH_SIZE));
+}
+
+void RegisterMessage(const std::string & label, const NewEagle::DbcMessage & message)
+{
+  if (0 == message.GetSignalCount()) {
+    return;
+  }
+
+  benchmark::RegisterBenchmark(
+    ("BM_SetFrame/" + label).c_str(),
+    [message](benchmark::State & state) {SetFrame(state, message, false);});
+  benchmark::RegisterBenchmark(
+    ("BM_SetFrameLazy/" + label).c_str(),
+    [message](benchmark::State & state) {SetFrame(state, message, true);});
+  benchmark::RegisterBenchmark(
+    ("BM_GetFrame/" + label).c_str(),
+    [message](benchmark::State & state) {GetFrame(state, message);});
+  benchmark::RegisterBenchmark(
+    ("BM_DecodeRaw/" + label).c_str(),
+    [message](benchmark::State & state) {Decode(state, message);});
+  benchmark::RegisterBenchmark(
+    ("BM_Encode/" + label).c_str(),
+    [message](benchmark::State & state) {Encode(state, message);});
+  benchmark::RegisterBenchmark(
+    ("BM_DecodeBatch/" + label).c_str(),
+    [message](benchmark::State & state) {DecodeBatch(state, message);});
+}
+
+// Every signal of the shipped DBC, unpacked and packed the way the parser
+// did before extraction plans (Legacy) and the way it does now. Only signals
+// the legacy code handled, up to 32 bits in a classic frame, are compared.
+
+bool LegacyHandles(const NewEagle::DbcSignal & signal)
+{
+  return signal.GetDlc() <= 8 && signal.GetLength() <= 32;
+}
+
+// Physical values to pack, decoded from random payloads so they are in range.
+std::vector<double> SignalValues(const NewEagle::DbcSignal & signal)
+{
+  std::vector<uint8_t> payloads = RandomPayloads(8, PAYLOAD_COUNT);
+  std::vector<double> values(PAYLOAD_COUNT);
+
+  for (size_t i = 0; i < PAYLOAD_COUNT; i++) {
+    values[i] = NewEagle::Unpack(&payloads[i * 8], signal);
+  }
+
+  return values;
+}
+
+void UnpackSignal(benchmark::State & state, const NewEagle::DbcSignal & signal, bool legacy)
+{
+  std::vector<uint8_t> payloads = RandomPayloads(8, PAYLOAD_COUNT);
+
+  size_t i = 0;
+  for (auto _ : state) {
+    const uint8_t * payload = &payloads[i * 8];
+    benchmark::DoNotOptimize(
+      legacy ? NewEagle::Legacy::Unpack(payload, signal) : NewEagle::Unpack(payload, signal));
+    i = (i + 1) % PAYLOAD_COUNT;
+  }
+}
+
+void PackSignal(benchmark::State & state, const NewEagle::DbcSignal & signal, bool legacy)
+{
+  std::vector<double> values = SignalValues(signal);
+
+  uint8_t payload[8] = {0};
+  size_t i = 0;
+  for (auto _ : state) {
+    if (legacy) {
+      NewEagle::Legacy::Pack(payload, signal, values[i]);
+    } else {
+      NewEagle::PackValue(payload, signal, values[i]);
+    }
+    benchmark::ClobberMemory();
+    i = (i + 1) % PAYLOAD_COUNT;
+  }
+}
+
+// One pass over all compared signals per iteration, for a single figure.
+void BM_UnpackAllSignals(benchmark::State & state, bool legacy)
+{
+  if (!CheckShippedDbc(state)) {
+    return;
+  }
+
+  NewEagle::Dbc dbc = ShippedDbc();
+  std::vector<const NewEagle::DbcSignal *> signals;
+  for (auto & message : *dbc.GetMessages()) {
+    for (auto & signal : *message.second.GetSignals()) {
+      if (LegacyHandles(signal.second)) {
+        signals.push_back(&signal.second);
+      }
+    }
+  }
+
+  std::vector<uint8_t> payloads = RandomPayloads(8, PAYLOAD_COUNT);
+
+  size_t i = 0;
+  for (auto _ : state) {
+    const uint8_t * payload = &payloads[i * 8];
+    for (const NewEagle::DbcSignal * signal : signals) {
+      benchmark::DoNotOptimize(
+        legacy ? NewEagle::Legacy::Unpack(payload, *signal) : NewEagle::Unpack(payload, *signal));
+    }
+    i = (i + 1) % PAYLOAD_COUNT;
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * signals.size()));
+}
+BENCHMARK_CAPTURE(BM_UnpackAllSignals, legacy, true);
+BENCHMARK_CAPTURE(BM_UnpackAllSignals, plan, false);
+
+void BM_PackAllSignals(benchmark::State & state, bool legacy)
+{
+  if (!CheckShippedDbc(state)) {
+    return;
+  }
+
+  NewEagle::Dbc dbc = ShippedDbc();
+  std::vector<std::pair<const NewEagle::DbcSignal *, std::vector<double>>> signals;
+  for (auto & message : *dbc.GetMessages()) {
+    for (auto & signal : *message.second.GetSignals()) {
+      if (LegacyHandles(signal.second)) {
+        signals.emplace_back(&signal.second, SignalValues(signal.second));
+      }
+    }
+  }
+
+  uint8_t payload[8] = {0};
+  size_t i = 0;
+  for (auto _ : state) {
+    for (auto & signal : signals) {
+      if (legacy) {
+        NewEagle::Legacy::Pack(payload, *signal.first, signal.second[i]);
+      } else {
+        NewEagle::PackValue(payload, *signal.first, signal.second[i]);
+      }
+    }
+    benchmark::ClobberMemory();
+    i = (i + 1) % PAYLOAD_COUNT;
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * signals.size()));
+}
+BENCHMARK_CAPTURE(BM_PackAllSignals, legacy, true);
+BENCHMARK_CAPTURE(BM_PackAllSignals, plan, false);
+
+void RegisterSignals(const std::string & label, NewEagle::DbcMessage & message)
+{
+  for (auto & entry : *message.GetSignals()) {
+    const NewEagle::DbcSignal & signal = entry.second;
+    if (!LegacyHandles(signal)) {
+      continue;
+    }
+
+    std::string name = label + "." + entry.first;
+    for (bool legacy : {true, false}) {
+      std::string variant = legacy ? "/legacy/" : "/plan/";
+      benchmark::RegisterBenchmark(
+        ("BM_UnpackSignal" + variant + name).c_str(),
+        [signal, legacy](benchmark::State & state) {UnpackSignal(state, signal, legacy);})
+      ->MinTime(SIGNAL_MIN_TIME);
+      benchmark::RegisterBenchmark(
+        ("BM_PackSignal" + variant + name).c_str(),
+        [signal, legacy](benchmark::State & state) {PackSignal(state, signal, legacy);})
+      ->MinTime(SIGNAL_MIN_TIME);
+    }
+  }
+}
+
+void RegisterMessages()
+{
+  for (const char * text : {MUX_DBC, FD_DBC}) {
+    NewEagle::Dbc dbc = ParseDbc(text);
+    for (auto & message : *dbc.GetMessages()) {
+      RegisterMessage("synthetic/" + message.first, message.second);
+    }
+  }
+
+  NewEagle::Dbc dbc = ShippedDbc();
+  for (auto & message : *dbc.GetMessages()) {
+    RegisterMessage(message.first, message.second);
+    RegisterSignals(message.first, message.second);
+  }
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  // JSON results go to a file by default so they can be kept per release.
+  std::vector<char *> args(argv, argv + argc);
+  bool hasOut = false;
+  for (int i = 1; i < argc; i++) {
+    hasOut = hasOut || (0 == strncmp(argv[i], "--benchmark_out=", 16));
+  }
+
+  char outFlag[] = "--benchmark_out=can_dbc_parser_benchmarks.json";
+  char formatFlag[] = "--benchmark_out_format=json";
+  if (!hasOut) {
+    args.insert(args.begin() + 1, {outFlag, formatFlag});
+  }
+
+  int count = static_cast<int>(args.size());
+  benchmark::Initialize(&count, args.data());
+
+  if (count > 2) {
+    std::cerr << "Usage: " << argv[0] << " [benchmark flags] [dbc file]" << std::endl;
+    return 1;
+  }
+  if (2 == count) {
+    dbcFile = args[1];
+  }
+
+  RegisterMessages();
+
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
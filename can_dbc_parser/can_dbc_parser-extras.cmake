@@ -0,0 +1,5 @@
+# Code generator installed by can_dbc_parser, used by can_dbc_generate()
+set(can_dbc_parser_CODEGEN_EXECUTABLE
+  "${can_dbc_parser_DIR}/../../../lib/can_dbc_parser/can_dbc_codegen")
+
+include("${can_dbc_parser_DIR}/can_dbc_generate.cmake")
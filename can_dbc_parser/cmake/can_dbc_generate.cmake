@@ -0,0 +1,33 @@
+# can_dbc_generate(<target> <dbc file>)
+#
+# Generates can_dbc_generated/<name>.hpp from a DBC file at build time and adds
+# it to the include path of <target>. <name> is the DBC file name without its
+# extension, lower-cased and turned into a C identifier; the generated structs
+# live in a namespace of the same name.
+#
+# Example:
+#   can_dbc_generate(my_node launch/New_Eagle_DBW_3.4.dbc)
+#   #include <can_dbc_generated/new_eagle_dbw_3_4.hpp>
+function(can_dbc_generate target dbc_file)
+  get_filename_component(_dbc_file "${dbc_file}" ABSOLUTE)
+  get_filename_component(_dbc_name "${_dbc_file}" NAME)
+  string(REGEX REPLACE "\\.[^.]*$" "" _dbc_name "${_dbc_name}")
+  string(MAKE_C_IDENTIFIER "${_dbc_name}" _dbc_name)
+  string(TOLOWER "${_dbc_name}" _dbc_name)
+
+  set(_output_dir "${CMAKE_CURRENT_BINARY_DIR}/can_dbc_generated")
+  set(_header "${_output_dir}/can_dbc_generated/${_dbc_name}.hpp")
+
+  add_custom_command(
+    OUTPUT "${_header}"
+    COMMAND ${CMAKE_COMMAND} -E make_directory "${_output_dir}/can_dbc_generated"
+    COMMAND ${can_dbc_parser_CODEGEN_EXECUTABLE} "${_dbc_file}" "${_header}" "${_dbc_name}"
+    DEPENDS "${_dbc_file}" ${can_dbc_parser_CODEGEN_EXECUTABLE}
+    COMMENT "Generating DBC decoders from ${dbc_file}"
+    VERBATIM
+  )
+
+  add_custom_target(${target}_${_dbc_name}_dbc DEPENDS "${_header}")
+  add_dependencies(${target} ${target}_${_dbc_name}_dbc)
+  target_include_directories(${target} PRIVATE "${_output_dir}")
+endfunction()
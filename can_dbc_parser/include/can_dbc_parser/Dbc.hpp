@@ -34,6 +34,8 @@
 #include <cctype>
 #include <map>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace NewEagle
 {
@@ -41,15 +43,50 @@ class Dbc
 {
 public:
   Dbc() = default;
+  Dbc(const Dbc & other);
+  Dbc(Dbc && other) = default;
+  Dbc & operator=(const Dbc & other);
+  Dbc & operator=(Dbc && other) = default;
 
-  void AddMessage(NewEagle::DbcMessage message);
-  NewEagle::DbcMessage * GetMessage(std::string messageName);
+  // Moves the message in and returns where it is stored; std::map nodes never
+  // move, so the pointer stays valid. A message whose name is already taken is
+  // dropped and the existing one returned.
+  NewEagle::DbcMessage * AddMessage(NewEagle::DbcMessage message);
+  NewEagle::DbcMessage * GetMessage(std::string_view messageName);
+  const NewEagle::DbcMessage * GetMessage(std::string_view messageName) const;
   NewEagle::DbcMessage * GetMessageById(uint32_t id);
-  uint16_t GetMessageCount();
+  const NewEagle::DbcMessage * GetMessageById(uint32_t id) const;
+  NewEagle::DbcMessage * GetMessageById(uint32_t id, NewEagle::IdType idType);
+  const NewEagle::DbcMessage * GetMessageById(uint32_t id, NewEagle::IdType idType) const;
+  uint16_t GetMessageCount() const;
   std::map<std::string, NewEagle::DbcMessage> * GetMessages();
 
 private:
+  // Open-addressed CAN ID index. Standard and extended IDs are kept apart by
+  // tagging extended keys with bit 31, the same convention the DBC uses for raw IDs.
+  struct IdIndexEntry
+  {
+    uint32_t Key;
+    NewEagle::DbcMessage * Message;
+  };
+
+  // Message names in sorted order, viewing the keys of _messages, so a name
+  // lookup is a binary search over one array and never builds a std::string.
+  struct NameIndexEntry
+  {
+    std::string_view Name;
+    NewEagle::DbcMessage * Message;
+  };
+
+  static bool NameBefore(const NameIndexEntry & entry, std::string_view name);
+  static uint32_t IndexKey(uint32_t id, NewEagle::IdType idType);
+  void IndexMessage(NewEagle::DbcMessage * message);
+  void RebuildIndex();
+
   std::map<std::string, NewEagle::DbcMessage> _messages;
+  std::vector<NameIndexEntry> _nameIndex;
+  std::vector<IdIndexEntry> _idIndex;
+  uint32_t _idIndexShift = 32;
 };
 }  // namespace NewEagle
 
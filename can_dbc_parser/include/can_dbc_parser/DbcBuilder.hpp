@@ -34,7 +34,8 @@
 
 #include <sstream>
 #include <string>
-#include <fstream>
+#include <string_view>
+#include <utility>
 
 namespace NewEagle
 {
@@ -61,7 +62,14 @@ public:
 
   NewEagle::Dbc NewDbc(const std::string & dbcFile);
 
+  // Same as NewDbc(dbcFile), but loads cacheFile instead of parsing when it was
+  // built from the same DBC text, and (re)writes it otherwise.
+  NewEagle::Dbc NewDbc(const std::string & dbcFile, const std::string & cacheFile);
+
 private:
+  // Parses DBC text; lines are numbered from 1 for error messages.
+  NewEagle::Dbc Parse(std::string_view text);
+
   std::string MessageToken;
   std::string SignalToken;
   std::string CommentToken;
@@ -91,15 +99,22 @@ __attribute__((unused)) static NewEagle::DbcAttribute ReadAttribute(NewEagle::Li
 
   try {
     attribute.AttributeName = parser.ReadQuotedString();
-    if (attribute.AttributeName == "GenSigStartValue") {
+    if ((attribute.AttributeName == "GenSigStartValue") ||
+      (attribute.AttributeName == "GenSigChecksumType") ||
+      (attribute.AttributeName == "GenSigRollingCounter"))
+    {
       attribute.ObjectType = parser.ReadCIdentifier();
       attribute.Id = parser.ReadUInt("id");
       if (attribute.ObjectType == "SG_") {
         attribute.SignalName = parser.ReadCIdentifier();
 
-        std::ostringstream sstream;
-        sstream << parser.ReadDouble();
-        attribute.Value = sstream.str();
+        if (attribute.AttributeName == "GenSigChecksumType") {
+          attribute.Value = parser.ReadQuotedString();
+        } else {
+          std::ostringstream sstream;
+          sstream << parser.ReadDouble();
+          attribute.Value = sstream.str();
+        }
       }
     }
   } catch (std::exception & ex) {
@@ -138,13 +153,15 @@ __attribute__((unused)) static  NewEagle::DbcMessage ReadMessage(NewEagle::LineP
   std::string sendingNode(parser.ReadCIdentifier("transmitter"));
   uint32_t id = (uint32_t)(canId & 0x3FFFFFFFu);
 
-  NewEagle::DbcMessage msg(dlc, id, idType, name, canId);
-  return msg;
+  return NewEagle::DbcMessage(dlc, id, idType, std::move(name), canId);
 }
 
-__attribute__((unused)) static NewEagle::DbcSignal ReadSignal(NewEagle::LineParser parser)
+// dlc is the payload length of the message the signal belongs to; signals of
+// CAN FD messages may be placed anywhere in it.
+__attribute__((unused)) static NewEagle::DbcSignal ReadSignal(
+  NewEagle::LineParser parser, uint8_t dlc = 8)
 {
-  std::string name = parser.ReadCIdentifier();
+  std::string_view name = parser.ReadCIdentifierView();
   char mux = parser.ReadNextChar("mux");
   NewEagle::MultiplexerMode multiplexMode = NewEagle::NONE;
   int32_t muxSwitch = 0;
@@ -166,7 +183,7 @@ __attribute__((unused)) static NewEagle::DbcSignal ReadSignal(NewEagle::LinePars
       throw std::runtime_error("Synxax Error: Expected \':\' " + parser.GetPosition());
   }
 
-  int32_t startBit = parser.ReadUInt("start bit");
+  uint16_t startBit = parser.ReadUInt("start bit");
 
   parser.SeekSeparator('|');
 
@@ -225,24 +242,14 @@ __attribute__((unused)) static NewEagle::DbcSignal ReadSignal(NewEagle::LinePars
   parser.ReadDouble("maximum");
   parser.SeekSeparator(']');
 
-  // Need to include Min, Max, DataType, MuxSwitch, Unit, Receiver
-  // Find a way to include the DLC...
-  NewEagle::DbcSignal * signal;
-
-  if (NewEagle::MUX_SIGNAL == multiplexMode) {
-    signal = new NewEagle::DbcSignal(
-      8, gain, offset, startBit, endianness,
-      length, sign, name,
-      multiplexMode, muxSwitch);
-  } else {
-    signal = new NewEagle::DbcSignal(
-      8, gain, offset, startBit, endianness,
-      length, sign, name,
-      multiplexMode);
-  }
+  // Need to include Min, Max, DataType, Unit, Receiver
+  NewEagle::DbcSignal signal(
+    dlc, gain, offset, startBit, endianness,
+    length, sign, name,
+    multiplexMode, muxSwitch);
 
-  signal->SetDataType(type);
-  return NewEagle::DbcSignal(*signal);
+  signal.SetDataType(type);
+  return signal;
 }
 }  // namespace NewEagle
 
@@ -0,0 +1,65 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef CAN_DBC_PARSER__DBCCACHE_HPP_
+#define CAN_DBC_PARSER__DBCCACHE_HPP_
+
+#include <can_dbc_parser/Dbc.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace NewEagle
+{
+// Compiled binary form of a parsed DBC: a flat table of messages, a flat table
+// of signals and one block of interned, NUL-terminated names. Files are
+// mmap'ed on load and only accepted when the format version and the hash of
+// the DBC text they were built from both match.
+class DbcCache
+{
+public:
+  static const uint32_t VERSION = 6;
+
+  // FNV-1a, 64 bit. Pass the previous result as hash to continue a running hash.
+  static uint64_t Hash(const void * data, size_t size, uint64_t hash = 14695981039346656037ull);
+
+  // Returns false if the file is missing, stale, from another format version or damaged.
+  static bool Load(const std::string & cacheFile, uint64_t sourceHash, NewEagle::Dbc & dbc);
+
+  // Writes to a temporary file and renames it into place. Returns false on failure.
+  static bool Save(const std::string & cacheFile, uint64_t sourceHash, NewEagle::Dbc & dbc);
+
+  // Where to keep the cache for dbcFile when the user has not said: dbc_cache
+  // under $ROS_HOME (~/.ros if unset), created on demand, since DBC files are
+  // usually installed read-only. Empty, i.e. no cache, if there is nowhere to write.
+  static std::string DefaultFile(const std::string & dbcFile);
+};
+}  // namespace NewEagle
+
+#endif  // CAN_DBC_PARSER__DBCCACHE_HPP_
@@ -0,0 +1,55 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef CAN_DBC_PARSER__DBCCHECKSUM_HPP_
+#define CAN_DBC_PARSER__DBCCHECKSUM_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace NewEagle
+{
+// Frame checksums, selected per message with the GenSigChecksumType signal
+// attribute. All of them are one byte, computed over every payload byte
+// except the checksum itself.
+enum ChecksumType
+{
+  CHECKSUM_NONE = 0,
+  CHECKSUM_CRC8_SAE_J1850 = 1,  // poly 0x1D, init 0xFF, final XOR 0xFF
+  CHECKSUM_XOR = 2,
+  CHECKSUM_ADD = 3              // sum of the bytes, modulo 256
+};
+
+// Returns false if name is not one of "NONE", "CRC8_SAE_J1850", "XOR" or "ADD".
+bool ParseChecksumType(const std::string & name, ChecksumType & type);
+
+uint8_t ComputeChecksum(ChecksumType type, const uint8_t * data, size_t length);
+}  // namespace NewEagle
+
+#endif  // CAN_DBC_PARSER__DBCCHECKSUM_HPP_
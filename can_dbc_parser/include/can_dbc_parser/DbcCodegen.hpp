@@ -0,0 +1,104 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef CAN_DBC_PARSER__DBCCODEGEN_HPP_
+#define CAN_DBC_PARSER__DBCCODEGEN_HPP_
+
+#include <cstdint>
+#include <type_traits>
+
+// Helpers used by headers generated with can_dbc_generate(). The shift and mask
+// constants come from DbcSignalPlan at generation time, so these reproduce
+// UnpackRaw/PackValue with no per-signal lookups.
+namespace NewEagle
+{
+namespace codegen
+{
+template<bool BigEndian>
+constexpr uint64_t LoadWord(const uint8_t * data)
+{
+  uint64_t word = 0;
+
+  for (int32_t i = 0; i < 8; i++) {
+    word |= static_cast<uint64_t>(data[i]) << (8 * (BigEndian ? 7 - i : i));
+  }
+
+  return word;
+}
+
+template<bool BigEndian>
+constexpr void StoreWord(uint8_t * data, uint64_t word)
+{
+  for (int32_t i = 0; i < 8; i++) {
+    data[i] = static_cast<uint8_t>(word >> (8 * (BigEndian ? 7 - i : i)));
+  }
+}
+
+// Signed fields come back as int64_t, unsigned ones as uint64_t, so fields of
+// any length up to 64 bits convert to double without wrapping.
+template<uint8_t LeftShift, uint8_t RightShift, bool Signed>
+constexpr typename std::conditional<Signed, int64_t, uint64_t>::type Extract(uint64_t word)
+{
+  return Signed ?
+         static_cast<typename std::conditional<Signed, int64_t, uint64_t>::type>(
+           static_cast<int64_t>(word << LeftShift) >> RightShift) :
+         static_cast<typename std::conditional<Signed, int64_t, uint64_t>::type>(
+           (word << LeftShift) >> RightShift);
+}
+
+// Same conversion as ToRaw: saturates past the 64-bit range, NaN is 0.
+template<bool Signed>
+constexpr uint64_t ToInteger(double raw)
+{
+  if (raw != raw) {
+    return 0;
+  }
+  if (raw >= 9223372036854775808.0) {
+    if (Signed) {
+      return static_cast<uint64_t>(INT64_MAX);
+    }
+    return raw >= 18446744073709551616.0 ? UINT64_MAX : static_cast<uint64_t>(raw);
+  }
+  if (raw < -9223372036854775808.0) {
+    return static_cast<uint64_t>(INT64_MIN);
+  }
+
+  return static_cast<uint64_t>(static_cast<int64_t>(raw));
+}
+
+template<uint8_t Shift, uint64_t Mask, bool Signed>
+constexpr uint64_t Insert(uint64_t word, double raw)
+{
+  uint64_t value = ToInteger<Signed>(raw);
+
+  return (word & ~Mask) | ((static_cast<uint64_t>(value) << Shift) & Mask);
+}
+}  // namespace codegen
+}  // namespace NewEagle
+
+#endif  // CAN_DBC_PARSER__DBCCODEGEN_HPP_
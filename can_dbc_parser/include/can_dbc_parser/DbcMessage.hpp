@@ -30,10 +30,14 @@
 #define CAN_DBC_PARSER__DBCMESSAGE_HPP_
 
 #include <can_msgs/msg/frame.hpp>
+#include <can_dbc_parser/DbcChecksum.hpp>
 #include <can_dbc_parser/DbcSignal.hpp>
 
+#include <limits>
 #include <map>
 #include <string>
+#include <string_view>
+#include <vector>
 
 using can_msgs::msg::Frame;
 
@@ -45,12 +49,42 @@ struct DbcMessageComment
   std::string Comment;
 };
 
+// Index of a signal within its message, in the order the signals were added.
+// Resolve it once with DbcMessage::GetSignalHandle() and reuse it on every frame.
+typedef uint16_t SignalHandle;
+
+static const SignalHandle NO_SIGNAL = 0xFFFF;
+
+// What decoding and encoding one signal takes, copied out of the DbcSignal so
+// a message walks a small contiguous array instead of its map nodes.
+struct DbcSignalRecord
+{
+  NewEagle::DbcSignalPlan Plan;
+  double Gain;
+  double Offset;
+  SignalHandle Handle;
+  uint16_t StartBit;
+};
+
 enum IdType
 {
   STD = 0,
   EXT = 1
 };
 
+// Column kernels DecodeBatch can run on signals of up to 32 bits. The fastest
+// one the CPU supports is picked on first use; SetDecodeBatchKernel pins
+// another (tests use it to cover each one) and returns false, changing
+// nothing, if this CPU or build cannot run it.
+enum DecodeBatchKernel
+{
+  BATCH_KERNEL_SCALAR = 0,
+  BATCH_KERNEL_SSE2 = 1,
+  BATCH_KERNEL_AVX2 = 2
+};
+
+bool SetDecodeBatchKernel(DecodeBatchKernel kernel);
+
 typedef struct
 {
   uint8_t : 8;
@@ -74,25 +108,149 @@ public:
     std::string name,
     uint32_t rawId
   );
+  DbcMessage(const DbcMessage & other);
+  DbcMessage(DbcMessage && other);
+  DbcMessage & operator=(const DbcMessage & other);
+  DbcMessage & operator=(DbcMessage && other);
 
-  uint8_t GetDlc();
-  uint32_t GetId();
-  IdType GetIdType();
-  std::string GetName();
+  uint8_t GetDlc() const;
+  uint32_t GetId() const;
+  IdType GetIdType() const;
+  std::string GetName() const;
   Frame GetFrame();
-  uint32_t GetSignalCount();
+  uint32_t GetSignalCount() const;
   void SetFrame(const Frame::SharedPtr msg);
-  void AddSignal(std::string signalName, NewEagle::DbcSignal signal);
-  NewEagle::DbcSignal * GetSignal(std::string signalName);
+
+  // Bytes a payload buffer has to hold for this message: the DLC, but at least
+  // 8 since classic frames are always read as a whole 8-byte word.
+  size_t GetFrameSize() const;
+
+  // Raw payload variants, needed for CAN FD messages (DLC up to 64) that do not
+  // fit in a Frame. Payloads shorter than GetFrameSize() are read as if
+  // zero-padded. GetFrame writes at most length bytes and returns the DLC.
+  // The Frame-returning GetFrame() and Encode() throw std::runtime_error for
+  // messages longer than 8 bytes rather than send a truncated payload.
+  void SetFrame(const uint8_t * data, size_t length);
+  size_t GetFrame(uint8_t * data, size_t length);
+
+  // Lazy mode: SetFrame only keeps a copy of the payload, and each signal is
+  // decoded the first time its result is read after that. Pays off for
+  // handlers that read a few signals of a large message. Off by default.
+  void SetLazyDecode(bool lazy);
+  bool GetLazyDecode() const;
+  void AddSignal(std::string signalName, const NewEagle::DbcSignal & signal);
+
+  // Sizes the per-signal arrays for count signals, so adding them does not
+  // reallocate. Only a hint; more signals can still be added.
+  void ReserveSignals(size_t count);
+  NewEagle::DbcSignal * GetSignal(std::string_view signalName);
+  NewEagle::DbcSignal * GetSignal(SignalHandle handle);
+  const NewEagle::DbcSignal * GetSignal(SignalHandle handle) const;
+  SignalHandle GetSignalHandle(std::string_view signalName) const;
   void SetRawText(std::string rawText);
-  uint32_t GetRawId();
+  uint32_t GetRawId() const;
   void SetComment(NewEagle::DbcMessageComment comment);
   std::map<std::string, NewEagle::DbcSignal> * GetSignals();
-  bool AnyMultiplexedSignals();
+  bool AnyMultiplexedSignals() const;
+
+  // Frame protection, set from the GenSigChecksumType and GenSigRollingCounter
+  // attributes. The checksum signal must be a whole byte; it is filled in by
+  // GetFrame and Encode after all other signals are packed. GetFrame also
+  // writes the rolling counter, which goes up by one per frame and wraps at
+  // the signal's width; Encode takes the counter from values like any signal.
+  // Pass CHECKSUM_NONE or NO_SIGNAL to turn either off.
+  void SetChecksum(SignalHandle signal, NewEagle::ChecksumType type);
+  void SetRollingCounter(SignalHandle signal);
+  NewEagle::ChecksumType GetChecksumType() const;
+  SignalHandle GetChecksumSignal() const;
+  SignalHandle GetRollingCounterSignal() const;
+
+  // Whether SetChecksum/SetRollingCounter were called at all, i.e. whether the
+  // DBC has the attribute for this message. An explicit "NONE" or 0 counts as
+  // declared, so callers can tell it from a DBC that predates the attributes.
+  bool IsChecksumDeclared() const;
+  bool IsRollingCounterDeclared() const;
+
+  // Stateless decode/encode. Values are indexed by SignalHandle and the arrays
+  // must hold GetSignalCount() entries; data must hold GetFrameSize() bytes.
+  // These never touch the signals' stored results, so a loaded Dbc can be
+  // shared between threads.
+  // Multiplexed signals not selected by the switch are left untouched.
+  void Decode(const uint8_t * data, double * values) const;
+  void DecodeRaw(const uint8_t * data, int64_t * values) const;
+  Frame Encode(const double * values) const;
+  size_t Encode(const double * values, uint8_t * data, size_t length) const;
+
+  // Decodes count frames of this message in one call. Payload k starts at
+  // payloads + k * stride and must hold GetFrameSize() bytes; columns[handle][k] receives
+  // the value of that signal in frame k (structure-of-arrays).
+  void DecodeBatch(
+    const uint8_t * payloads,
+    size_t stride,
+    size_t count,
+    double * const * columns) const;
 
 private:
+  // Lets the tests start the lazy frame generation close to wrapping.
+  friend class DbcMessageTestAccess;
+
+  static const SignalHandle NO_MUX_SWITCH = 0xFFFF;
+
+  // Signal names in sorted order, viewing the keys of _signals.
+  struct SignalNameEntry
+  {
+    std::string_view Name;
+    SignalHandle Handle;
+  };
+
+  static bool NameBefore(const SignalNameEntry & entry, std::string_view name);
+
+  void RebuildSignalTable(const DbcMessage & other);
+  void BindLazyFrame();
+  Frame NewFrame() const;
+  void PackInto(uint8_t * payload);
+  void RefreshTemplate();
+  void FinishTemplate();
+  void WriteChecksum(uint8_t * payload) const;
+  void UnpackFrom(const uint8_t * payload);
+  void EncodeInto(const double * values, uint8_t * payload) const;
+  const std::vector<DbcSignalRecord> * GetMuxGroup(double switchValue) const;
+  void AddRecord(std::vector<DbcSignalRecord> & records, const DbcSignalRecord & record) const;
+
+  template<typename T>
+  void DecodeInto(const uint8_t * data, T * values) const;
+
   std::map<std::string, NewEagle::DbcSignal> _signals;
-  uint8_t _data[8];
+  std::vector<std::map<std::string, NewEagle::DbcSignal>::iterator> _signalTable;
+  std::vector<SignalNameEntry> _signalNames;
+
+  // Multiplexer dispatch, kept up to date by AddSignal: the signals present in
+  // every frame (including the switch), and the multiplexed signals grouped by
+  // the switch value that selects them. Each list is ordered by start bit, or
+  // by handle if signals share bits so the last one added still wins.
+  std::vector<DbcSignalRecord> _plainSignals;
+  std::map<int32_t, std::vector<DbcSignalRecord>> _muxGroups;
+  SignalHandle _muxSwitch = NO_MUX_SWITCH;
+
+  // Payload last built by GetFrame, and the raw signal values packed into it.
+  // Only signals whose raw value has changed since are packed again; the whole
+  // payload is rebuilt when the multiplexer switch changes, or on every call
+  // if signals share bits (the last signal packed wins those).
+  uint8_t _template[NewEagle::MAX_FRAME_BYTES];
+  std::vector<int64_t> _packedValues;
+  double _packedMuxValue = 0.0;
+  bool _templateValid = false;
+  bool _overlappingSignals = false;
+
+  bool _lazy = false;
+  NewEagle::DbcLazyFrame _lazyFrame = {{0}, 0, std::numeric_limits<double>::quiet_NaN()};
+
+  NewEagle::ChecksumType _checksumType = NewEagle::CHECKSUM_NONE;
+  SignalHandle _checksumSignal = NO_SIGNAL;
+  SignalHandle _counterSignal = NO_SIGNAL;
+  bool _checksumDeclared = false;
+  bool _counterDeclared = false;
+  uint64_t _counter = 0;
   uint8_t _dlc;
   uint32_t _id;
   IdType _idType;
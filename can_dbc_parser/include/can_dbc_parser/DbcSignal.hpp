@@ -29,7 +29,9 @@
 #ifndef CAN_DBC_PARSER__DBCSIGNAL_HPP_
 #define CAN_DBC_PARSER__DBCSIGNAL_HPP_
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace NewEagle
 {
@@ -66,6 +68,41 @@ enum MultiplexerMode
   MUX_SIGNAL = 2
 };
 
+// Largest payload a signal may be placed in (CAN FD).
+static const int32_t MAX_FRAME_BYTES = 64;
+
+// Bit layout of a signal within a 64-bit word of the frame, worked out once when
+// the signal is created so Unpack/Pack are a load, two shifts and a store.
+// Intel signals use the word read little-endian, Motorola signals big-endian.
+// The word is the 8 bytes starting at ByteOffset; that is always 0 for signals
+// in the first 8 bytes, so classic frames only ever use one word per byte order.
+struct DbcSignalPlan
+{
+  bool Valid;          // false if the signal is outside the frame or spans more than 8 bytes
+  bool BigEndian;
+  bool Signed;
+  bool Scaled;         // gain != 1 or offset != 0
+  uint8_t ByteOffset;  // first byte of the word holding the signal
+  uint8_t LeftShift;   // drops the bits above the signal
+  uint8_t RightShift;  // moves the signal down to bit 0
+  uint8_t Shift;       // position of the signal's LSB
+  uint64_t Mask;       // signal bits, already shifted into place
+};
+
+// DbcSignal::_current bits.
+static const uint8_t RESULT_CURRENT = 0x01;
+static const uint8_t RAW_CURRENT = 0x02;
+
+// Payload a message in lazy mode was last given by SetFrame. Its signals
+// decode from it on first read; a signal is current once its generation
+// matches the frame's.
+struct DbcLazyFrame
+{
+  uint8_t Payload[MAX_FRAME_BYTES];
+  uint32_t Generation;
+  double MuxValue;  // switch value decoded from Payload, NaN without a multiplexer
+};
+
 class DbcSignal
 {
 public:
@@ -73,58 +110,78 @@ public:
     uint8_t dlc,
     double gain,
     double offset,
-    uint8_t startBit,
+    uint16_t startBit,
     ByteOrder endianness,
     uint8_t length,
     SignType sign,
-    std::string name,
+    std::string_view name,
     MultiplexerMode multiplexerMode);
 
   DbcSignal(
     uint8_t dlc,
     double gain,
     double offset,
-    uint8_t startBit,
+    uint16_t startBit,
     ByteOrder endianness,
     uint8_t length,
     SignType sign,
-    std::string name,
+    std::string_view name,
     MultiplexerMode multiplexerMode,
     int32_t multiplexerSwitch);
 
   uint8_t GetDlc() const;
+
+  // A signal holds either its raw value (as decoded from a frame) or its
+  // physical value (as set), and works out the other one the first time it is
+  // asked for. Flag and enum handlers that read the raw value of an unscaled
+  // signal never touch floating point.
   double GetResult() const;
+  int64_t GetRaw() const;
   double GetGain() const;
   double GetOffset() const;
-  uint8_t GetStartBit() const;
+  uint16_t GetStartBit() const;
   ByteOrder GetEndianness() const;
   uint8_t GetLength() const;
   SignType GetSign() const;
   std::string GetName() const;
   void SetResult(double result);
-  void SetComment(NewEagle::DbcSignalComment comment);
+  void SetRaw(int64_t raw);
+  void SetComment(const NewEagle::DbcSignalComment & comment);
   void SetInitialValue(double value);
   double GetInitialValue();
   DataType GetDataType();
   void SetDataType(DataType type);
   MultiplexerMode GetMultiplexerMode() const;
   int32_t GetMultiplexerSwitch() const;
+  const NewEagle::DbcSignalPlan & GetPlan() const;
 
 private:
-  uint8_t _dlc;
-  double _result;
+  friend class DbcMessage;
+
+  void BuildPlan();
+  void DecodePending() const;
+
+  // Laid out largest first to keep the signal at 96 bytes; names and comments
+  // live in the shared string table (see DbcStrings.hpp).
+  NewEagle::DbcSignalPlan _plan;
+  mutable double _result;
+  mutable int64_t _raw;
   double _gain;
   double _offset;
-  uint8_t _startBit;
-  ByteOrder _endianness;
-  uint8_t _length;
-  SignType _sign;
-  std::string _name;
-  NewEagle::DbcSignalComment _comment;
   double _initialValue;
-  DataType _type;
-  MultiplexerMode _multiplexerMode;
+  const std::string * _name;
+  const std::string * _comment;  // NULL until SetComment
+  const NewEagle::DbcLazyFrame * _lazyFrame;  // set by the owning message in lazy mode
   int32_t _multiplexerSwitch;
+  mutable uint32_t _generation;
+  uint16_t _startBit;
+  uint8_t _dlc;
+  uint8_t _length;
+  uint8_t _endianness : 1;
+  uint8_t _sign : 1;
+  uint8_t _type : 2;
+  uint8_t _multiplexerMode : 2;
+  mutable uint8_t _current;  // which of _result and _raw hold the value
 };
 }  // namespace NewEagle
 
@@ -0,0 +1,58 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef CAN_DBC_PARSER__DBCSTRINGS_HPP_
+#define CAN_DBC_PARSER__DBCSTRINGS_HPP_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace NewEagle
+{
+// Signal names and comments are stored once per process and shared by every
+// Dbc that uses them; signals only hold a pointer, which stays valid for the
+// life of the process. Safe to call from several threads. Only allocates
+// the first time a string is seen.
+//
+// The pool is not tied to any Dbc and never shrinks on its own: it holds every
+// distinct name and comment of every DBC loaded so far. Loading the same DBC
+// again adds nothing, so a node that loads its DBCs at startup stays bounded
+// by their text; only processes that load many different DBCs keep growing.
+const std::string * InternString(std::string_view text);
+
+// Number of strings in the pool.
+size_t InternedStringCount();
+
+// Frees every string in the pool. Only for tests and tools that load many
+// DBCs in one process: every DbcSignal, DbcMessage and Dbc created before the
+// call must already be destroyed, since their names point into the pool.
+void ClearInternedStrings();
+}  // namespace NewEagle
+
+#endif  // CAN_DBC_PARSER__DBCSTRINGS_HPP_
@@ -32,6 +32,7 @@
 #include <can_dbc_parser/DbcSignal.hpp>
 #include <can_dbc_parser/DbcMessage.hpp>
 
+#include <cmath>
 #include <limits>
 #include <map>
 #include <sstream>
@@ -39,176 +40,169 @@
 
 namespace NewEagle
 {
-static int32_t ConvertToMTBitOrdering(uint32_t bit, uint32_t dlc)
+inline uint64_t LoadFrameWord(const uint8_t * data, bool bigEndian)
 {
-  if (bit > -dlc * 8) {
-    return -1;
-  }
-
-  int32_t msgBitLength = (int32_t)dlc * 8;
+  uint64_t word = 0;
 
-  int32_t row = (int32_t) bit / 8;
-  int32_t offset = (int32_t)bit % 8;
+  for (int32_t i = 0; i < 8; i++) {
+    word |= static_cast<uint64_t>(data[i]) << (8 * (bigEndian ? 7 - i : i));
+  }
 
-  return (msgBitLength - (row + 1) * 8) + offset;
+  return word;
 }
 
-static int32_t ConvertToMTBitOrdering(uint32_t bit)
+inline void StoreFrameWord(uint8_t * data, bool bigEndian, uint64_t word)
 {
-  return ConvertToMTBitOrdering(bit, 8);
+  for (int32_t i = 0; i < 8; i++) {
+    data[i] = static_cast<uint8_t>(word >> (8 * (bigEndian ? 7 - i : i)));
+  }
 }
 
-static double Unpack(uint8_t * data, const NewEagle::DbcSignal & signal)
+// Signal bits of a frame word moved down to bit 0, sign-extended to 64 bits
+// for signed signals. Works for any length from 1 to 64.
+inline uint64_t ExtractField(uint64_t word, const NewEagle::DbcSignalPlan & plan)
 {
-  int32_t wordSize = sizeof(data);
-  int32_t startBit = (int32_t)signal.GetStartBit();
+  word <<= plan.LeftShift;
 
-  if (signal.GetEndianness() == NewEagle::LITTLE_END) {
-    startBit = ConvertToMTBitOrdering(signal.GetStartBit(), signal.GetDlc());
-  } else {
-    startBit =
-      ConvertToMTBitOrdering(
-      signal.GetStartBit(),
-      signal.GetDlc()) - ((int32_t)signal.GetLength() - 1);
+  if (plan.Signed) {
+    return static_cast<uint64_t>(static_cast<int64_t>(word) >> plan.RightShift);
   }
 
-  int32_t bit = (int32_t)(startBit % 8);
-
-  bool isExactlyByte = ((bit + signal.GetLength()) % 8 == 0);
-  uint32_t numBytes = (isExactlyByte ? 0 : 1) + ((bit + (int32_t)signal.GetLength()) / 8);
-
-  int32_t b = static_cast<int32_t>(wordSize) - (static_cast<int>(startBit) / 8) - 1;
-  int32_t w = static_cast<int>(signal.GetLength());
-  int32_t maskShift = bit;
-  int32_t rightShift = 0;
-
-  uint32_t unsignedResult = 0;
-  for (uint32_t i = 0; i < numBytes; i++) {
-    if ((b < 0) || (b >= (int32_t)sizeof(data))) {
-      return std::numeric_limits<int>::quiet_NaN();
-    }
-
-    int32_t mask = 0xFF;
-    if (w < 8) {
-      mask >>= (8 - w);
-    }
-    mask <<= maskShift;
-
-    int32_t extractedByte = (data[b] & mask) >> maskShift;
-    unsignedResult |= (uint32_t)extractedByte << (8 * i - rightShift);
-
-    if (signal.GetEndianness() == NewEagle::BIG_END) {
-      if ((b % wordSize) == 0) {
-        b += 2 * wordSize - 1;
-      } else {
-        b--;
-      }
-    } else {
-      b++;
-    }
+  return word >> plan.RightShift;
+}
 
-    w -= ( 8 - maskShift);
-    rightShift += maskShift;
-    maskShift = 0;
+// Raw (unscaled) signal value: sign-extended for signed signals, 0 if the
+// signal does not fit in the frame. Unsigned 64-bit signals above INT64_MAX
+// come back as their two's complement.
+inline int64_t UnpackRaw(const uint8_t * data, const NewEagle::DbcSignalPlan & plan)
+{
+  if (!plan.Valid) {
+    return 0;
   }
 
-  double result = 0;
-  if (signal.GetSign() == NewEagle::SIGNED) {
-    if ((unsignedResult & (1 << (static_cast<int32_t>(signal.GetLength()) - 1))) != 0) {
-      if (signal.GetLength() < 32) {
-        uint32_t signExtension = (0xFFFFFFFF << static_cast<int32_t>(signal.GetLength()));
-        unsignedResult |= signExtension;
-      }
-    }
-
-    result = static_cast<double>(static_cast<int32_t>(unsignedResult));
+  return static_cast<int64_t>(
+    ExtractField(LoadFrameWord(data + plan.ByteOffset, plan.BigEndian), plan));
+}
 
-  } else if (signal.GetSign() == NewEagle::UNSIGNED) {
-    result = static_cast<double>(unsignedResult);
+// Physical value of a raw signal value: the only place decoding touches
+// floating point. Signals that do not fit in the frame read as 0.0, not NaN,
+// as they always have.
+inline double ToPhysical(
+  int64_t raw, const NewEagle::DbcSignalPlan & plan, double gain, double offset)
+{
+  if (!plan.Valid) {
+    return 0.0;
   }
 
-  if ((signal.GetGain() != 1) || (signal.GetOffset() != 0)) {
-    result *= signal.GetGain();
-    result += signal.GetOffset();
+  double result = plan.Signed ?
+    static_cast<double>(raw) :
+    static_cast<double>(static_cast<uint64_t>(raw));
+
+  if (plan.Scaled) {
+    result *= gain;
+    result += offset;
   }
 
   return result;
 }
 
-static void Pack(uint8_t * data, const NewEagle::DbcSignal & signal)
+// Raw value a physical value packs to, cut to the signal's width and
+// sign-extended like UnpackRaw, so it is what the frame would decode to.
+inline int64_t ToRaw(
+  double value, const NewEagle::DbcSignalPlan & plan, double gain, double offset)
 {
-  uint32_t result = 0;
-
-  double tmp = signal.GetResult();
-
-  if ((signal.GetGain() != 1) || (signal.GetOffset() != 0)) {
-    tmp -= signal.GetOffset();
-    tmp /= signal.GetGain();
+  if (!plan.Valid) {
+    return 0;
   }
 
-  if (signal.GetSign() == NewEagle::SIGNED) {
-    int32_t i = static_cast<int32_t>(tmp);
-    uint32_t u = static_cast<uint32_t>(i);
+  double tmp = value;
 
-    result = u;
-  } else {
-    result = (uint)tmp;
+  if (plan.Scaled) {
+    tmp -= offset;
+    tmp /= gain;
   }
 
-  int8_t wordSize = sizeof(data);
-  int8_t startBit = static_cast<int8_t>(signal.GetStartBit());
-
-  if (signal.GetEndianness() == NewEagle::LITTLE_END) {
-    startBit = ConvertToMTBitOrdering(signal.GetStartBit(), signal.GetDlc());
+  // Converting a double the integer type cannot hold is undefined, so values
+  // past the 64-bit range saturate and NaN packs as 0. Everything else goes
+  // through int64_t and is cut to the signal's width.
+  uint64_t raw;
+
+  if (std::isnan(tmp)) {
+    raw = 0;
+  } else if (tmp >= 9223372036854775808.0) {
+    if (plan.Signed) {
+      raw = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    } else if (tmp >= 18446744073709551616.0) {
+      raw = std::numeric_limits<uint64_t>::max();
+    } else {
+      raw = static_cast<uint64_t>(tmp);
+    }
+  } else if (tmp < -9223372036854775808.0) {
+    raw = static_cast<uint64_t>(std::numeric_limits<int64_t>::min());
   } else {
-    startBit =
-      ConvertToMTBitOrdering(
-      signal.GetStartBit(),
-      signal.GetDlc()) - (static_cast<int32_t>(signal.GetLength()) - 1);
+    raw = static_cast<uint64_t>(static_cast<int64_t>(tmp));
   }
 
-  int32_t bit = static_cast<int32_t>(startBit % 8);
+  return static_cast<int64_t>(ExtractField(raw << plan.Shift, plan));
+}
 
-  bool isExactlyByte = ((bit + signal.GetLength()) % 8 == 0);
-  uint32_t numBytes =
-    (isExactlyByte ? 0 : 1) + ((bit + static_cast<int32_t>(signal.GetLength())) / 8);
+inline double Unpack(
+  const uint8_t * data, const NewEagle::DbcSignalPlan & plan, double gain, double offset)
+{
+  return ToPhysical(UnpackRaw(data, plan), plan, gain, offset);
+}
 
-  int32_t b = static_cast<int32_t>(wordSize) - (static_cast<int32_t>(startBit) / 8) - 1;
-  int32_t w = static_cast<int32_t>(signal.GetLength());
-  int32_t maskShift = bit;
-  int32_t rightShift = 0;
+inline void PackRaw(uint8_t * data, const NewEagle::DbcSignalPlan & plan, int64_t raw)
+{
+  if (!plan.Valid) {
+    return;
+  }
 
-  uint8_t mask = 0xFF;
-  uint32_t extractedByte;
+  uint64_t word = LoadFrameWord(data + plan.ByteOffset, plan.BigEndian);
+  word &= ~plan.Mask;
+  word |= (static_cast<uint64_t>(raw) << plan.Shift) & plan.Mask;
+  StoreFrameWord(data + plan.ByteOffset, plan.BigEndian, word);
+}
 
-  for (uint32_t i = 0; i < numBytes; i++) {
-    mask = 0xFF;
+inline void PackValue(
+  uint8_t * data, const NewEagle::DbcSignalPlan & plan, double gain, double offset, double value)
+{
+  PackRaw(data, plan, ToRaw(value, plan, gain, offset));
+}
 
-    if (w < 8) {
-      mask >>= (8 - w);
-    }
+inline int64_t UnpackRaw(const uint8_t * data, const NewEagle::DbcSignal & signal)
+{
+  return UnpackRaw(data, signal.GetPlan());
+}
 
-    mask <<= maskShift;
+inline int64_t UnpackRaw(const uint8_t * data, const NewEagle::DbcSignalRecord & record)
+{
+  return UnpackRaw(data, record.Plan);
+}
 
-    extractedByte = (result >> (8 * i - rightShift)) & 0xFF;
+inline double Unpack(const uint8_t * data, const NewEagle::DbcSignal & signal)
+{
+  return Unpack(data, signal.GetPlan(), signal.GetGain(), signal.GetOffset());
+}
 
-    data[b] = static_cast<uint32_t>(data[b] & ~mask);
-    data[b] |= static_cast<uint8_t>((extractedByte << maskShift) & mask);
+inline double Unpack(const uint8_t * data, const NewEagle::DbcSignalRecord & record)
+{
+  return Unpack(data, record.Plan, record.Gain, record.Offset);
+}
 
-    if (signal.GetEndianness() == NewEagle::BIG_END) {
-      if ((b % wordSize) == 0) {
-        b += 2 * wordSize - 1;
-      } else {
-        b--;
-      }
-    } else {
-      b++;
-    }
+inline void PackValue(uint8_t * data, const NewEagle::DbcSignal & signal, double value)
+{
+  PackValue(data, signal.GetPlan(), signal.GetGain(), signal.GetOffset(), value);
+}
 
-    w -= ( 8 - maskShift);
-    rightShift += maskShift;
-    maskShift = 0;
-  }
+inline void PackValue(uint8_t * data, const NewEagle::DbcSignalRecord & record, double value)
+{
+  PackValue(data, record.Plan, record.Gain, record.Offset, value);
+}
+
+inline void Pack(uint8_t * data, const NewEagle::DbcSignal & signal)
+{
+  PackRaw(data, signal.GetPlan(), signal.GetRaw());
 }
 }  // namespace NewEagle
 
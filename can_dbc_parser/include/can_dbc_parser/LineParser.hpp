@@ -30,8 +30,11 @@
 #define CAN_DBC_PARSER__LINEPARSER_HPP_
 
 #include <cctype>
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 namespace NewEagle
 {
@@ -72,31 +75,55 @@ enum ReadDoubleState
   READING_EXP = 4
 };
 
+// Result of the non-throwing Try* readers. Each value other than OK maps to
+// the exception the matching Read* method throws.
+enum LineParserStatus
+{
+  LINE_PARSER_OK = 0,
+  LINE_PARSER_AT_EOL = 1,
+  LINE_PARSER_LEN_ZERO = 2,
+  LINE_PARSER_INVALID_CHAR = 3,
+  LINE_PARSER_UNEXPECTED_CHAR = 4,
+  LINE_PARSER_MISSING_QUOTE = 5
+};
+
+// Tokenizes one line in place. The parser only keeps a view of the line, so
+// the text must outlive it; tokens returned as std::string_view point into it.
 class LineParser
 {
 public:
-  explicit LineParser(const std::string & line);
+  explicit LineParser(std::string_view line);
 
   int32_t GetPosition();
   std::string ReadCIdentifier();
-  std::string ReadCIdentifier(std::string fieldName);
+  std::string ReadCIdentifier(const char * fieldName);
+  std::string_view ReadCIdentifierView();
   uint32_t ReadUInt();
-  uint32_t ReadUInt(std::string fieldName);
+  uint32_t ReadUInt(const char * fieldName);
   void SeekSeparator(char separator);
-  char ReadNextChar(std::string fieldName);
+  char ReadNextChar(const char * fieldName);
   int32_t ReadInt();
   double ReadDouble();
-  double ReadDouble(std::string fieldName);
+  double ReadDouble(const char * fieldName);
   std::string ReadQuotedString();
   uint32_t PeekUInt();
 
+  LineParserStatus TryReadCIdentifier(std::string_view & value);
+  LineParserStatus TryReadUInt(uint32_t & value);
+  LineParserStatus TryPeekUInt(uint32_t & value);
+  LineParserStatus TryReadInt(int32_t & value);
+  LineParserStatus TryReadDouble(double & value);
+  LineParserStatus TryReadNextChar(char & value);
+  LineParserStatus TryReadQuotedString(std::string_view & value);
+
 private:
-  int32_t _position;
-  std::string _line;
+  size_t _position;
+  std::string_view _line;
 
   void SkipWhitespace();
   bool AtEOL();
   char ReadNextChar();
+  LineParserStatus ScanUInt(size_t & end);
 };
 }  // namespace NewEagle
 
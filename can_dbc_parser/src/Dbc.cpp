@@ -28,55 +28,174 @@
 
 #include <can_dbc_parser/Dbc.hpp>
 
+#include <algorithm>
 #include <map>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace NewEagle
 {
+Dbc::Dbc(const Dbc & other)
+: _messages(other._messages)
+{
+  RebuildIndex();
+}
+
+Dbc & Dbc::operator=(const Dbc & other)
+{
+  if (this != &other) {
+    _messages = other._messages;
+    RebuildIndex();
+  }
+
+  return *this;
+}
 
 std::map<std::string, NewEagle::DbcMessage> * Dbc::GetMessages()
 {
   return &_messages;
 }
 
-void Dbc::AddMessage(NewEagle::DbcMessage message)
+NewEagle::DbcMessage * Dbc::AddMessage(NewEagle::DbcMessage message)
 {
-  _messages.insert(std::pair<std::string, NewEagle::DbcMessage>(message.GetName(), message));
+  std::pair<std::map<std::string, NewEagle::DbcMessage>::iterator, bool> result =
+    _messages.try_emplace(message.GetName(), std::move(message));
+
+  if (result.second) {
+    NameIndexEntry entry{result.first->first, &result.first->second};
+    _nameIndex.insert(
+      std::lower_bound(_nameIndex.begin(), _nameIndex.end(), entry.Name, NameBefore),
+      entry);
+    IndexMessage(&result.first->second);
+  }
+
+  return &result.first->second;
 }
 
-NewEagle::DbcMessage * Dbc::GetMessage(std::string messageName)
+NewEagle::DbcMessage * Dbc::GetMessage(std::string_view messageName)
 {
-  std::map<std::string, NewEagle::DbcMessage>::iterator it;
+  const Dbc * self = this;
+  return const_cast<NewEagle::DbcMessage *>(self->GetMessage(messageName));
+}
 
-  it = _messages.find(messageName);
+const NewEagle::DbcMessage * Dbc::GetMessage(std::string_view messageName) const
+{
+  std::vector<NameIndexEntry>::const_iterator it =
+    std::lower_bound(_nameIndex.begin(), _nameIndex.end(), messageName, NameBefore);
 
-  if (_messages.end() == it) {
+  if ((_nameIndex.end() == it) || (it->Name != messageName)) {
     return NULL;
   }
 
-  NewEagle::DbcMessage * message = &it->second;
+  return it->Message;
+}
+
+NewEagle::DbcMessage * Dbc::GetMessageById(uint32_t id)
+{
+  const Dbc * self = this;
+  return const_cast<NewEagle::DbcMessage *>(self->GetMessageById(id));
+}
+
+const NewEagle::DbcMessage * Dbc::GetMessageById(uint32_t id) const
+{
+  const NewEagle::DbcMessage * message = GetMessageById(id, NewEagle::STD);
+
+  if (NULL == message) {
+    message = GetMessageById(id, NewEagle::EXT);
+  }
 
   return message;
 }
 
-NewEagle::DbcMessage * Dbc::GetMessageById(uint32_t id)
+NewEagle::DbcMessage * Dbc::GetMessageById(uint32_t id, NewEagle::IdType idType)
 {
-  for (std::map<std::string, NewEagle::DbcMessage>::iterator it = _messages.begin();
-    it != _messages.end(); it++)
-  {
-    if (it->second.GetId() == id) {
-      NewEagle::DbcMessage * message = &it->second;
+  const Dbc * self = this;
+  return const_cast<NewEagle::DbcMessage *>(self->GetMessageById(id, idType));
+}
 
-      return message;
-    }
+const NewEagle::DbcMessage * Dbc::GetMessageById(uint32_t id, NewEagle::IdType idType) const
+{
+  // Bit 31 is the extended tag; no message ID has it, so a standard ID with
+  // it set must not match the extended key of the same number.
+  if (_idIndex.empty() || (0 != (id & 0x80000000u))) {
+    return NULL;
   }
 
-  return NULL;
+  uint32_t key = IndexKey(id, idType);
+  uint32_t mask = static_cast<uint32_t>(_idIndex.size()) - 1;
+
+  for (uint32_t i = (key * 2654435761u) >> _idIndexShift; ; i = (i + 1) & mask) {
+    const IdIndexEntry & entry = _idIndex[i];
+
+    if (NULL == entry.Message) {
+      return NULL;
+    }
+    if (entry.Key == key) {
+      return entry.Message;
+    }
+  }
 }
 
-uint16_t Dbc::GetMessageCount()
+uint16_t Dbc::GetMessageCount() const
 {
   return _messages.size();
 }
+
+bool Dbc::NameBefore(const NameIndexEntry & entry, std::string_view name)
+{
+  return entry.Name < name;
+}
+
+uint32_t Dbc::IndexKey(uint32_t id, NewEagle::IdType idType)
+{
+  return (NewEagle::EXT == idType) ? (id | 0x80000000u) : id;
+}
+
+void Dbc::IndexMessage(NewEagle::DbcMessage * message)
+{
+  // Keep the table at most half full so probe sequences stay short.
+  if (_messages.size() * 2 > _idIndex.size()) {
+    RebuildIndex();
+    return;
+  }
+
+  uint32_t key = IndexKey(message->GetId(), message->GetIdType());
+  uint32_t mask = static_cast<uint32_t>(_idIndex.size()) - 1;
+
+  for (uint32_t i = (key * 2654435761u) >> _idIndexShift; ; i = (i + 1) & mask) {
+    IdIndexEntry & entry = _idIndex[i];
+
+    if (NULL == entry.Message) {
+      entry.Key = key;
+      entry.Message = message;
+      return;
+    }
+    if (entry.Key == key) {
+      // Duplicate ID; the first message keeps the slot.
+      return;
+    }
+  }
+}
+
+void Dbc::RebuildIndex()
+{
+  uint32_t bits = 4;
+  while ((1u << bits) < _messages.size() * 2) {
+    bits++;
+  }
+
+  _idIndexShift = 32 - bits;
+  _idIndex.assign(1u << bits, IdIndexEntry{0, NULL});
+  _nameIndex.clear();
+  _nameIndex.reserve(_messages.size());
+
+  // The map is already in name order.
+  for (std::map<std::string, NewEagle::DbcMessage>::iterator it = _messages.begin();
+    it != _messages.end(); it++)
+  {
+    _nameIndex.push_back(NameIndexEntry{it->first, &it->second});
+    IndexMessage(&it->second);
+  }
+}
 }  // namespace NewEagle
@@ -0,0 +1,272 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <can_dbc_parser/DbcMessage.hpp>
+#include <can_dbc_parser/DbcUtilities.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DBC_BATCH_X86 1
+#include <immintrin.h>
+#endif
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace NewEagle
+{
+// Frames are converted to 64-bit words one block at a time, then each signal
+// is pulled out of the whole block with the same shift pair.
+static const size_t BATCH_BLOCK_SIZE = 256;
+
+typedef void (* ExtractColumnFn)(
+  const uint64_t * words, size_t count, const NewEagle::DbcSignalRecord & record, double * out);
+
+static void ExtractColumnScalar(
+  const uint64_t * words, size_t count, const NewEagle::DbcSignalRecord & record, double * out)
+{
+  const NewEagle::DbcSignalPlan & plan = record.Plan;
+
+  for (size_t k = 0; k < count; k++) {
+    uint64_t raw = ExtractField(words[k], plan);
+    double result = plan.Signed ?
+      static_cast<double>(static_cast<int64_t>(raw)) :
+      static_cast<double>(raw);
+
+    if (plan.Scaled) {
+      result *= record.Gain;
+      result += record.Offset;
+    }
+
+    out[k] = result;
+  }
+}
+
+#ifdef DBC_BATCH_X86
+// The SIMD kernels match the scalar one bit for bit: the field is shifted into
+// the low 32 bits of each lane, sign-extended with 32-bit shifts, converted
+// exactly, then scaled with a separate multiply and add. Signals longer than
+// 32 bits always take the scalar kernel.
+
+__attribute__((target("sse2")))
+static void ExtractColumnSse2(
+  const uint64_t * words, size_t count, const NewEagle::DbcSignalRecord & record, double * out)
+{
+  const NewEagle::DbcSignalPlan & plan = record.Plan;
+  int32_t length = 64 - plan.RightShift;
+  int32_t extend = (plan.Signed && length < 32) ? 32 - length : 0;
+
+  const __m128i left = _mm_cvtsi32_si128(plan.LeftShift);
+  const __m128i right = _mm_cvtsi32_si128(plan.RightShift);
+  const __m128i signExtend = _mm_cvtsi32_si128(extend);
+  const __m128i signFlip = _mm_set1_epi32(INT32_MIN);
+  const __m128d unsignedBias = _mm_set1_pd(2147483648.0);
+  const __m128d gain = _mm_set1_pd(record.Gain);
+  const __m128d offset = _mm_set1_pd(record.Offset);
+
+  size_t k = 0;
+  for (; k + 2 <= count; k += 2) {
+    __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i *>(words + k));
+    w = _mm_srl_epi64(_mm_sll_epi64(w, left), right);
+    __m128i v = _mm_shuffle_epi32(w, _MM_SHUFFLE(3, 1, 2, 0));
+
+    __m128d d;
+    if (plan.Signed) {
+      v = _mm_sra_epi32(_mm_sll_epi32(v, signExtend), signExtend);
+      d = _mm_cvtepi32_pd(v);
+    } else {
+      d = _mm_add_pd(_mm_cvtepi32_pd(_mm_xor_si128(v, signFlip)), unsignedBias);
+    }
+
+    if (plan.Scaled) {
+      d = _mm_add_pd(_mm_mul_pd(d, gain), offset);
+    }
+
+    _mm_storeu_pd(out + k, d);
+  }
+
+  ExtractColumnScalar(words + k, count - k, record, out + k);
+}
+
+__attribute__((target("avx2")))
+static void ExtractColumnAvx2(
+  const uint64_t * words, size_t count, const NewEagle::DbcSignalRecord & record, double * out)
+{
+  const NewEagle::DbcSignalPlan & plan = record.Plan;
+  int32_t length = 64 - plan.RightShift;
+  int32_t extend = (plan.Signed && length < 32) ? 32 - length : 0;
+
+  const __m128i left = _mm_cvtsi32_si128(plan.LeftShift);
+  const __m128i right = _mm_cvtsi32_si128(plan.RightShift);
+  const __m128i signExtend = _mm_cvtsi32_si128(extend);
+  const __m256i lowHalves = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+  const __m128i signFlip = _mm_set1_epi32(INT32_MIN);
+  const __m256d unsignedBias = _mm256_set1_pd(2147483648.0);
+  const __m256d gain = _mm256_set1_pd(record.Gain);
+  const __m256d offset = _mm256_set1_pd(record.Offset);
+
+  size_t k = 0;
+  for (; k + 4 <= count; k += 4) {
+    __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + k));
+    w = _mm256_srl_epi64(_mm256_sll_epi64(w, left), right);
+    __m128i v = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(w, lowHalves));
+
+    __m256d d;
+    if (plan.Signed) {
+      v = _mm_sra_epi32(_mm_sll_epi32(v, signExtend), signExtend);
+      d = _mm256_cvtepi32_pd(v);
+    } else {
+      d = _mm256_add_pd(_mm256_cvtepi32_pd(_mm_xor_si128(v, signFlip)), unsignedBias);
+    }
+
+    if (plan.Scaled) {
+      d = _mm256_add_pd(_mm256_mul_pd(d, gain), offset);
+    }
+
+    _mm256_storeu_pd(out + k, d);
+  }
+
+  ExtractColumnScalar(words + k, count - k, record, out + k);
+}
+#endif
+
+static ExtractColumnFn KernelFunction(DecodeBatchKernel kernel)
+{
+#ifdef DBC_BATCH_X86
+  __builtin_cpu_init();
+
+  if ((BATCH_KERNEL_AVX2 == kernel) && __builtin_cpu_supports("avx2")) {
+    return ExtractColumnAvx2;
+  }
+  if ((BATCH_KERNEL_SSE2 == kernel) && __builtin_cpu_supports("sse2")) {
+    return ExtractColumnSse2;
+  }
+#endif
+
+  return BATCH_KERNEL_SCALAR == kernel ? ExtractColumnScalar : NULL;
+}
+
+static ExtractColumnFn SelectExtractColumn()
+{
+  ExtractColumnFn kernel = KernelFunction(BATCH_KERNEL_AVX2);
+
+  if (NULL == kernel) {
+    kernel = KernelFunction(BATCH_KERNEL_SSE2);
+  }
+
+  return NULL == kernel ? ExtractColumnScalar : kernel;
+}
+
+static std::atomic<ExtractColumnFn> & ExtractColumn()
+{
+  static std::atomic<ExtractColumnFn> extractColumn(SelectExtractColumn());
+  return extractColumn;
+}
+
+bool SetDecodeBatchKernel(DecodeBatchKernel kernel)
+{
+  ExtractColumnFn extractColumn = KernelFunction(kernel);
+
+  if (NULL == extractColumn) {
+    return false;
+  }
+
+  ExtractColumn().store(extractColumn, std::memory_order_relaxed);
+  return true;
+}
+
+void DbcMessage::DecodeBatch(
+  const uint8_t * payloads,
+  size_t stride,
+  size_t count,
+  double * const * columns) const
+{
+  const ExtractColumnFn extractColumn = ExtractColumn().load(std::memory_order_relaxed);
+
+  uint64_t littleEndian[BATCH_BLOCK_SIZE];
+  uint64_t bigEndian[BATCH_BLOCK_SIZE];
+  uint64_t shifted[BATCH_BLOCK_SIZE];
+
+  for (size_t first = 0; first < count; first += BATCH_BLOCK_SIZE) {
+    size_t n = count - first < BATCH_BLOCK_SIZE ? count - first : BATCH_BLOCK_SIZE;
+    const uint8_t * block = payloads + first * stride;
+
+    for (size_t k = 0; k < n; k++) {
+      littleEndian[k] = LoadFrameWord(block + k * stride, false);
+      bigEndian[k] = LoadFrameWord(block + k * stride, true);
+    }
+
+    for (size_t i = 0; i < _plainSignals.size(); i++) {
+      const DbcSignalRecord & record = _plainSignals[i];
+      const NewEagle::DbcSignalPlan & plan = record.Plan;
+      double * out = columns[record.Handle] + first;
+
+      if (!plan.Valid) {
+        memset(out, 0, n * sizeof(double));
+      } else {
+        const uint64_t * words = plan.BigEndian ? bigEndian : littleEndian;
+
+        // CAN FD signals past the first 8 bytes live in a word of their own.
+        if (0 != plan.ByteOffset) {
+          for (size_t k = 0; k < n; k++) {
+            shifted[k] = LoadFrameWord(block + k * stride + plan.ByteOffset, plan.BigEndian);
+          }
+          words = shifted;
+        }
+
+        if (plan.RightShift >= 32) {
+          extractColumn(words, n, record, out);
+        } else {
+          ExtractColumnScalar(words, n, record, out);
+        }
+      }
+    }
+
+    if (NO_MUX_SWITCH == _muxSwitch) {
+      continue;
+    }
+
+    // Multiplexed signals only exist in some frames, so they are decoded one
+    // frame at a time; entries for frames that do not carry them are left untouched.
+    const double * switches = columns[_muxSwitch] + first;
+
+    for (size_t k = 0; k < n; k++) {
+      const std::vector<DbcSignalRecord> * group = GetMuxGroup(switches[k]);
+
+      if (NULL == group) {
+        continue;
+      }
+
+      for (size_t i = 0; i < group->size(); i++) {
+        const DbcSignalRecord & record = (*group)[i];
+        columns[record.Handle][first + k] = Unpack(block + k * stride, record);
+      }
+    }
+  }
+}
+}  // namespace NewEagle
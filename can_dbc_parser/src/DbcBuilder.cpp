@@ -27,16 +27,133 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include <can_dbc_parser/DbcBuilder.hpp>
+#include <can_dbc_parser/DbcCache.hpp>
 #include <can_dbc_parser/DbcMessage.hpp>
 #include <can_dbc_parser/DbcSignal.hpp>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <cstring>
 #include <iostream>
 #include <map>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 namespace NewEagle
 {
+namespace
+{
+// Read-only mapping of a whole DBC file; lines are tokenized in place.
+class MappedDbcFile
+{
+public:
+  explicit MappedDbcFile(const std::string & dbcFile)
+  : _base(MAP_FAILED), _size(0)
+  {
+    int fd = open(dbcFile.c_str(), O_RDONLY);
+    struct stat st;
+
+    if ((fd < 0) || (fstat(fd, &st) != 0)) {
+      if (fd >= 0) {
+        close(fd);
+      }
+      std::string error_msg("Unable to open DBC file " + dbcFile);
+      throw std::runtime_error(error_msg);
+    }
+
+    _size = static_cast<size_t>(st.st_size);
+    if (_size > 0) {
+      _base = mmap(NULL, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+
+    if ((_size > 0) && (MAP_FAILED == _base)) {
+      std::string error_msg("Unable to map DBC file " + dbcFile);
+      throw std::runtime_error(error_msg);
+    }
+  }
+
+  ~MappedDbcFile()
+  {
+    if (MAP_FAILED != _base) {
+      munmap(_base, _size);
+    }
+  }
+
+  MappedDbcFile(const MappedDbcFile &) = delete;
+  MappedDbcFile & operator=(const MappedDbcFile &) = delete;
+
+  std::string_view Text() const
+  {
+    if (MAP_FAILED == _base) {
+      return std::string_view();
+    }
+    return std::string_view(static_cast<const char *>(_base), _size);
+  }
+
+private:
+  void * _base;
+  size_t _size;
+};
+// Number of SG_ lines right after the line ending at lineStart, i.e. the
+// signals of the message a BO_ line starts.
+size_t CountSignalLines(std::string_view text, size_t lineStart)
+{
+  size_t count = 0;
+
+  while (lineStart < text.size()) {
+    size_t lineEnd = text.find('\n', lineStart);
+    if (std::string_view::npos == lineEnd) {
+      lineEnd = text.size();
+    }
+
+    NewEagle::LineParser parser(text.substr(lineStart, lineEnd - lineStart));
+    std::string_view identifier;
+    if ((NewEagle::LINE_PARSER_OK != parser.TryReadCIdentifier(identifier)) ||
+      (identifier != "SG_"))
+    {
+      break;
+    }
+
+    count++;
+    lineStart = lineEnd + 1;
+  }
+
+  return count;
+}
+
+// Messages by raw DBC ID, filled in as BO_ lines are read so that CM_, BA_
+// and SIG_VALTYPE_ records find their target without scanning the whole DBC.
+typedef std::unordered_map<uint32_t, NewEagle::DbcMessage *> RawIdIndex;
+
+NewEagle::DbcMessage * FindMessage(const RawIdIndex & index, uint32_t rawId)
+{
+  RawIdIndex::const_iterator it = index.find(rawId);
+
+  if (index.end() == it) {
+    return NULL;
+  }
+
+  return it->second;
+}
+
+NewEagle::DbcSignal * FindSignal(
+  const RawIdIndex & index, uint32_t rawId, const std::string & signalName)
+{
+  NewEagle::DbcMessage * message = FindMessage(index, rawId);
+
+  if (NULL == message) {
+    return NULL;
+  }
+
+  return message->GetSignal(signalName);
+}
+}  // namespace
+
 DbcBuilder::DbcBuilder()
 {
   MessageToken = std::string("BO_");
@@ -51,28 +168,37 @@ DbcBuilder::DbcBuilder()
 
 NewEagle::Dbc DbcBuilder::NewDbc(const std::string & dbcFile)
 {
-  NewEagle::Dbc dbc;
+  MappedDbcFile file(dbcFile);
+  return Parse(file.Text());
+}
 
-  std::ifstream f(dbcFile);
-  std::string line;
-  if (!f.is_open()) {
-    std::string error_msg("Unable to open DBC file " + dbcFile);
-    throw std::runtime_error(error_msg);
-  }
+NewEagle::Dbc DbcBuilder::Parse(std::string_view text)
+{
+  NewEagle::Dbc dbc;
 
   uint32_t lineNumber = 0;
 
-  NewEagle::DbcMessage currentMessage;
+  NewEagle::DbcMessage * currentMessage = NULL;
+  RawIdIndex messagesByRawId;
+
+  size_t lineStart = 0;
+  while (lineStart < text.size()) {
+    size_t lineEnd = text.find('\n', lineStart);
+    if (std::string_view::npos == lineEnd) {
+      lineEnd = text.size();
+    }
+
+    std::string_view line = text.substr(lineStart, lineEnd - lineStart);
+    lineStart = lineEnd + 1;
 
-  while (std::getline(f, line, '\n')) {
     lineNumber++;
     NewEagle::LineParser parser(line);
 
-    std::string identifier;
-    try {
-      identifier = parser.ReadCIdentifier();
-    } catch (std::exception & ex) {
-      identifier = std::string();
+    // Blank lines and lines that do not start with a keyword are skipped
+    // without copying anything out of them.
+    std::string_view identifier;
+    if (NewEagle::LINE_PARSER_OK != parser.TryReadCIdentifier(identifier)) {
+      continue;
     }
 
     if (!EndOfInitToken.compare(identifier)) {
@@ -80,39 +206,43 @@ NewEagle::Dbc DbcBuilder::NewDbc(const std::string & dbcFile)
       isInitPassed = true;
     } else if (!MessageToken.compare(identifier)) {
       try {
-        currentMessage = ReadMessage(parser);
-        dbc.AddMessage(currentMessage);
+        currentMessage = dbc.AddMessage(ReadMessage(parser));
+        currentMessage->ReserveSignals(CountSignalLines(text, lineStart));
+        messagesByRawId.emplace(currentMessage->GetRawId(), currentMessage);
       } catch (LineParserExceptionBase & exlp) {
         if (isInitPassed) {
           std::string error_msg(
-            "Tried to add message " + identifier +
+            "Tried to add message " + std::string(identifier) +
             " on line " + std::to_string(lineNumber) +
             ". Got Line Parser Exception Base error: " + exlp.what());
           throw std::runtime_error(error_msg);
         }
       } catch (std::exception & ex) {
         std::string error_msg(
-          "Tried to add message " + identifier +
+          "Tried to add message " + std::string(identifier) +
           " on line " + std::to_string(lineNumber) +
           ". Got Standard Exception error: " + ex.what() );
         throw std::runtime_error(error_msg);
       }
     } else if (!SignalToken.compare(identifier)) {
       try {
-        NewEagle::DbcSignal signal = ReadSignal(parser);
-        NewEagle::DbcMessage * msg = dbc.GetMessage(currentMessage.GetName());
-        msg->AddSignal(signal.GetName(), signal);
+        if (NULL == currentMessage) {
+          throw std::runtime_error("Signal defined outside of a message");
+        }
+
+        NewEagle::DbcSignal signal = ReadSignal(parser, currentMessage->GetDlc());
+        currentMessage->AddSignal(signal.GetName(), signal);
       } catch (LineParserExceptionBase & exlp) {
         if (isInitPassed) {
           std::string error_msg(
-            "Tried to add signal" + identifier +
+            "Tried to add signal" + std::string(identifier) +
             " on line " + std::to_string(lineNumber) +
             ". Got Line Parser Exception Base error: " + exlp.what());
           throw std::runtime_error(error_msg);
         }
       } catch (std::exception & ex) {
         std::string error_msg(
-          "Tried to add signal" + identifier +
+          "Tried to add signal" + std::string(identifier) +
           " on line " + std::to_string(lineNumber) +
           ". Got Standard Exception error: " + ex.what() );
         throw std::runtime_error(error_msg);
@@ -124,45 +254,30 @@ NewEagle::Dbc DbcBuilder::NewDbc(const std::string & dbcFile)
         if (!MessageToken.compare(token)) {
           NewEagle::DbcMessageComment dbcMessageComment = ReadMessageComment(parser);
 
-          std::map<std::string, NewEagle::DbcMessage>::iterator it;
-          int32_t ttt = 0;
-
-          for (it = dbc.GetMessages()->begin(); it != dbc.GetMessages()->end(); ++it) {
-            ttt++;
-            if (it->second.GetRawId() == dbcMessageComment.Id) {
-              it->second.SetComment(dbcMessageComment);
-              break;
-            }
+          RawIdIndex::iterator it = messagesByRawId.find(dbcMessageComment.Id);
+          if (messagesByRawId.end() != it) {
+            it->second->SetComment(dbcMessageComment);
           }
         } else if (!SignalToken.compare(token)) {
           NewEagle::DbcSignalComment dbcSignalComment = ReadSignalComment(parser);
 
-          std::map<std::string, NewEagle::DbcMessage>::iterator it;
-          for (it = dbc.GetMessages()->begin(); it != dbc.GetMessages()->end(); ++it) {
-            if (it->second.GetRawId() == dbcSignalComment.Id) {
-              DbcMessage msg = it->second;
-              std::map<std::string, NewEagle::DbcSignal>::iterator its;
-
-              for (its = msg.GetSignals()->begin(); its != msg.GetSignals()->end(); ++its) {
-                if (its->second.GetName() == dbcSignalComment.SignalName) {
-                  its->second.SetComment(dbcSignalComment);
-                  break;
-                }
-              }
-            }
+          NewEagle::DbcSignal * sig =
+            FindSignal(messagesByRawId, dbcSignalComment.Id, dbcSignalComment.SignalName);
+          if (NULL != sig) {
+            sig->SetComment(dbcSignalComment);
           }
         }
       } catch (LineParserExceptionBase & exlp) {
         if (isInitPassed) {
           std::string error_msg(
-            "Tried to read comment " + identifier +
+            "Tried to read comment " + std::string(identifier) +
             " on line " + std::to_string(lineNumber) +
             ". Got Line Parser Exception Base error: " + exlp.what());
           throw std::runtime_error(error_msg);
         }
       } catch (std::exception & ex) {
         std::string error_msg(
-          "Tried to read comment " + identifier +
+          "Tried to read comment " + std::string(identifier) +
           " on line " + std::to_string(lineNumber) +
           ". Got Standard Exception error: " + ex.what() );
         throw std::runtime_error(error_msg);
@@ -171,44 +286,59 @@ NewEagle::Dbc DbcBuilder::NewDbc(const std::string & dbcFile)
       try {
         NewEagle::DbcAttribute dbcAttribute = ReadAttribute(parser);
 
-        if (dbc.GetMessageCount() > 0) {
-          std::map<std::string, NewEagle::DbcMessage>::iterator it;
-          for (it = dbc.GetMessages()->begin(); it != dbc.GetMessages()->end(); ++it) {
-            if (it->second.GetRawId() == dbcAttribute.Id) {
-              std::map<std::string, NewEagle::DbcSignal>::iterator its;
-              DbcMessage msg = it->second;
-              for (its = msg.GetSignals()->begin(); its != msg.GetSignals()->end(); ++its) {
-                if (its->second.GetName() == dbcAttribute.SignalName) {
-                  NewEagle::DbcSignal sig = its->second;
-
-                  double gain = sig.GetGain();
-                  double offset = sig.GetOffset();
-
-                  double f = 0.0;
-
-                  std::stringstream ss;
-                  ss << dbcAttribute.Value;
-                  ss >> f;
-
-                  double val = gain * f + offset;
-                  sig.SetInitialValue(val);
-                  break;
-                }
+        // Only signal start values, checksums and rolling counters are read;
+        // Id is not set for anything else.
+        if (!dbcAttribute.SignalName.empty()) {
+          NewEagle::DbcMessage * message = FindMessage(messagesByRawId, dbcAttribute.Id);
+          NewEagle::DbcSignal * sig =
+            FindSignal(messagesByRawId, dbcAttribute.Id, dbcAttribute.SignalName);
+
+          if (NULL != sig) {
+            NewEagle::SignalHandle handle = message->GetSignalHandle(dbcAttribute.SignalName);
+
+            if (dbcAttribute.AttributeName == "GenSigChecksumType") {
+              NewEagle::ChecksumType type;
+              if (!NewEagle::ParseChecksumType(dbcAttribute.Value, type)) {
+                throw std::runtime_error("Unknown checksum type " + dbcAttribute.Value);
               }
+              // "NONE" on one signal does not undo a checksum on another.
+              if ((NewEagle::CHECKSUM_NONE != type) ||
+                (NewEagle::CHECKSUM_NONE == message->GetChecksumType()))
+              {
+                message->SetChecksum(handle, type);
+              }
+            } else if (dbcAttribute.AttributeName == "GenSigRollingCounter") {
+              if (dbcAttribute.Value != "0") {
+                message->SetRollingCounter(handle);
+              } else if (NewEagle::NO_SIGNAL == message->GetRollingCounterSignal()) {
+                message->SetRollingCounter(NewEagle::NO_SIGNAL);
+              }
+            } else {
+              double gain = sig->GetGain();
+              double offset = sig->GetOffset();
+
+              double f = 0.0;
+
+              std::stringstream ss;
+              ss << dbcAttribute.Value;
+              ss >> f;
+
+              double val = gain * f + offset;
+              sig->SetInitialValue(val);
             }
           }
         }
       } catch (LineParserExceptionBase & exlp) {
         if (isInitPassed) {
           std::string error_msg(
-            "Tried to read attribute " + identifier +
+            "Tried to read attribute " + std::string(identifier) +
             " on line " + std::to_string(lineNumber) +
             ". Got Line Parser Exception Base error: " + exlp.what());
           throw std::runtime_error(error_msg);
         }
       } catch (std::exception & ex) {
         std::string error_msg(
-          "Tried to read attribute " + identifier +
+          "Tried to read attribute " + std::string(identifier) +
           " on line " + std::to_string(lineNumber) +
           ". Got Standard Exception error: " + ex.what() );
         throw std::runtime_error(error_msg);
@@ -219,33 +349,22 @@ NewEagle::Dbc DbcBuilder::NewDbc(const std::string & dbcFile)
       try {
         NewEagle::DbcSignalValueType dbcSignalValueType = ReadSignalValueType(parser);
 
-        if (dbc.GetMessageCount() > 0) {
-          std::map<std::string, NewEagle::DbcMessage>::iterator it;
-          for (it = dbc.GetMessages()->begin(); it != dbc.GetMessages()->end(); ++it) {
-            if (it->second.GetRawId() == dbcSignalValueType.Id) {
-              std::map<std::string, NewEagle::DbcSignal>::iterator its;
-              DbcMessage msg = it->second;
-              for (its = msg.GetSignals()->begin(); its != msg.GetSignals()->end(); ++its) {
-                if (its->second.GetName() == dbcSignalValueType.SignalName) {
-                  NewEagle::DbcSignal sig = its->second;
-                  sig.SetDataType(dbcSignalValueType.Type);
-                  break;
-                }
-              }
-            }
-          }
+        NewEagle::DbcSignal * sig = FindSignal(
+          messagesByRawId, dbcSignalValueType.Id, dbcSignalValueType.SignalName);
+        if (NULL != sig) {
+          sig->SetDataType(dbcSignalValueType.Type);
         }
       } catch (LineParserExceptionBase & exlp) {
         if (isInitPassed) {
           std::string error_msg(
-            "Tried to read signal value type " + identifier +
+            "Tried to read signal value type " + std::string(identifier) +
             " on line " + std::to_string(lineNumber) +
             ". Got Line Parser Exception Base error: " + exlp.what());
           throw std::runtime_error(error_msg);
         }
       } catch (std::exception & ex) {
         std::string error_msg(
-          "Tried to read signal value type " + identifier +
+          "Tried to read signal value type " + std::string(identifier) +
           " on line " + std::to_string(lineNumber) +
           ". Got Standard Exception error: " + ex.what() );
         throw std::runtime_error(error_msg);
@@ -255,4 +374,25 @@ NewEagle::Dbc DbcBuilder::NewDbc(const std::string & dbcFile)
   std::cout << "DBC Size: " << dbc.GetMessageCount() << std::endl;
   return dbc;
 }
+
+NewEagle::Dbc DbcBuilder::NewDbc(const std::string & dbcFile, const std::string & cacheFile)
+{
+  MappedDbcFile file(dbcFile);
+  std::string_view text = file.Text();
+  uint64_t sourceHash = DbcCache::Hash(text.data(), text.size());
+
+  NewEagle::Dbc dbc;
+  if (DbcCache::Load(cacheFile, sourceHash, dbc)) {
+    std::cout << "DBC Size: " << dbc.GetMessageCount() << " (cached)" << std::endl;
+    return dbc;
+  }
+
+  dbc = Parse(text);
+
+  if (!DbcCache::Save(cacheFile, sourceHash, dbc)) {
+    std::cerr << "Unable to write DBC cache " << cacheFile << std::endl;
+  }
+
+  return dbc;
+}
 }  // namespace NewEagle
@@ -0,0 +1,379 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <can_dbc_parser/DbcCache.hpp>
+#include <can_dbc_parser/DbcMessage.hpp>
+#include <can_dbc_parser/DbcSignal.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace NewEagle
+{
+static const char CACHE_MAGIC[8] = {'N', 'E', 'D', 'B', 'C', 'B', 'I', 'N'};
+
+// CacheMessage::Declared bits: which protection attributes the DBC had.
+static const uint8_t DECLARED_CHECKSUM = 0x01;
+static const uint8_t DECLARED_COUNTER = 0x02;
+
+struct CacheHeader
+{
+  char Magic[8];
+  uint32_t Version;
+  uint32_t MessageCount;
+  uint32_t SignalCount;
+  uint32_t StringBytes;
+  uint64_t SourceHash;
+  uint64_t PayloadHash;  // everything after the header
+};
+
+struct CacheMessage
+{
+  uint32_t Id;
+  uint32_t RawId;
+  uint32_t Name;         // offset into the string block
+  uint32_t FirstSignal;
+  uint32_t SignalCount;
+  uint8_t Dlc;
+  uint8_t IdType;
+  uint8_t ChecksumType;
+  uint8_t Declared;      // DECLARED_* bits
+  uint16_t ChecksumSignal;
+  uint16_t CounterSignal;
+  uint32_t Padding;      // keeps the signal table that follows 8-byte aligned
+};
+
+struct CacheSignal
+{
+  double Gain;
+  double Offset;
+  double InitialValue;
+  int32_t MultiplexerSwitch;
+  uint32_t Name;         // offset into the string block
+  uint8_t Dlc;
+  uint8_t Length;
+  uint16_t StartBit;
+  uint8_t Endianness;
+  uint8_t Sign;
+  uint8_t MultiplexerMode;
+  uint8_t DataType;
+};
+
+static_assert(sizeof(CacheHeader) == 40, "DBC cache header layout changed");
+static_assert(sizeof(CacheMessage) == 32, "DBC cache message layout changed");
+static_assert(sizeof(CacheSignal) == 40, "DBC cache signal layout changed");
+
+// The tables are read in place from the mmap'ed file, so each one has to start
+// aligned for its records whatever the number of records before it.
+static_assert(
+  (sizeof(CacheHeader) % alignof(CacheMessage) == 0) &&
+  (sizeof(CacheHeader) % alignof(CacheSignal) == 0) &&
+  (sizeof(CacheMessage) % alignof(CacheSignal) == 0),
+  "DBC cache tables would be misaligned");
+
+uint64_t DbcCache::Hash(const void * data, size_t size, uint64_t hash)
+{
+  const uint8_t * bytes = static_cast<const uint8_t *>(data);
+
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+
+  return hash;
+}
+
+static uint32_t Intern(
+  const std::string & name,
+  std::map<std::string, uint32_t> & interned,
+  std::string & strings)
+{
+  std::map<std::string, uint32_t>::iterator it = interned.find(name);
+
+  if (interned.end() != it) {
+    return it->second;
+  }
+
+  uint32_t offset = static_cast<uint32_t>(strings.size());
+  strings.append(name);
+  strings.push_back('\0');
+  interned.insert(std::make_pair(name, offset));
+
+  return offset;
+}
+
+bool DbcCache::Save(const std::string & cacheFile, uint64_t sourceHash, NewEagle::Dbc & dbc)
+{
+  std::vector<CacheMessage> messages;
+  std::vector<CacheSignal> signals;
+  std::map<std::string, uint32_t> interned;
+  std::string strings;
+
+  std::map<std::string, NewEagle::DbcMessage> * dbcMessages = dbc.GetMessages();
+  for (std::map<std::string, NewEagle::DbcMessage>::iterator it = dbcMessages->begin();
+    it != dbcMessages->end(); it++)
+  {
+    NewEagle::DbcMessage & message = it->second;
+
+    CacheMessage record;
+    memset(&record, 0, sizeof(record));
+    record.Id = message.GetId();
+    record.RawId = message.GetRawId();
+    record.Name = Intern(it->first, interned, strings);
+    record.FirstSignal = static_cast<uint32_t>(signals.size());
+    record.SignalCount = message.GetSignalCount();
+    record.Dlc = message.GetDlc();
+    record.IdType = static_cast<uint8_t>(message.GetIdType());
+    record.ChecksumType = static_cast<uint8_t>(message.GetChecksumType());
+    record.Declared = (message.IsChecksumDeclared() ? DECLARED_CHECKSUM : 0) |
+      (message.IsRollingCounterDeclared() ? DECLARED_COUNTER : 0);
+    record.ChecksumSignal = message.GetChecksumSignal();
+    record.CounterSignal = message.GetRollingCounterSignal();
+    messages.push_back(record);
+
+    // Handle order, so handles resolved against a cached Dbc match the text one.
+    for (NewEagle::SignalHandle h = 0; h < message.GetSignalCount(); h++) {
+      NewEagle::DbcSignal * signal = message.GetSignal(h);
+
+      CacheSignal sig;
+      memset(&sig, 0, sizeof(sig));
+      sig.Gain = signal->GetGain();
+      sig.Offset = signal->GetOffset();
+      sig.InitialValue = signal->GetInitialValue();
+      sig.MultiplexerSwitch = signal->GetMultiplexerSwitch();
+      sig.Name = Intern(signal->GetName(), interned, strings);
+      sig.Dlc = signal->GetDlc();
+      sig.StartBit = signal->GetStartBit();
+      sig.Length = signal->GetLength();
+      sig.Endianness = static_cast<uint8_t>(signal->GetEndianness());
+      sig.Sign = static_cast<uint8_t>(signal->GetSign());
+      sig.MultiplexerMode = static_cast<uint8_t>(signal->GetMultiplexerMode());
+      sig.DataType = static_cast<uint8_t>(signal->GetDataType());
+      signals.push_back(sig);
+    }
+  }
+
+  CacheHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.Magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  header.Version = VERSION;
+  header.MessageCount = static_cast<uint32_t>(messages.size());
+  header.SignalCount = static_cast<uint32_t>(signals.size());
+  header.StringBytes = static_cast<uint32_t>(strings.size());
+  header.SourceHash = sourceHash;
+  header.PayloadHash = Hash(messages.data(), messages.size() * sizeof(CacheMessage));
+  header.PayloadHash =
+    Hash(signals.data(), signals.size() * sizeof(CacheSignal), header.PayloadHash);
+  header.PayloadHash = Hash(strings.data(), strings.size(), header.PayloadHash);
+
+  std::string tmpFile = cacheFile + ".tmp" + std::to_string(getpid());
+  FILE * f = fopen(tmpFile.c_str(), "wb");
+  if (NULL == f) {
+    return false;
+  }
+
+  bool ok =
+    (fwrite(&header, sizeof(header), 1, f) == 1) &&
+    (fwrite(messages.data(), sizeof(CacheMessage), messages.size(), f) == messages.size()) &&
+    (fwrite(signals.data(), sizeof(CacheSignal), signals.size(), f) == signals.size()) &&
+    (fwrite(strings.data(), 1, strings.size(), f) == strings.size());
+  ok = (fclose(f) == 0) && ok;
+
+  if (!ok || (rename(tmpFile.c_str(), cacheFile.c_str()) != 0)) {
+    remove(tmpFile.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+static bool ValidName(uint32_t offset, const char * strings, uint32_t stringBytes)
+{
+  return (offset < stringBytes) && (memchr(strings + offset, '\0', stringBytes - offset) != NULL);
+}
+
+static bool BuildDbc(const uint8_t * base, size_t size, uint64_t sourceHash, NewEagle::Dbc & dbc)
+{
+  if (size < sizeof(CacheHeader)) {
+    return false;
+  }
+
+  CacheHeader header;
+  memcpy(&header, base, sizeof(header));
+
+  if ((memcmp(header.Magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0) ||
+    (header.Version != DbcCache::VERSION) ||
+    (header.SourceHash != sourceHash))
+  {
+    return false;
+  }
+
+  uint64_t expected = sizeof(CacheHeader) +
+    static_cast<uint64_t>(header.MessageCount) * sizeof(CacheMessage) +
+    static_cast<uint64_t>(header.SignalCount) * sizeof(CacheSignal) +
+    header.StringBytes;
+
+  if ((expected != size) ||
+    (DbcCache::Hash(base + sizeof(CacheHeader), size - sizeof(CacheHeader)) != header.PayloadHash))
+  {
+    return false;
+  }
+
+  const CacheMessage * messages =
+    reinterpret_cast<const CacheMessage *>(base + sizeof(CacheHeader));
+  const CacheSignal * signals =
+    reinterpret_cast<const CacheSignal *>(messages + header.MessageCount);
+  const char * strings = reinterpret_cast<const char *>(signals + header.SignalCount);
+
+  NewEagle::Dbc result;
+
+  for (uint32_t m = 0; m < header.MessageCount; m++) {
+    const CacheMessage & record = messages[m];
+
+    if (!ValidName(record.Name, strings, header.StringBytes) ||
+      (record.FirstSignal > header.SignalCount) ||
+      (record.SignalCount > header.SignalCount - record.FirstSignal))
+    {
+      return false;
+    }
+
+    NewEagle::DbcMessage message(
+      record.Dlc, record.Id, static_cast<NewEagle::IdType>(record.IdType),
+      strings + record.Name, record.RawId);
+    message.ReserveSignals(record.SignalCount);
+
+    for (uint32_t s = record.FirstSignal; s < record.FirstSignal + record.SignalCount; s++) {
+      const CacheSignal & sig = signals[s];
+
+      if (!ValidName(sig.Name, strings, header.StringBytes)) {
+        return false;
+      }
+
+      NewEagle::DbcSignal signal(
+        sig.Dlc, sig.Gain, sig.Offset, sig.StartBit,
+        static_cast<NewEagle::ByteOrder>(sig.Endianness), sig.Length,
+        static_cast<NewEagle::SignType>(sig.Sign), strings + sig.Name,
+        static_cast<NewEagle::MultiplexerMode>(sig.MultiplexerMode), sig.MultiplexerSwitch);
+      signal.SetInitialValue(sig.InitialValue);
+      signal.SetDataType(static_cast<NewEagle::DataType>(sig.DataType));
+
+      message.AddSignal(signal.GetName(), signal);
+    }
+
+    if ((record.ChecksumType > NewEagle::CHECKSUM_ADD) ||
+      ((NewEagle::CHECKSUM_NONE == record.ChecksumType) !=
+      (NewEagle::NO_SIGNAL == record.ChecksumSignal)) ||
+      ((NewEagle::NO_SIGNAL != record.ChecksumSignal) &&
+      (record.ChecksumSignal >= record.SignalCount)) ||
+      ((NewEagle::NO_SIGNAL != record.CounterSignal) &&
+      (record.CounterSignal >= record.SignalCount)) ||
+      (!(record.Declared & DECLARED_CHECKSUM) &&
+      (NewEagle::CHECKSUM_NONE != record.ChecksumType)) ||
+      (!(record.Declared & DECLARED_COUNTER) &&
+      (NewEagle::NO_SIGNAL != record.CounterSignal)))
+    {
+      return false;
+    }
+
+    if (record.Declared & DECLARED_CHECKSUM) {
+      message.SetChecksum(
+        record.ChecksumSignal, static_cast<NewEagle::ChecksumType>(record.ChecksumType));
+    }
+    if (record.Declared & DECLARED_COUNTER) {
+      message.SetRollingCounter(record.CounterSignal);
+    }
+
+    result.AddMessage(std::move(message));
+  }
+
+  dbc = std::move(result);
+  return true;
+}
+
+bool DbcCache::Load(const std::string & cacheFile, uint64_t sourceHash, NewEagle::Dbc & dbc)
+{
+  int fd = open(cacheFile.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st;
+  if ((fstat(fd, &st) != 0) || (st.st_size <= 0)) {
+    close(fd);
+    return false;
+  }
+
+  size_t size = static_cast<size_t>(st.st_size);
+  void * base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if (MAP_FAILED == base) {
+    return false;
+  }
+
+  bool ok = BuildDbc(static_cast<const uint8_t *>(base), size, sourceHash, dbc);
+  munmap(base, size);
+
+  return ok;
+}
+
+std::string DbcCache::DefaultFile(const std::string & dbcFile)
+{
+  std::filesystem::path dir;
+  const char * rosHome = getenv("ROS_HOME");
+  const char * home = getenv("HOME");
+
+  if ((rosHome != NULL) && (*rosHome != '\0')) {
+    dir = rosHome;
+  } else if ((home != NULL) && (*home != '\0')) {
+    dir = std::filesystem::path(home) / ".ros";
+  } else {
+    return "";
+  }
+  dir /= "dbc_cache";
+
+  std::error_code error;
+  std::filesystem::create_directories(dir, error);
+  if (error) {
+    return "";
+  }
+
+  return (dir / (std::filesystem::path(dbcFile).filename().string() + ".cache")).string();
+}
+}  // namespace NewEagle
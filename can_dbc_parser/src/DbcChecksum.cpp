@@ -0,0 +1,133 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <can_dbc_parser/DbcChecksum.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace NewEagle
+{
+typedef uint8_t (* ChecksumFn)(const uint8_t * data, size_t length);
+
+static constexpr std::array<uint8_t, 256> MakeCrc8Table(uint8_t polynomial)
+{
+  std::array<uint8_t, 256> table = {};
+
+  for (int32_t i = 0; i < 256; i++) {
+    uint8_t crc = static_cast<uint8_t>(i);
+
+    for (int32_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x80) ?
+        static_cast<uint8_t>((crc << 1) ^ polynomial) :
+        static_cast<uint8_t>(crc << 1);
+    }
+
+    table[i] = crc;
+  }
+
+  return table;
+}
+
+static constexpr std::array<uint8_t, 256> CRC8_SAE_J1850_TABLE = MakeCrc8Table(0x1D);
+
+static uint8_t Crc8SaeJ1850(const uint8_t * data, size_t length)
+{
+  uint8_t crc = 0xFF;
+
+  for (size_t i = 0; i < length; i++) {
+    crc = CRC8_SAE_J1850_TABLE[crc ^ data[i]];
+  }
+
+  return crc ^ 0xFF;
+}
+
+static uint8_t ChecksumXor(const uint8_t * data, size_t length)
+{
+  uint8_t sum = 0;
+
+  for (size_t i = 0; i < length; i++) {
+    sum ^= data[i];
+  }
+
+  return sum;
+}
+
+static uint8_t ChecksumAdd(const uint8_t * data, size_t length)
+{
+  uint8_t sum = 0;
+
+  for (size_t i = 0; i < length; i++) {
+    sum = static_cast<uint8_t>(sum + data[i]);
+  }
+
+  return sum;
+}
+
+static uint8_t ChecksumNone(const uint8_t *, size_t)
+{
+  return 0;
+}
+
+// Indexed by ChecksumType; a new scheme is one more function and entry here.
+static const ChecksumFn CHECKSUMS[] = {
+  ChecksumNone,
+  Crc8SaeJ1850,
+  ChecksumXor,
+  ChecksumAdd
+};
+
+static const char * const CHECKSUM_NAMES[] = {
+  "NONE",
+  "CRC8_SAE_J1850",
+  "XOR",
+  "ADD"
+};
+
+bool ParseChecksumType(const std::string & name, ChecksumType & type)
+{
+  for (size_t i = 0; i < sizeof(CHECKSUM_NAMES) / sizeof(CHECKSUM_NAMES[0]); i++) {
+    if (name == CHECKSUM_NAMES[i]) {
+      type = static_cast<ChecksumType>(i);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+uint8_t ComputeChecksum(ChecksumType type, const uint8_t * data, size_t length)
+{
+  if (static_cast<size_t>(type) >= sizeof(CHECKSUMS) / sizeof(CHECKSUMS[0])) {
+    return 0;
+  }
+
+  return CHECKSUMS[type](data, length);
+}
+}  // namespace NewEagle
@@ -29,13 +29,52 @@
 #include <can_dbc_parser/DbcMessage.hpp>
 #include <can_dbc_parser/DbcUtilities.hpp>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <map>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 namespace NewEagle
 {
+static bool SignalsOverlap(const NewEagle::DbcSignal & a, const NewEagle::DbcSignal & b)
+{
+  const NewEagle::DbcSignalPlan & planA = a.GetPlan();
+  const NewEagle::DbcSignalPlan & planB = b.GetPlan();
+
+  if (!planA.Valid || !planB.Valid) {
+    return false;
+  }
+
+  // Lay both masks out in frame byte order, so either byte order compares.
+  uint8_t bitsA[NewEagle::MAX_FRAME_BYTES + 8] = {0};
+  uint8_t bitsB[NewEagle::MAX_FRAME_BYTES + 8] = {0};
+  StoreFrameWord(bitsA + planA.ByteOffset, planA.BigEndian, planA.Mask);
+  StoreFrameWord(bitsB + planB.ByteOffset, planB.BigEndian, planB.Mask);
+
+  for (size_t i = 0; i < sizeof(bitsA); i++) {
+    if (0 != (bitsA[i] & bitsB[i])) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static bool StartsBefore(const NewEagle::DbcSignalRecord & a, const NewEagle::DbcSignalRecord & b)
+{
+  return a.StartBit < b.StartBit;
+}
+
+static bool AddedBefore(const NewEagle::DbcSignalRecord & a, const NewEagle::DbcSignalRecord & b)
+{
+  return a.Handle < b.Handle;
+}
+
 DbcMessage::DbcMessage()
 {
 }
@@ -46,166 +85,772 @@ DbcMessage::DbcMessage(
   IdType idType,
   std::string name,
   uint32_t rawId)
+: _dlc(dlc),
+  _id(id),
+  _idType(idType),
+  _name(std::move(name)),
+  _rawId(rawId)
+{
+}
+
+DbcMessage::DbcMessage(const DbcMessage & other)
+: _signals(other._signals),
+  _plainSignals(other._plainSignals),
+  _muxGroups(other._muxGroups),
+  _muxSwitch(other._muxSwitch),
+  _packedValues(other._packedValues),
+  _packedMuxValue(other._packedMuxValue),
+  _templateValid(other._templateValid),
+  _overlappingSignals(other._overlappingSignals),
+  _lazy(other._lazy),
+  _lazyFrame(other._lazyFrame),
+  _checksumType(other._checksumType),
+  _checksumSignal(other._checksumSignal),
+  _counterSignal(other._counterSignal),
+  _checksumDeclared(other._checksumDeclared),
+  _counterDeclared(other._counterDeclared),
+  _counter(other._counter),
+  _dlc(other._dlc),
+  _id(other._id),
+  _idType(other._idType),
+  _name(other._name),
+  _rawId(other._rawId),
+  _comment(other._comment)
+{
+  memcpy(_template, other._template, sizeof(_template));
+  RebuildSignalTable(other);
+  BindLazyFrame();
+}
+
+// Moving the maps keeps their nodes, so the signal table and the name views
+// still point at the right signals; only the lazy frame is a new object.
+DbcMessage::DbcMessage(DbcMessage && other)
+: _signals(std::move(other._signals)),
+  _signalTable(std::move(other._signalTable)),
+  _signalNames(std::move(other._signalNames)),
+  _plainSignals(std::move(other._plainSignals)),
+  _muxGroups(std::move(other._muxGroups)),
+  _muxSwitch(other._muxSwitch),
+  _packedValues(std::move(other._packedValues)),
+  _packedMuxValue(other._packedMuxValue),
+  _templateValid(other._templateValid),
+  _overlappingSignals(other._overlappingSignals),
+  _lazy(other._lazy),
+  _lazyFrame(other._lazyFrame),
+  _checksumType(other._checksumType),
+  _checksumSignal(other._checksumSignal),
+  _counterSignal(other._counterSignal),
+  _checksumDeclared(other._checksumDeclared),
+  _counterDeclared(other._counterDeclared),
+  _counter(other._counter),
+  _dlc(other._dlc),
+  _id(other._id),
+  _idType(other._idType),
+  _name(std::move(other._name)),
+  _rawId(other._rawId),
+  _comment(std::move(other._comment))
+{
+  memcpy(_template, other._template, sizeof(_template));
+  BindLazyFrame();
+}
+
+DbcMessage & DbcMessage::operator=(const DbcMessage & other)
+{
+  if (this != &other) {
+    _signals = other._signals;
+    _plainSignals = other._plainSignals;
+    _muxGroups = other._muxGroups;
+    _muxSwitch = other._muxSwitch;
+    memcpy(_template, other._template, sizeof(_template));
+    _packedValues = other._packedValues;
+    _packedMuxValue = other._packedMuxValue;
+    _templateValid = other._templateValid;
+    _overlappingSignals = other._overlappingSignals;
+    _lazy = other._lazy;
+    _lazyFrame = other._lazyFrame;
+    _checksumType = other._checksumType;
+    _checksumSignal = other._checksumSignal;
+    _counterSignal = other._counterSignal;
+    _checksumDeclared = other._checksumDeclared;
+    _counterDeclared = other._counterDeclared;
+    _counter = other._counter;
+    _dlc = other._dlc;
+    _id = other._id;
+    _idType = other._idType;
+    _name = other._name;
+    _rawId = other._rawId;
+    _comment = other._comment;
+    RebuildSignalTable(other);
+    BindLazyFrame();
+  }
+
+  return *this;
+}
+
+DbcMessage & DbcMessage::operator=(DbcMessage && other)
+{
+  if (this != &other) {
+    _signals = std::move(other._signals);
+    _signalTable = std::move(other._signalTable);
+    _signalNames = std::move(other._signalNames);
+    _plainSignals = std::move(other._plainSignals);
+    _muxGroups = std::move(other._muxGroups);
+    _muxSwitch = other._muxSwitch;
+    memcpy(_template, other._template, sizeof(_template));
+    _packedValues = std::move(other._packedValues);
+    _packedMuxValue = other._packedMuxValue;
+    _templateValid = other._templateValid;
+    _overlappingSignals = other._overlappingSignals;
+    _lazy = other._lazy;
+    _lazyFrame = other._lazyFrame;
+    _checksumType = other._checksumType;
+    _checksumSignal = other._checksumSignal;
+    _counterSignal = other._counterSignal;
+    _checksumDeclared = other._checksumDeclared;
+    _counterDeclared = other._counterDeclared;
+    _counter = other._counter;
+    _dlc = other._dlc;
+    _id = other._id;
+    _idType = other._idType;
+    _name = std::move(other._name);
+    _rawId = other._rawId;
+    _comment = std::move(other._comment);
+    BindLazyFrame();
+  }
+
+  return *this;
+}
+
+void DbcMessage::RebuildSignalTable(const DbcMessage & other)
+{
+  // Handles are indices into the table, so keep the other message's order.
+  _signalTable.clear();
+  _signalTable.reserve(other._signalTable.size());
+
+  for (size_t i = 0; i < other._signalTable.size(); i++) {
+    _signalTable.push_back(_signals.find(other._signalTable[i]->first));
+  }
+
+  _signalNames.clear();
+  _signalNames.reserve(other._signalNames.size());
+
+  for (size_t i = 0; i < other._signalNames.size(); i++) {
+    SignalHandle handle = other._signalNames[i].Handle;
+    _signalNames.push_back(SignalNameEntry{_signalTable[handle]->first, handle});
+  }
+}
+
+// Points this message's signals at its own lazy frame. The copied signals
+// still point at the other message's.
+void DbcMessage::BindLazyFrame()
+{
+  for (size_t i = 0; i < _signalTable.size(); i++) {
+    _signalTable[i]->second._lazyFrame = _lazy ? &_lazyFrame : NULL;
+  }
+}
+
+void DbcMessage::SetLazyDecode(bool lazy)
 {
-  _dlc = dlc;
-  _id = id;
-  _idType = idType;
-  _name = name;
-  _rawId = rawId;
+  if (lazy == _lazy) {
+    return;
+  }
+
+  // Either way every signal has to hold its value for the current frame
+  // before the switch: decode whatever is still pending, and mark the
+  // values already held as current.
+  for (size_t i = 0; i < _signalTable.size(); i++) {
+    NewEagle::DbcSignal & signal = _signalTable[i]->second;
+    signal.DecodePending();
+    signal._generation = _lazyFrame.Generation;
+  }
+
+  _lazy = lazy;
+  BindLazyFrame();
 }
 
-uint8_t DbcMessage::GetDlc()
+bool DbcMessage::GetLazyDecode() const
+{
+  return _lazy;
+}
+
+bool DbcMessage::NameBefore(const SignalNameEntry & entry, std::string_view name)
+{
+  return entry.Name < name;
+}
+
+uint8_t DbcMessage::GetDlc() const
 {
   return _dlc;
 }
 
-uint32_t DbcMessage::GetId()
+uint32_t DbcMessage::GetId() const
 {
   return _id;
 }
 
-uint32_t DbcMessage::GetRawId()
+uint32_t DbcMessage::GetRawId() const
 {
   return _rawId;
 }
 
-IdType DbcMessage::GetIdType()
+IdType DbcMessage::GetIdType() const
 {
   return _idType;
 }
 
-std::string DbcMessage::GetName()
+std::string DbcMessage::GetName() const
 {
   return _name;
 }
 
-Frame DbcMessage::GetFrame()
+Frame DbcMessage::NewFrame() const
 {
   Frame frame;
 
+  if (GetFrameSize() > sizeof(frame.data)) {
+    throw std::runtime_error(
+      "Message " + _name + " has DLC " + std::to_string(_dlc) +
+      " and does not fit in a Frame; use the (uint8_t *, size_t) overloads");
+  }
+
   frame.id = _id;
   frame.dlc = _dlc;
   frame.is_extended = _idType == EXT;
 
-  uint8_t * ptr = static_cast<uint8_t *>(frame.data._M_elems);
-  memset(ptr, 0x00, 8);
+  memset(frame.data._M_elems, 0x00, sizeof(frame.data));
+
+  return frame;
+}
 
-  if (!AnyMultiplexedSignals()) {
-    for (std::map<std::string, NewEagle::DbcSignal>::iterator it = _signals.begin();
-      it != _signals.end(); it++)
-    {
-      Pack(ptr, it->second);
+size_t DbcMessage::GetFrameSize() const
+{
+  size_t dlc = _dlc < NewEagle::MAX_FRAME_BYTES ? _dlc : NewEagle::MAX_FRAME_BYTES;
+  return dlc > 8 ? dlc : 8;
+}
+
+const std::vector<DbcSignalRecord> * DbcMessage::GetMuxGroup(double switchValue) const
+{
+  if (!(switchValue >= INT32_MIN && switchValue <= INT32_MAX)) {
+    return NULL;
+  }
+
+  std::map<int32_t, std::vector<DbcSignalRecord>>::const_iterator it =
+    _muxGroups.find(static_cast<int32_t>(switchValue));
+
+  if ((_muxGroups.end() == it) || (it->first != switchValue)) {
+    return NULL;
+  }
+
+  return &it->second;
+}
+
+Frame DbcMessage::GetFrame()
+{
+  Frame frame = NewFrame();
+
+  RefreshTemplate();
+  FinishTemplate();
+  memcpy(frame.data._M_elems, _template, sizeof(frame.data));
+
+  return frame;
+}
+
+size_t DbcMessage::GetFrame(uint8_t * data, size_t length)
+{
+  size_t size = GetFrameSize();
+
+  RefreshTemplate();
+  FinishTemplate();
+  memcpy(data, _template, length < size ? length : size);
+
+  return _dlc;
+}
+
+// The counter and checksum are written over whatever RefreshTemplate left in
+// their bits, so they never need to be tracked as changed.
+void DbcMessage::FinishTemplate()
+{
+  if (NO_SIGNAL != _counterSignal) {
+    const NewEagle::DbcSignal & counter = _signalTable[_counterSignal]->second;
+    PackRaw(_template, counter.GetPlan(), static_cast<int64_t>(_counter));
+
+    _counter++;
+    if (counter.GetLength() < 64) {
+      _counter &= (1ull << counter.GetLength()) - 1;
     }
-  } else {
-    // Start by looping through an only setting signals that are not multiplexed
-    // While we're at it, we can pick out the mutliplexer switch.
-    // Perform a second loop to find the mulitplexed signal based on the multiplexer switch.
+  }
 
-    NewEagle::DbcSignal * muxSwitch = NULL;  // only one multiplexer switch per message is allowed
+  WriteChecksum(_template);
+}
 
-    for (std::map<std::string, NewEagle::DbcSignal>::iterator it = _signals.begin();
-      it != _signals.end(); it++)
-    {
-      if (NewEagle::NONE == it->second.GetMultiplexerMode()) {
-        Pack(ptr, it->second);
-      }
-      if (NewEagle::MUX_SWITCH == it->second.GetMultiplexerMode()) {
-        muxSwitch = &it->second;
-        Pack(ptr, it->second);
-      }
+void DbcMessage::WriteChecksum(uint8_t * payload) const
+{
+  if (NewEagle::CHECKSUM_NONE == _checksumType) {
+    return;
+  }
+
+  // Everything up to the DLC except the checksum byte itself.
+  size_t size = _dlc < NewEagle::MAX_FRAME_BYTES ? _dlc : NewEagle::MAX_FRAME_BYTES;
+  size_t position = _signalTable[_checksumSignal]->second.GetStartBit() / 8;
+
+  if (position + 1 == size) {
+    payload[position] = ComputeChecksum(_checksumType, payload, position);
+    return;
+  }
+
+  uint8_t covered[NewEagle::MAX_FRAME_BYTES];
+  memcpy(covered, payload, position);
+  memcpy(covered + position, payload + position + 1, size - position - 1);
+  payload[position] = ComputeChecksum(_checksumType, covered, size - 1);
+}
+
+void DbcMessage::SetChecksum(SignalHandle signal, NewEagle::ChecksumType type)
+{
+  if (NewEagle::CHECKSUM_NONE == type) {
+    _checksumType = type;
+    _checksumSignal = NO_SIGNAL;
+    _checksumDeclared = true;
+    return;
+  }
+
+  const NewEagle::DbcSignal * checksum = GetSignal(signal);
+  size_t size = _dlc < NewEagle::MAX_FRAME_BYTES ? _dlc : NewEagle::MAX_FRAME_BYTES;
+  int32_t lowBit = NewEagle::BIG_END == checksum->GetEndianness() ? 7 : 0;
+
+  if ((8 != checksum->GetLength()) || (checksum->GetStartBit() % 8 != lowBit) ||
+    (checksum->GetStartBit() / 8u >= size))
+  {
+    throw std::runtime_error(
+      "Checksum signal " + checksum->GetName() + " in message " + _name +
+      " must be one whole byte of the payload");
+  }
+
+  _checksumType = type;
+  _checksumSignal = signal;
+  _checksumDeclared = true;
+}
+
+void DbcMessage::SetRollingCounter(SignalHandle signal)
+{
+  if ((NO_SIGNAL != signal) && !GetSignal(signal)->GetPlan().Valid) {
+    throw std::runtime_error(
+      "Rolling counter " + GetSignal(signal)->GetName() + " does not fit in message " + _name);
+  }
+
+  _counterSignal = signal;
+  _counter = 0;
+  _counterDeclared = true;
+}
+
+NewEagle::ChecksumType DbcMessage::GetChecksumType() const
+{
+  return _checksumType;
+}
+
+SignalHandle DbcMessage::GetChecksumSignal() const
+{
+  return _checksumSignal;
+}
+
+SignalHandle DbcMessage::GetRollingCounterSignal() const
+{
+  return _counterSignal;
+}
+
+bool DbcMessage::IsChecksumDeclared() const
+{
+  return _checksumDeclared;
+}
+
+bool DbcMessage::IsRollingCounterDeclared() const
+{
+  return _counterDeclared;
+}
+
+void DbcMessage::RefreshTemplate()
+{
+  bool rebuild = !_templateValid || _overlappingSignals ||
+    ((NO_MUX_SWITCH != _muxSwitch) &&
+    (_signalTable[_muxSwitch]->second.GetResult() != _packedMuxValue));
+
+  if (rebuild) {
+    memset(_template, 0x00, sizeof(_template));
+    PackInto(_template);
+
+    _packedValues.resize(_signalTable.size());
+    for (size_t i = 0; i < _signalTable.size(); i++) {
+      _packedValues[i] = _signalTable[i]->second.GetRaw();
     }
+    if (NO_MUX_SWITCH != _muxSwitch) {
+      _packedMuxValue = _signalTable[_muxSwitch]->second.GetResult();
+    }
+    _templateValid = true;
+    return;
+  }
+
+  // Same signals as PackInto, but only the ones that changed.
+  for (size_t i = 0; i < _plainSignals.size(); i++) {
+    const DbcSignalRecord & record = _plainSignals[i];
+    int64_t raw = _signalTable[record.Handle]->second.GetRaw();
+
+    if (raw != _packedValues[record.Handle]) {
+      PackRaw(_template, record.Plan, raw);
+      _packedValues[record.Handle] = raw;
+    }
+  }
+
+  if (NO_MUX_SWITCH == _muxSwitch) {
+    return;
+  }
+
+  const std::vector<DbcSignalRecord> * group = GetMuxGroup(_packedMuxValue);
 
-    for (std::map<std::string, NewEagle::DbcSignal>::iterator it = _signals.begin();
-      it != _signals.end(); it++)
-    {
-      if (NewEagle::MUX_SIGNAL == it->second.GetMultiplexerMode()) {
-        if ( (muxSwitch != NULL) &&
-          (muxSwitch->GetResult() == it->second.GetMultiplexerSwitch()))
-        {
-          Pack(ptr, it->second);
-        }
+  if (NULL != group) {
+    for (size_t i = 0; i < group->size(); i++) {
+      const DbcSignalRecord & record = (*group)[i];
+      int64_t raw = _signalTable[record.Handle]->second.GetRaw();
+
+      if (raw != _packedValues[record.Handle]) {
+        PackRaw(_template, record.Plan, raw);
+        _packedValues[record.Handle] = raw;
       }
     }
   }
+}
 
-  return frame;
+void DbcMessage::PackInto(uint8_t * payload)
+{
+  // Signals present in every frame first, including the multiplexer switch,
+  // then only the multiplexed signals the switch selects.
+  for (size_t i = 0; i < _plainSignals.size(); i++) {
+    const DbcSignalRecord & record = _plainSignals[i];
+    PackRaw(payload, record.Plan, _signalTable[record.Handle]->second.GetRaw());
+  }
+
+  if (NO_MUX_SWITCH == _muxSwitch) {
+    return;
+  }
+
+  const std::vector<DbcSignalRecord> * group =
+    GetMuxGroup(_signalTable[_muxSwitch]->second.GetResult());
+
+  if (NULL != group) {
+    for (size_t i = 0; i < group->size(); i++) {
+      const DbcSignalRecord & record = (*group)[i];
+      PackRaw(payload, record.Plan, _signalTable[record.Handle]->second.GetRaw());
+    }
+  }
 }
 
 void DbcMessage::SetFrame(const Frame::SharedPtr msg)
 {
-  uint8_t * ptr = static_cast<uint8_t *>(msg->data._M_elems);
+  SetFrame(static_cast<const uint8_t *>(msg->data._M_elems), sizeof(msg->data));
+}
 
-  if (!AnyMultiplexedSignals()) {
-    for (std::map<std::string, NewEagle::DbcSignal>::iterator it = _signals.begin();
-      it != _signals.end(); it++)
-    {
-      double res = Unpack(ptr, it->second);
-      it->second.SetResult(res);
-    }
-  } else {
-    // Start by looping through an only setting signals that are not multiplexed
-    // While we're at it, we can pick out the mutliplexer switch.
-    // Perform a second loop to find the mulitplexed signal based on the multiplexer switch.
-
-    NewEagle::DbcSignal * muxSwitch = NULL;  // only one multiplexer switch per message is allowed
-
-    for (std::map<std::string, NewEagle::DbcSignal>::iterator it = _signals.begin();
-      it != _signals.end(); it++)
-    {
-      if (NewEagle::NONE == it->second.GetMultiplexerMode()) {
-        double res = Unpack(ptr, it->second);
-        it->second.SetResult(res);
+void DbcMessage::SetFrame(const uint8_t * data, size_t length)
+{
+  size_t size = GetFrameSize();
+
+  if (_lazy) {
+    // Multiplexed signals keep their value from the last frame that selected
+    // them, so the group the outgoing frame selected is decoded before the
+    // payload is replaced. Signals already read are not decoded again.
+    const std::vector<DbcSignalRecord> * group = GetMuxGroup(_lazyFrame.MuxValue);
+
+    if (NULL != group) {
+      for (size_t i = 0; i < group->size(); i++) {
+        _signalTable[(*group)[i].Handle]->second.DecodePending();
       }
-      if (NewEagle::MUX_SWITCH == it->second.GetMultiplexerMode()) {
-        muxSwitch = &it->second;
-        double res = Unpack(ptr, it->second);
-        it->second.SetResult(res);
+    }
+
+    size_t copied = length < size ? length : size;
+    memcpy(_lazyFrame.Payload, data, copied);
+    memset(_lazyFrame.Payload + copied, 0x00, size - copied);
+
+    // After wrapping, signals last read 2^32 frames ago would look current.
+    if (0 == ++_lazyFrame.Generation) {
+      _lazyFrame.Generation = 1;
+
+      for (size_t i = 0; i < _signalTable.size(); i++) {
+        _signalTable[i]->second._generation = 0;
       }
     }
 
-    for (std::map<std::string, NewEagle::DbcSignal>::iterator it = _signals.begin();
-      it != _signals.end(); it++)
-    {
-      if (NewEagle::MUX_SIGNAL == it->second.GetMultiplexerMode()) {
-        if ((muxSwitch != NULL) &&
-          (muxSwitch->GetResult() == it->second.GetMultiplexerSwitch()))
-        {
-          double res = Unpack(ptr, it->second);
-          it->second.SetResult(res);
-        }
+    // The switch is decoded right away: it decides which multiplexed signals
+    // this frame carries, even if the switch signal is set afterwards.
+    if (NO_MUX_SWITCH != _muxSwitch) {
+      NewEagle::DbcSignal & muxSwitch = _signalTable[_muxSwitch]->second;
+      muxSwitch.SetRaw(UnpackRaw(_lazyFrame.Payload, muxSwitch));
+      _lazyFrame.MuxValue = muxSwitch.GetResult();
+    }
+    return;
+  }
+
+  if (length >= size) {
+    UnpackFrom(data);
+  } else {
+    uint8_t payload[NewEagle::MAX_FRAME_BYTES] = {0};
+    memcpy(payload, data, length);
+    UnpackFrom(payload);
+  }
+}
+
+void DbcMessage::UnpackFrom(const uint8_t * payload)
+{
+  for (size_t i = 0; i < _plainSignals.size(); i++) {
+    const DbcSignalRecord & record = _plainSignals[i];
+    _signalTable[record.Handle]->second.SetRaw(UnpackRaw(payload, record));
+  }
+
+  if (NO_MUX_SWITCH == _muxSwitch) {
+    return;
+  }
+
+  const std::vector<DbcSignalRecord> * group =
+    GetMuxGroup(_signalTable[_muxSwitch]->second.GetResult());
+
+  if (NULL != group) {
+    for (size_t i = 0; i < group->size(); i++) {
+      const DbcSignalRecord & record = (*group)[i];
+      _signalTable[record.Handle]->second.SetRaw(UnpackRaw(payload, record));
+    }
+  }
+}
+
+void DbcMessage::AddSignal(std::string signalName, const NewEagle::DbcSignal & signal)
+{
+  std::pair<std::map<std::string, NewEagle::DbcSignal>::iterator, bool> result =
+    _signals.try_emplace(std::move(signalName), signal);
+
+  if (!result.second) {
+    return;
+  }
+
+  SignalHandle handle = static_cast<SignalHandle>(_signalTable.size());
+
+  // Signals that can end up in the same frame must not share bits for
+  // GetFrame to repack them one at a time.
+  for (size_t i = 0; i < _signalTable.size() && !_overlappingSignals; i++) {
+    const NewEagle::DbcSignal & other = _signalTable[i]->second;
+    bool exclusive =
+      (NewEagle::MUX_SIGNAL == signal.GetMultiplexerMode()) &&
+      (NewEagle::MUX_SIGNAL == other.GetMultiplexerMode()) &&
+      (signal.GetMultiplexerSwitch() != other.GetMultiplexerSwitch());
+
+    _overlappingSignals = !exclusive && SignalsOverlap(signal, other);
+
+    // From here on PackInto has to go in the order signals were added.
+    if (_overlappingSignals) {
+      std::sort(_plainSignals.begin(), _plainSignals.end(), AddedBefore);
+
+      for (std::map<int32_t, std::vector<DbcSignalRecord>>::iterator it = _muxGroups.begin();
+        it != _muxGroups.end(); it++)
+      {
+        std::sort(it->second.begin(), it->second.end(), AddedBefore);
       }
     }
   }
+
+  _signalTable.push_back(result.first);
+  _templateValid = false;
+
+  // A signal copied out of another message may still point at its frame.
+  NewEagle::DbcSignal & added = result.first->second;
+  added._lazyFrame = _lazy ? &_lazyFrame : NULL;
+  added._generation = _lazyFrame.Generation;
+
+  std::string_view name = result.first->first;
+  _signalNames.insert(
+    std::lower_bound(_signalNames.begin(), _signalNames.end(), name, NameBefore),
+    SignalNameEntry{name, handle});
+
+  DbcSignalRecord record;
+  record.Plan = signal.GetPlan();
+  record.Gain = signal.GetGain();
+  record.Offset = signal.GetOffset();
+  record.Handle = handle;
+  record.StartBit = signal.GetStartBit();
+
+  if (NewEagle::MUX_SIGNAL == signal.GetMultiplexerMode()) {
+    AddRecord(_muxGroups[signal.GetMultiplexerSwitch()], record);
+  } else {
+    AddRecord(_plainSignals, record);
+  }
+
+  // Only one multiplexer switch per message is allowed.
+  if (NewEagle::MUX_SWITCH == signal.GetMultiplexerMode()) {
+    _muxSwitch = handle;
+  }
 }
 
-void DbcMessage::AddSignal(std::string signalName, NewEagle::DbcSignal signal)
+void DbcMessage::ReserveSignals(size_t count)
 {
-  _signals.insert(std::pair<std::string, NewEagle::DbcSignal>(signalName, signal));
+  _signalTable.reserve(count);
+  _signalNames.reserve(count);
+  _plainSignals.reserve(count);
 }
 
-NewEagle::DbcSignal * DbcMessage::GetSignal(std::string signalName)
+void DbcMessage::AddRecord(
+  std::vector<DbcSignalRecord> & records,
+  const DbcSignalRecord & record) const
 {
-  std::map<std::string, NewEagle::DbcSignal>::iterator it;
+  std::vector<DbcSignalRecord>::iterator it = _overlappingSignals ?
+    records.end() :
+    std::upper_bound(records.begin(), records.end(), record, StartsBefore);
+
+  records.insert(it, record);
+}
 
-  it = _signals.find(signalName);
+NewEagle::DbcSignal * DbcMessage::GetSignal(std::string_view signalName)
+{
+  std::vector<SignalNameEntry>::const_iterator it =
+    std::lower_bound(_signalNames.begin(), _signalNames.end(), signalName, NameBefore);
 
-  if (_signals.end() == it) {
+  if ((_signalNames.end() == it) || (it->Name != signalName)) {
     return NULL;
   }
 
-  NewEagle::DbcSignal * signal = &it->second;
+  return &_signalTable[it->Handle]->second;
+}
+
+NewEagle::DbcSignal * DbcMessage::GetSignal(SignalHandle handle)
+{
+  return &_signalTable[handle]->second;
+}
+
+const NewEagle::DbcSignal * DbcMessage::GetSignal(SignalHandle handle) const
+{
+  return &_signalTable[handle]->second;
+}
+
+static void UnpackInto(
+  const uint8_t * data, const NewEagle::DbcSignalRecord & record, double * values)
+{
+  values[record.Handle] = Unpack(data, record);
+}
+
+static void UnpackInto(
+  const uint8_t * data, const NewEagle::DbcSignalRecord & record, int64_t * values)
+{
+  values[record.Handle] = UnpackRaw(data, record);
+}
+
+// The switch selects its group by physical value, so DecodeRaw has to scale it first.
+static double SwitchValue(double value, const NewEagle::DbcSignal &)
+{
+  return value;
+}
+
+static double SwitchValue(int64_t raw, const NewEagle::DbcSignal & muxSwitch)
+{
+  return ToPhysical(raw, muxSwitch.GetPlan(), muxSwitch.GetGain(), muxSwitch.GetOffset());
+}
+
+template<typename T>
+void DbcMessage::DecodeInto(const uint8_t * data, T * values) const
+{
+  // Same order as SetFrame: everything but the multiplexed signals first,
+  // then the multiplexed signals selected by the switch.
+  for (size_t i = 0; i < _plainSignals.size(); i++) {
+    UnpackInto(data, _plainSignals[i], values);
+  }
+
+  if (NO_MUX_SWITCH == _muxSwitch) {
+    return;
+  }
+
+  const std::vector<DbcSignalRecord> * group =
+    GetMuxGroup(SwitchValue(values[_muxSwitch], _signalTable[_muxSwitch]->second));
 
-  return signal;
+  if (NULL != group) {
+    for (size_t i = 0; i < group->size(); i++) {
+      UnpackInto(data, (*group)[i], values);
+    }
+  }
 }
 
-uint32_t DbcMessage::GetSignalCount()
+void DbcMessage::Decode(const uint8_t * data, double * values) const
+{
+  DecodeInto(data, values);
+}
+
+void DbcMessage::DecodeRaw(const uint8_t * data, int64_t * values) const
+{
+  DecodeInto(data, values);
+}
+
+Frame DbcMessage::Encode(const double * values) const
+{
+  Frame frame = NewFrame();
+
+  uint8_t * ptr = static_cast<uint8_t *>(frame.data._M_elems);
+
+  EncodeInto(values, ptr);
+  WriteChecksum(ptr);
+
+  return frame;
+}
+
+size_t DbcMessage::Encode(const double * values, uint8_t * data, size_t length) const
+{
+  size_t size = GetFrameSize();
+
+  if (length >= size) {
+    memset(data, 0x00, size);
+    EncodeInto(values, data);
+    WriteChecksum(data);
+  } else {
+    uint8_t payload[NewEagle::MAX_FRAME_BYTES] = {0};
+    EncodeInto(values, payload);
+    WriteChecksum(payload);
+    memcpy(data, payload, length);
+  }
+
+  return _dlc;
+}
+
+void DbcMessage::EncodeInto(const double * values, uint8_t * payload) const
+{
+  for (size_t i = 0; i < _plainSignals.size(); i++) {
+    const DbcSignalRecord & record = _plainSignals[i];
+    PackValue(payload, record, values[record.Handle]);
+  }
+
+  if (NO_MUX_SWITCH == _muxSwitch) {
+    return;
+  }
+
+  const std::vector<DbcSignalRecord> * group = GetMuxGroup(values[_muxSwitch]);
+
+  if (NULL != group) {
+    for (size_t i = 0; i < group->size(); i++) {
+      const DbcSignalRecord & record = (*group)[i];
+      PackValue(payload, record, values[record.Handle]);
+    }
+  }
+}
+
+SignalHandle DbcMessage::GetSignalHandle(std::string_view signalName) const
+{
+  std::vector<SignalNameEntry>::const_iterator it =
+    std::lower_bound(_signalNames.begin(), _signalNames.end(), signalName, NameBefore);
+
+  if ((_signalNames.end() == it) || (it->Name != signalName)) {
+    throw std::runtime_error(
+      "Signal " + std::string(signalName) + " not found in message " + _name);
+  }
+
+  return it->Handle;
+}
+
+uint32_t DbcMessage::GetSignalCount() const
 {
   return _signals.size();
 }
 
 void DbcMessage::SetComment(NewEagle::DbcMessageComment comment)
 {
-  _comment = comment;
+  _comment = std::move(comment);
 }
 
 std::map<std::string, NewEagle::DbcSignal> * DbcMessage::GetSignals()
@@ -213,16 +858,8 @@ std::map<std::string, NewEagle::DbcSignal> * DbcMessage::GetSignals()
   return &_signals;
 }
 
-bool DbcMessage::AnyMultiplexedSignals()
+bool DbcMessage::AnyMultiplexedSignals() const
 {
-  for (std::map<std::string, NewEagle::DbcSignal>::iterator it = _signals.begin();
-    it != _signals.end(); it++)
-  {
-    if (NewEagle::MUX_SWITCH == it->second.GetMultiplexerMode()) {
-      return true;
-    }
-  }
-
-  return false;
+  return NO_MUX_SWITCH != _muxSwitch;
 }
 }  // namespace NewEagle
@@ -27,8 +27,11 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include <can_dbc_parser/DbcSignal.hpp>
+#include <can_dbc_parser/DbcStrings.hpp>
+#include <can_dbc_parser/DbcUtilities.hpp>
 
 #include <string>
+#include <string_view>
 
 namespace NewEagle
 {
@@ -36,33 +39,43 @@ DbcSignal::DbcSignal(
   uint8_t dlc,
   double gain,
   double offset,
-  uint8_t startBit,
+  uint16_t startBit,
   ByteOrder endianness,
   uint8_t length,
   SignType sign,
-  std::string name,
+  std::string_view name,
   MultiplexerMode multiplexerMode)
-: _dlc(dlc),
+: _result(0.0),
+  _raw(0),
   _gain(gain),
   _offset(offset),
+  _initialValue(0.0),
+  _name(InternString(name)),
+  _comment(NULL),
+  _lazyFrame(NULL),
+  _multiplexerSwitch(0),
+  _generation(0),
   _startBit(startBit),
-  _endianness(endianness),
+  _dlc(dlc),
   _length(length),
-  _sign(sign),
-  _name(name),
-  _multiplexerMode(multiplexerMode)
+  _endianness(static_cast<uint8_t>(endianness)),
+  _sign(static_cast<uint8_t>(sign)),
+  _type(static_cast<uint8_t>(NewEagle::INT)),
+  _multiplexerMode(static_cast<uint8_t>(multiplexerMode)),
+  _current(NewEagle::RESULT_CURRENT)
 {
+  BuildPlan();
 }
 
 DbcSignal::DbcSignal(
   uint8_t dlc,
   double gain,
   double offset,
-  uint8_t startBit,
+  uint16_t startBit,
   ByteOrder endianness,
   uint8_t length,
   SignType sign,
-  std::string name,
+  std::string_view name,
   MultiplexerMode multiplexerMode,
   int32_t multiplexerSwitch)
 : DbcSignal(dlc, gain, offset, startBit, endianness,
@@ -78,9 +91,49 @@ uint8_t DbcSignal::GetDlc() const
 
 double DbcSignal::GetResult() const
 {
+  DecodePending();
+
+  if (0 == (_current & NewEagle::RESULT_CURRENT)) {
+    _result = ToPhysical(_raw, _plan, _gain, _offset);
+    _current |= NewEagle::RESULT_CURRENT;
+  }
+
   return _result;
 }
 
+int64_t DbcSignal::GetRaw() const
+{
+  DecodePending();
+
+  if (0 == (_current & NewEagle::RAW_CURRENT)) {
+    _raw = ToRaw(_result, _plan, _gain, _offset);
+    _current |= NewEagle::RAW_CURRENT;
+  }
+
+  return _raw;
+}
+
+// Decodes the signal from its message's lazy frame if it has not been read
+// since the last SetFrame, with the result SetFrame would have stored:
+// multiplexed signals the switch does not select keep their previous value.
+void DbcSignal::DecodePending() const
+{
+  if ((NULL == _lazyFrame) || (_generation == _lazyFrame->Generation)) {
+    return;
+  }
+
+  _generation = _lazyFrame->Generation;
+
+  if ((NewEagle::MUX_SIGNAL == _multiplexerMode) &&
+    (_lazyFrame->MuxValue != _multiplexerSwitch))
+  {
+    return;
+  }
+
+  _raw = UnpackRaw(_lazyFrame->Payload, _plan);
+  _current = NewEagle::RAW_CURRENT;
+}
+
 double DbcSignal::GetGain() const
 {
   return _gain;
@@ -91,14 +144,14 @@ double DbcSignal::GetOffset() const
   return _offset;
 }
 
-uint8_t DbcSignal::GetStartBit() const
+uint16_t DbcSignal::GetStartBit() const
 {
   return _startBit;
 }
 
 ByteOrder DbcSignal::GetEndianness() const
 {
-  return _endianness;
+  return static_cast<NewEagle::ByteOrder>(_endianness);
 }
 
 uint8_t DbcSignal::GetLength() const
@@ -108,27 +161,44 @@ uint8_t DbcSignal::GetLength() const
 
 SignType DbcSignal::GetSign() const
 {
-  return _sign;
+  return static_cast<NewEagle::SignType>(_sign);
 }
 
 std::string DbcSignal::GetName() const
 {
-  return _name;
+  return *_name;
 }
 
 void DbcSignal::SetResult(double result)
 {
   _result = result;
+  _current = NewEagle::RESULT_CURRENT;
+
+  if (NULL != _lazyFrame) {
+    _generation = _lazyFrame->Generation;
+  }
+}
+
+void DbcSignal::SetRaw(int64_t raw)
+{
+  _raw = raw;
+  _current = NewEagle::RAW_CURRENT;
+
+  if (NULL != _lazyFrame) {
+    _generation = _lazyFrame->Generation;
+  }
 }
 
-void DbcSignal::SetComment(NewEagle::DbcSignalComment comment)
+void DbcSignal::SetComment(const NewEagle::DbcSignalComment & comment)
 {
-  _comment = comment;
+  _comment = InternString(comment.Comment);
 }
 
+// The start value is also what GetFrame sends until a result is set.
 void DbcSignal::SetInitialValue(double value)
 {
   _initialValue = value;
+  SetResult(value);
 }
 double DbcSignal::GetInitialValue()
 {
@@ -137,21 +207,78 @@ double DbcSignal::GetInitialValue()
 
 void DbcSignal::SetDataType(NewEagle::DataType type)
 {
-  _type = type;
+  _type = static_cast<uint8_t>(type);
 }
 
 NewEagle::DataType DbcSignal::GetDataType()
 {
-  return _type;
+  return static_cast<NewEagle::DataType>(_type);
 }
 
 NewEagle::MultiplexerMode DbcSignal::GetMultiplexerMode() const
 {
-  return _multiplexerMode;
+  return static_cast<NewEagle::MultiplexerMode>(_multiplexerMode);
 }
 
 int32_t DbcSignal::GetMultiplexerSwitch() const
 {
   return _multiplexerSwitch;
 }
+
+const NewEagle::DbcSignalPlan & DbcSignal::GetPlan() const
+{
+  return _plan;
+}
+
+void DbcSignal::BuildPlan()
+{
+  const int32_t frameBits = 64;
+  const int32_t length = static_cast<int32_t>(_length);
+  // Classic frames are always 8 bytes on the wire; FD frames are as long as the DLC.
+  const int32_t frameBytes = _dlc > 8 ? (_dlc < MAX_FRAME_BYTES ? _dlc : MAX_FRAME_BYTES) : 8;
+  const int32_t row = _startBit / 8;
+  int32_t lastRow;
+
+  // Bytes the signal touches, in frame order.
+  if (_endianness == NewEagle::LITTLE_END) {
+    lastRow = (_startBit + length - 1) / 8;
+  } else {
+    // Motorola signals start at the MSB and run into the following bytes.
+    int32_t bitsInFirstRow = _startBit % 8 + 1;
+    lastRow = row + (length > bitsInFirstRow ? (length - bitsInFirstRow + 7) / 8 : 0);
+  }
+
+  int32_t byteOffset = lastRow > 7 ? lastRow - 7 : 0;
+  int32_t lsb;
+
+  if (_endianness == NewEagle::LITTLE_END) {
+    lsb = _startBit - byteOffset * 8;
+  } else {
+    // Motorola start bits name the MSB in sawtooth order; count from the
+    // least significant bit of the last byte of the word instead.
+    int32_t msb = frameBits - (row - byteOffset + 1) * 8 + _startBit % 8;
+    lsb = msb - (length - 1);
+  }
+
+  _plan.Valid = (length > 0) && (lastRow < frameBytes) && (row >= byteOffset) &&
+    (lsb >= 0) && (lsb + length <= frameBits);
+  _plan.BigEndian = (_endianness == NewEagle::BIG_END);
+  _plan.Signed = (_sign == NewEagle::SIGNED);
+  _plan.Scaled = (_gain != 1) || (_offset != 0);
+
+  if (!_plan.Valid) {
+    _plan.ByteOffset = 0;
+    _plan.LeftShift = 0;
+    _plan.RightShift = 0;
+    _plan.Shift = 0;
+    _plan.Mask = 0;
+    return;
+  }
+
+  _plan.ByteOffset = static_cast<uint8_t>(byteOffset);
+  _plan.LeftShift = static_cast<uint8_t>(frameBits - (lsb + _length));
+  _plan.RightShift = static_cast<uint8_t>(frameBits - _length);
+  _plan.Shift = static_cast<uint8_t>(lsb);
+  _plan.Mask = (~static_cast<uint64_t>(0) >> _plan.RightShift) << _plan.Shift;
+}
 }  // namespace NewEagle
@@ -0,0 +1,87 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <can_dbc_parser/DbcStrings.hpp>
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace NewEagle
+{
+// The index is keyed by views of the stored strings so a lookup never builds
+// a std::string.
+typedef std::unordered_map<std::string_view, const std::string *> StringIndex;
+
+// Never destroyed, so signals that outlive static destruction keep valid names.
+static StringIndex & Strings()
+{
+  static StringIndex * strings = new StringIndex();
+  return *strings;
+}
+
+static std::mutex & StringsMutex()
+{
+  static std::mutex * mutex = new std::mutex();
+  return *mutex;
+}
+
+const std::string * InternString(std::string_view text)
+{
+  std::lock_guard<std::mutex> lock(StringsMutex());
+  StringIndex & strings = Strings();
+
+  StringIndex::const_iterator it = strings.find(text);
+
+  if (strings.end() != it) {
+    return it->second;
+  }
+
+  const std::string * stored = new std::string(text);
+  strings.emplace(*stored, stored);
+  return stored;
+}
+
+size_t InternedStringCount()
+{
+  std::lock_guard<std::mutex> lock(StringsMutex());
+  return Strings().size();
+}
+
+void ClearInternedStrings()
+{
+  std::lock_guard<std::mutex> lock(StringsMutex());
+  StringIndex & strings = Strings();
+
+  for (StringIndex::iterator it = strings.begin(); it != strings.end(); it++) {
+    delete it->second;
+  }
+  strings.clear();
+}
+}  // namespace NewEagle
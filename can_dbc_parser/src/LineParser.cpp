@@ -28,12 +28,55 @@
 
 #include <can_dbc_parser/LineParser.hpp>
 
-#include <sstream>
+#include <charconv>
+#include <cstdlib>
 #include <string>
 
 namespace NewEagle
 {
-LineParser::LineParser(const std::string & line)
+// Throws the exception the Read* methods have always thrown for a status.
+static void ThrowStatus(NewEagle::LineParserStatus status, const char * what)
+{
+  switch (status) {
+    case NewEagle::LINE_PARSER_AT_EOL:
+      throw LineParserAtEOLException();
+    case NewEagle::LINE_PARSER_LEN_ZERO:
+      throw LineParserLenZeroException();
+    case NewEagle::LINE_PARSER_INVALID_CHAR:
+      throw LineParserInvalidCharException();
+    default:
+      throw std::runtime_error(what);
+  }
+}
+
+// Accumulates the digits in text; saturates like istream extraction does on overflow.
+template<typename T>
+static T ParseDigits(std::string_view text)
+{
+  uint64_t value = 0;
+
+  for (char c : text) {
+    value = value * 10 + static_cast<uint64_t>(c - '0');
+    if (value > UINT32_MAX) {
+      return static_cast<T>(UINT32_MAX);
+    }
+  }
+
+  return static_cast<T>(value);
+}
+
+static bool IsIdentifierChar(char c)
+{
+  return isalpha(static_cast<unsigned char>(c)) || isdigit(static_cast<unsigned char>(c)) ||
+         c == '_';
+}
+
+static bool IsDigit(char c)
+{
+  return isdigit(static_cast<unsigned char>(c)) != 0;
+}
+
+LineParser::LineParser(std::string_view line)
 {
   _line = line;
   _position = 0;
@@ -41,39 +84,54 @@ LineParser::LineParser(const std::string & line)
 
 int32_t LineParser::GetPosition()
 {
-  return _position;
+  return static_cast<int32_t>(_position);
 }
 
-std::string LineParser::ReadCIdentifier()
+LineParserStatus LineParser::TryReadCIdentifier(std::string_view & value)
 {
   SkipWhitespace();
 
   if (AtEOL()) {
-    throw LineParserAtEOLException();
+    return LINE_PARSER_AT_EOL;
   }
 
-  if (!isalpha(_line[_position]) && _line[_position] != '_') {
-    throw std::runtime_error("ReadCIdentifier: Unexpected character");
+  if (!isalpha(static_cast<unsigned char>(_line[_position])) && _line[_position] != '_') {
+    return LINE_PARSER_UNEXPECTED_CHAR;
   }
 
-  int32_t startIdx = _position;
+  size_t startIdx = _position;
 
-  for (_position++; !AtEOL(); _position++) {
-    if (!(isalpha(_line[_position]) || isdigit(_line[_position])) && _line[_position] != '_') {
-      int32_t len = _position - startIdx;
-      return _line.substr(startIdx, len);
-    }
+  for (_position++; !AtEOL() && IsIdentifierChar(_line[_position]); _position++) {
+  }
+
+  value = _line.substr(startIdx, _position - startIdx);
+  return LINE_PARSER_OK;
+}
+
+std::string LineParser::ReadCIdentifier()
+{
+  return std::string(ReadCIdentifierView());
+}
+
+// Same as ReadCIdentifier, without copying the identifier out of the line.
+std::string_view LineParser::ReadCIdentifierView()
+{
+  std::string_view val;
+  LineParserStatus status = TryReadCIdentifier(val);
+
+  if (LINE_PARSER_OK != status) {
+    ThrowStatus(status, "ReadCIdentifier: Unexpected character");
   }
 
-  return _line.substr(startIdx, std::string::npos);
+  return val;
 }
 
-std::string LineParser::ReadCIdentifier(std::string fieldName)
+std::string LineParser::ReadCIdentifier(const char * fieldName)
 {
   std::string val = ReadCIdentifier();
 
-  if (val == std::string()) {
-    throw std::runtime_error("Synxax Error: Expected : " + fieldName);
+  if (val.empty()) {
+    throw std::runtime_error(std::string("Synxax Error: Expected : ") + fieldName);
   }
 
   return val;
@@ -81,169 +139,171 @@ std::string LineParser::ReadCIdentifier(std::string fieldName)
 
 void LineParser::SkipWhitespace()
 {
-  while (!AtEOL() && isspace(_line[_position])) {
+  while (!AtEOL() && isspace(static_cast<unsigned char>(_line[_position]))) {
     _position++;
   }
 }
 
 bool LineParser::AtEOL()
 {
-  return _position >= static_cast<int32_t>(_line.length());
+  return _position >= _line.size();
 }
 
-char LineParser::ReadNextChar()
+LineParserStatus LineParser::TryReadNextChar(char & value)
 {
   SkipWhitespace();
 
   if (AtEOL()) {
-    throw LineParserAtEOLException();
+    return LINE_PARSER_AT_EOL;
   }
 
-  int32_t idx = _position;
-  _position++;
-
-  return _line[idx];
+  value = _line[_position++];
+  return LINE_PARSER_OK;
 }
 
-char LineParser::ReadNextChar(std::string /*fieldName*/)
+char LineParser::ReadNextChar()
 {
-  try {
-    char val = ReadNextChar();
-    return val;
-  } catch (LineParserExceptionBase & exlp) {
-    throw;
+  char val = 0;
+  LineParserStatus status = TryReadNextChar(val);
+
+  if (LINE_PARSER_OK != status) {
+    ThrowStatus(status, "ReadNextChar");
   }
+
+  return val;
 }
 
-uint32_t LineParser::PeekUInt()
+char LineParser::ReadNextChar(const char * /*fieldName*/)
+{
+  return ReadNextChar();
+}
+
+// Finds the end of the run of digits at the current position without consuming it.
+LineParserStatus LineParser::ScanUInt(size_t & end)
 {
   SkipWhitespace();
 
   if (AtEOL()) {
-    throw LineParserAtEOLException();
+    return LINE_PARSER_AT_EOL;
   }
 
-  int32_t position = _position;
-
-  int32_t startIdx = position;
-  int32_t len = -1;
-
-  for (; !AtEOL(); position++) {
-    if (!isdigit(_line[position])) {
-      len = position - startIdx;
-      break;
-    }
+  for (end = _position; end < _line.size() && IsDigit(_line[end]); end++) {
   }
 
-  if (-1 == len) {
-    len = position - startIdx;
+  if (end == _position) {
+    return LINE_PARSER_LEN_ZERO;
   }
 
-  if (0 == len) {
-    throw LineParserLenZeroException();
-  }
+  return LINE_PARSER_OK;
+}
 
-  std::istringstream reader(_line.substr(startIdx, len));
-  uint32_t val;
-  reader >> val;
+LineParserStatus LineParser::TryPeekUInt(uint32_t & value)
+{
+  size_t end = 0;
+  LineParserStatus status = ScanUInt(end);
 
-  return val;
+  if (LINE_PARSER_OK == status) {
+    value = ParseDigits<uint32_t>(_line.substr(_position, end - _position));
+  }
+
+  return status;
 }
 
-uint32_t LineParser::ReadUInt()
+LineParserStatus LineParser::TryReadUInt(uint32_t & value)
 {
-  SkipWhitespace();
+  size_t end = 0;
+  LineParserStatus status = ScanUInt(end);
 
-  if (AtEOL()) {
-    throw LineParserAtEOLException();
+  if (LINE_PARSER_OK == status) {
+    value = ParseDigits<uint32_t>(_line.substr(_position, end - _position));
+    _position = end;
   }
 
-  int32_t startIdx = _position;
-  int32_t len = -1;
+  return status;
+}
 
-  for (; !AtEOL(); _position++) {
-    if (!isdigit(_line[_position])) {
-      len = _position - startIdx;
-      break;
-    }
-  }
+uint32_t LineParser::PeekUInt()
+{
+  uint32_t val = 0;
+  LineParserStatus status = TryPeekUInt(val);
 
-  if (-1 == len) {
-    len = _position - startIdx;
+  if (LINE_PARSER_OK != status) {
+    ThrowStatus(status, "PeekUInt");
   }
 
-  if (0 == len) {
-    throw LineParserLenZeroException();
-  }
+  return val;
+}
 
-  std::istringstream reader(_line.substr(startIdx, len));
-  uint32_t val;
-  reader >> val;
+uint32_t LineParser::ReadUInt()
+{
+  uint32_t val = 0;
+  LineParserStatus status = TryReadUInt(val);
+
+  if (LINE_PARSER_OK != status) {
+    ThrowStatus(status, "ReadUInt");
+  }
 
   return val;
 }
 
-uint32_t LineParser::ReadUInt(std::string /*fieldName*/)
+uint32_t LineParser::ReadUInt(const char * /*fieldName*/)
 {
-  try {
-    uint32_t val = ReadUInt();
-    return val;
-  } catch (LineParserExceptionBase & exlp) {
-    throw;
-  }
+  return ReadUInt();
 }
 
-int32_t LineParser::ReadInt()
+LineParserStatus LineParser::TryReadInt(int32_t & value)
 {
   SkipWhitespace();
 
   if (AtEOL()) {
-    throw LineParserAtEOLException();
+    return LINE_PARSER_AT_EOL;
   }
 
-  if (!isdigit(_line[_position]) && _line[_position] != '-' && _line[_position] != '+') {
-    throw LineParserInvalidCharException();
+  char first = _line[_position];
+  if (!IsDigit(first) && first != '-' && first != '+') {
+    return LINE_PARSER_INVALID_CHAR;
   }
 
-  int32_t startIdx = _position;
-  int32_t len = -1;
+  size_t startIdx = _position;
+  size_t digitsIdx = IsDigit(first) ? startIdx : startIdx + 1;
 
-  for (_position++; !AtEOL(); _position++) {
-    if (!isdigit(_line[_position])) {
-      len = _position - startIdx;
-      break;
-    }
+  for (_position++; !AtEOL() && IsDigit(_line[_position]); _position++) {
   }
 
-  if (-1 == len) {
-    len = _position - startIdx;
+  if (digitsIdx == _position) {
+    return LINE_PARSER_INVALID_CHAR;
   }
 
-  if (0 == len) {
-    throw LineParserLenZeroException();
-  }
+  int64_t magnitude = ParseDigits<int64_t>(_line.substr(digitsIdx, _position - digitsIdx));
+  value = static_cast<int32_t>('-' == first ? -magnitude : magnitude);
+  return LINE_PARSER_OK;
+}
+
+int32_t LineParser::ReadInt()
+{
+  int32_t val = 0;
+  LineParserStatus status = TryReadInt(val);
 
-  std::istringstream reader(_line.substr(startIdx, len));
-  int32_t val;
-  reader >> val;
+  if (LINE_PARSER_OK != status) {
+    ThrowStatus(status, "ReadInt");
+  }
 
   return val;
 }
 
-double LineParser::ReadDouble()
+LineParserStatus LineParser::TryReadDouble(double & value)
 {
   SkipWhitespace();
 
   if (AtEOL()) {
-    throw LineParserAtEOLException();
+    return LINE_PARSER_AT_EOL;
   }
 
-  if (!isdigit(_line[_position]) && _line[_position] != '-' && _line[_position] != '+') {
-    throw LineParserInvalidCharException();
+  if (!IsDigit(_line[_position]) && _line[_position] != '-' && _line[_position] != '+') {
+    return LINE_PARSER_INVALID_CHAR;
   }
 
-  int32_t startIdx = _position;
-  int32_t len = -1;
+  size_t startIdx = _position;
 
   NewEagle::ReadDoubleState state = NewEagle::READING_WHOLE_NUMBER;
 
@@ -256,34 +316,34 @@ double LineParser::ReadDouble()
           state = NewEagle::READ_E;
         } else if ('.' == c) {
           state = NewEagle::READING_FRACTION;
-        } else if (!isdigit(c)) {
+        } else if (!IsDigit(c)) {
           goto DoneReading;
         }
         break;
       case NewEagle::READING_FRACTION:
         if ('E' == c || 'e' == c) {
           state = NewEagle::READ_E;
-        } else if (!isdigit(c)) {
+        } else if (!IsDigit(c)) {
           goto DoneReading;
         }
         break;
       case NewEagle::READ_E:
         if ('+' == c || '-' == c) {
           state = NewEagle::READ_SIGN;
-        } else if (isdigit(c)) {
+        } else if (IsDigit(c)) {
           state = NewEagle::READING_EXP;
         }
         break;
       case NewEagle::READ_SIGN:
-        if (!isdigit(c)) {
-          throw LineParserInvalidCharException();
+        if (!IsDigit(c)) {
+          return LINE_PARSER_INVALID_CHAR;
         } else {
           state = NewEagle::READING_EXP;
         }
 
         break;
       case NewEagle::READING_EXP:
-        if (!isdigit(c)) {
+        if (!IsDigit(c)) {
           goto DoneReading;
         }
         break;
@@ -293,27 +353,45 @@ double LineParser::ReadDouble()
   }
 
 DoneReading:
-  len = _position - startIdx;
+  std::string_view token = _line.substr(startIdx, _position - startIdx);
+  if ('+' == token[0]) {
+    token.remove_prefix(1);
+  }
+
+#if defined(__cpp_lib_to_chars)
+  std::from_chars(token.data(), token.data() + token.size(), value);
+#else
+  // strtod needs a terminated string; numbers in a DBC are short enough for
+  // the stack buffer, the rest take the slow path.
+  char buffer[64];
 
-  if (0 == len) {
-    throw LineParserLenZeroException();
+  if (token.size() < sizeof(buffer)) {
+    token.copy(buffer, token.size());
+    buffer[token.size()] = '\0';
+    value = strtod(buffer, NULL);
+  } else {
+    value = strtod(std::string(token).c_str(), NULL);
   }
+#endif
 
-  std::istringstream reader(_line.substr(startIdx, len));
-  double val;
-  reader >> val;
+  return LINE_PARSER_OK;
+}
+
+double LineParser::ReadDouble()
+{
+  double val = 0.0;
+  LineParserStatus status = TryReadDouble(val);
+
+  if (LINE_PARSER_OK != status) {
+    ThrowStatus(status, "ReadDouble");
+  }
 
   return val;
 }
 
-double LineParser::ReadDouble(std::string /*fieldName*/)
+double LineParser::ReadDouble(const char * /*fieldName*/)
 {
-  try {
-    double val = ReadDouble();
-    return val;
-  } catch (LineParserExceptionBase & exlp) {
-    throw;
-  }
+  return ReadDouble();
 }
 
 void LineParser::SeekSeparator(char separator)
@@ -327,37 +405,41 @@ void LineParser::SeekSeparator(char separator)
   }
 }
 
-std::string LineParser::ReadQuotedString()
+LineParserStatus LineParser::TryReadQuotedString(std::string_view & value)
 {
   SkipWhitespace();
 
   if (AtEOL()) {
-    throw LineParserAtEOLException();
+    return LINE_PARSER_AT_EOL;
   }
 
   if (_line[_position] != '"') {
-    throw std::runtime_error("ReadQuotedString: Missing Quote");
+    return LINE_PARSER_MISSING_QUOTE;
   }
 
-  int32_t startIdx = ++_position;
-  int32_t len = -1;
+  size_t startIdx = _position + 1;
+  size_t endIdx = _line.find('"', startIdx);
 
-  for (; _position < static_cast<int32_t>(_line.size()); _position++) {
-    if (_line[_position] == '"') {
-      len = _position - startIdx;
-      _position++;
-      break;
-    }
+  // An unterminated or empty string is reported as an empty search space.
+  if (std::string_view::npos == endIdx || endIdx == startIdx) {
+    _position = (std::string_view::npos == endIdx) ? _line.size() : endIdx + 1;
+    return LINE_PARSER_LEN_ZERO;
   }
 
-  if (-1 == len) {
-    throw LineParserLenZeroException();
-  }
+  _position = endIdx + 1;
+  value = _line.substr(startIdx, endIdx - startIdx);
+  return LINE_PARSER_OK;
+}
+
+std::string LineParser::ReadQuotedString()
+{
+  std::string_view val;
+  LineParserStatus status = TryReadQuotedString(val);
 
-  if (0 == len) {
-    throw LineParserLenZeroException();
+  if (LINE_PARSER_OK != status) {
+    ThrowStatus(status, "ReadQuotedString: Missing Quote");
   }
 
-  return _line.substr(startIdx, len);
+  return std::string(val);
 }
 }  // namespace NewEagle
@@ -0,0 +1,326 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Generates a C++ header with one struct per DBC message and constexpr
+// decode/encode functions. Invoked by the can_dbc_generate() CMake function:
+//   can_dbc_codegen <dbc file> <output header> <namespace>
+
+#include <can_dbc_parser/Dbc.hpp>
+#include <can_dbc_parser/DbcBuilder.hpp>
+#include <can_dbc_parser/DbcMessage.hpp>
+#include <can_dbc_parser/DbcSignal.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+
+// Prints a double so it reads back as the same value and is a valid
+// floating-point literal.
+static std::string Literal(double value)
+{
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.17g", value);
+
+  std::string text(buffer);
+  if (text.find_first_of(".en") == std::string::npos) {
+    text += ".0";
+  }
+  if (value < 0) {
+    text = "(" + text + ")";
+  }
+
+  return text;
+}
+
+// Each signal is read from the 8-byte window at its plan's ByteOffset, in its
+// byte order. Classic frames only ever use the two windows at offset 0.
+typedef std::pair<uint8_t, bool> Window;
+
+static Window WindowOf(const NewEagle::DbcSignalPlan & plan)
+{
+  return Window(plan.ByteOffset, plan.BigEndian);
+}
+
+static std::string WordName(const Window & window)
+{
+  std::string name = window.second ? "be" : "le";
+
+  if (0 != window.first) {
+    name += std::to_string(window.first);
+  }
+
+  return name;
+}
+
+static std::string WordName(const NewEagle::DbcSignalPlan & plan)
+{
+  return WordName(WindowOf(plan));
+}
+
+static void WriteDecode(
+  std::ostream & out, const NewEagle::DbcSignal & signal, const std::string & indent)
+{
+  const NewEagle::DbcSignalPlan & plan = signal.GetPlan();
+
+  out << indent << "out." << signal.GetName() << " = ";
+
+  if (!plan.Valid) {
+    out << "0.0;\n";
+    return;
+  }
+
+  out << "static_cast<double>(NewEagle::codegen::Extract<" <<
+    static_cast<int>(plan.LeftShift) << ", " << static_cast<int>(plan.RightShift) << ", " <<
+    (plan.Signed ? "true" : "false") << ">(" << WordName(plan) << "))";
+
+  if (plan.Scaled) {
+    out << " * " << Literal(signal.GetGain()) << " + " << Literal(signal.GetOffset());
+  }
+
+  out << ";\n";
+}
+
+static void WriteEncode(
+  std::ostream & out, const NewEagle::DbcSignal & signal, const std::string & indent)
+{
+  const NewEagle::DbcSignalPlan & plan = signal.GetPlan();
+
+  if (!plan.Valid) {
+    return;
+  }
+
+  std::string word = WordName(plan);
+  std::string value = signal.GetName();
+
+  if (plan.Scaled) {
+    value = "(" + value + " - " + Literal(signal.GetOffset()) + ") / " +
+      Literal(signal.GetGain());
+  }
+
+  char mask[32];
+  snprintf(mask, sizeof(mask), "0x%016llXull", static_cast<unsigned long long>(plan.Mask));
+
+  out << indent << word << " = NewEagle::codegen::Insert<" <<
+    static_cast<int>(plan.Shift) << ", " << mask << ", " <<
+    (plan.Signed ? "true" : "false") << ">(" << word << ", " << value << ");\n";
+}
+
+// Runs fn over the signals stored in one window. The plain signals and the
+// multiplexer switch come first, as in SetFrame/GetFrame; the multiplexed
+// signals are emitted separately, grouped under a check of the switch value.
+template<typename Fn>
+static void ForEachSignal(
+  std::ostream & out, const NewEagle::DbcMessage & message, const Window & window,
+  bool multiplexed, const std::string & prefix, Fn fn)
+{
+  const NewEagle::DbcSignal * muxSwitch = NULL;
+  std::multimap<int32_t, const NewEagle::DbcSignal *> muxed;
+
+  for (NewEagle::SignalHandle h = 0; h < message.GetSignalCount(); h++) {
+    const NewEagle::DbcSignal * signal = message.GetSignal(h);
+
+    if (NewEagle::MUX_SWITCH == signal->GetMultiplexerMode()) {
+      muxSwitch = signal;
+    }
+    if (WindowOf(signal->GetPlan()) != window) {
+      continue;
+    }
+    if (NewEagle::MUX_SIGNAL == signal->GetMultiplexerMode()) {
+      muxed.insert(std::make_pair(signal->GetMultiplexerSwitch(), signal));
+    } else if (!multiplexed) {
+      fn(out, *signal, "    ");
+    }
+  }
+
+  if (!multiplexed || (NULL == muxSwitch)) {
+    return;
+  }
+
+  std::multimap<int32_t, const NewEagle::DbcSignal *>::iterator it = muxed.begin();
+  while (it != muxed.end()) {
+    int32_t value = it->first;
+
+    out << "    if (" << prefix << muxSwitch->GetName() << " == " << value << ") {\n";
+    for (; (it != muxed.end()) && (it->first == value); it++) {
+      fn(out, *it->second, "      ");
+    }
+    out << "    }\n";
+  }
+}
+
+// The windows signals are read from, ordered by offset, little endian first.
+// Signals without a valid plan still need a window to be listed under, but
+// never read from it.
+static std::set<Window> UsedWindows(const NewEagle::DbcMessage & message, bool validOnly)
+{
+  std::set<Window> windows;
+
+  for (NewEagle::SignalHandle h = 0; h < message.GetSignalCount(); h++) {
+    const NewEagle::DbcSignalPlan & plan = message.GetSignal(h)->GetPlan();
+
+    if (plan.Valid || !validOnly) {
+      windows.insert(WindowOf(plan));
+    }
+  }
+
+  return windows;
+}
+
+static void WriteMessage(std::ostream & out, const NewEagle::DbcMessage & message)
+{
+  const std::string name = message.GetName();
+  const std::set<Window> windows = UsedWindows(message, true);
+  const std::set<Window> listed = UsedWindows(message, false);
+  const bool classic = windows.empty() || (0 == windows.rbegin()->first);
+
+  out << "struct " << name << "\n{\n";
+  out << "  static constexpr uint32_t ID = 0x" << std::hex << std::uppercase <<
+    message.GetId() << std::dec << ";\n";
+  out << "  static constexpr bool EXTENDED = " <<
+    (NewEagle::EXT == message.GetIdType() ? "true" : "false") << ";\n";
+  out << "  static constexpr uint8_t DLC = " << static_cast<int>(message.GetDlc()) << ";\n\n";
+
+  for (NewEagle::SignalHandle h = 0; h < message.GetSignalCount(); h++) {
+    out << "  double " << message.GetSignal(h)->GetName() << ";\n";
+  }
+
+  out << "\n  static constexpr " << name << " decode(const uint8_t * data)\n  {\n";
+  out << "    " << name << " out = " << name << "();\n";
+  if (windows.empty()) {
+    out << "    (void)data;\n";
+  }
+  for (const Window & window : windows) {
+    out << "    const uint64_t " << WordName(window) <<
+      " = NewEagle::codegen::LoadWord<" << (window.second ? "true" : "false") << ">(data";
+    if (0 != window.first) {
+      out << " + " << static_cast<int>(window.first);
+    }
+    out << ");\n";
+  }
+  for (const Window & window : listed) {
+    ForEachSignal(out, message, window, false, "out.", WriteDecode);
+  }
+  for (const Window & window : listed) {
+    ForEachSignal(out, message, window, true, "out.", WriteDecode);
+  }
+  out << "    return out;\n  }\n\n";
+
+  // The frame starts zeroed, as in DbcMessage::GetFrame(). Classic frames are
+  // zeroed by the first word stored; CAN FD frames are cleared up front and
+  // every window is then merged into what is already there.
+  out << "  constexpr void encode(uint8_t * data) const\n  {\n";
+  if (!classic) {
+    out << "    for (int32_t i = 0; i < " << message.GetFrameSize() << "; i++) {\n";
+    out << "      data[i] = 0;\n    }\n";
+  }
+  for (const Window & window : windows) {
+    std::string word = WordName(window);
+    bool merge = !classic || (window != *windows.begin());
+    out << "    uint64_t " << word << " = ";
+    if (merge) {
+      out << "NewEagle::codegen::LoadWord<" << (window.second ? "true" : "false") << ">(data";
+      if (0 != window.first) {
+        out << " + " << static_cast<int>(window.first);
+      }
+      out << ");\n";
+    } else {
+      out << "0;\n";
+    }
+    ForEachSignal(out, message, window, false, "", WriteEncode);
+    ForEachSignal(out, message, window, true, "", WriteEncode);
+    out << "    NewEagle::codegen::StoreWord<" << (window.second ? "true" : "false") <<
+      ">(data";
+    if (0 != window.first) {
+      out << " + " << static_cast<int>(window.first);
+    }
+    out << ", " << word << ");\n";
+  }
+  if (windows.empty()) {
+    out << "    NewEagle::codegen::StoreWord<false>(data, 0);\n";
+  }
+  out << "  }\n};\n\n";
+}
+
+int main(int argc, char ** argv)
+{
+  if (argc != 4) {
+    std::cerr << "Usage: can_dbc_codegen <dbc file> <output header> <namespace>" << std::endl;
+    return 1;
+  }
+
+  std::string dbcFile(argv[1]);
+  std::string outputFile(argv[2]);
+  std::string ns(argv[3]);
+
+  NewEagle::Dbc dbc;
+  try {
+    dbc = NewEagle::DbcBuilder().NewDbc(dbcFile);
+  } catch (const std::exception & e) {
+    std::cerr << "can_dbc_codegen: " << dbcFile << ": " << e.what() << std::endl;
+    return 1;
+  }
+
+  std::ostringstream out;
+  std::string guard = ns;
+  for (size_t i = 0; i < guard.size(); i++) {
+    guard[i] = static_cast<char>(toupper(guard[i]));
+  }
+
+  out << "// Generated by can_dbc_codegen from " << dbcFile << ". Do not edit.\n\n";
+  out << "#ifndef CAN_DBC_GENERATED__" << guard << "_HPP_\n";
+  out << "#define CAN_DBC_GENERATED__" << guard << "_HPP_\n\n";
+  out << "#include <can_dbc_parser/DbcCodegen.hpp>\n\n";
+  out << "#include <cstdint>\n\n";
+  out << "namespace " << ns << "\n{\n";
+
+  std::map<std::string, NewEagle::DbcMessage> * messages = dbc.GetMessages();
+  for (std::map<std::string, NewEagle::DbcMessage>::iterator it = messages->begin();
+    it != messages->end(); it++)
+  {
+    WriteMessage(out, it->second);
+  }
+
+  out << "}  // namespace " << ns << "\n\n";
+  out << "#endif  // CAN_DBC_GENERATED__" << guard << "_HPP_\n";
+
+  std::ofstream file(outputFile.c_str());
+  file << out.str();
+  file.close();
+
+  if (!file) {
+    std::cerr << "can_dbc_codegen: could not write " << outputFile << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,140 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Checks the CAN ID index behind Dbc::GetMessageById: standard and extended
+// IDs that share a number, growth of the table, and copies of a Dbc.
+
+#include <gtest/gtest.h>
+
+#include <can_dbc_parser/Dbc.hpp>
+#include <can_dbc_parser/DbcMessage.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace
+{
+NewEagle::DbcMessage * AddMessage(
+  NewEagle::Dbc & dbc, const std::string & name, uint32_t id, NewEagle::IdType idType)
+{
+  uint32_t rawId = (NewEagle::EXT == idType) ? (id | 0x80000000u) : id;
+  return dbc.AddMessage(NewEagle::DbcMessage(8, id, idType, name, rawId));
+}
+
+// Every message added by AddMessages is found under its own ID and type.
+void ExpectAllFound(const NewEagle::Dbc & dbc, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; i++) {
+    const NewEagle::DbcMessage * message = dbc.GetMessageById(0x100 + i, NewEagle::STD);
+    ASSERT_NE(nullptr, message) << "STD " << i;
+    EXPECT_EQ("Std" + std::to_string(i), message->GetName());
+
+    message = dbc.GetMessageById(0x100 + i, NewEagle::EXT);
+    ASSERT_NE(nullptr, message) << "EXT " << i;
+    EXPECT_EQ("Ext" + std::to_string(i), message->GetName());
+  }
+}
+
+void AddMessages(NewEagle::Dbc & dbc, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; i++) {
+    AddMessage(dbc, "Std" + std::to_string(i), 0x100 + i, NewEagle::STD);
+    AddMessage(dbc, "Ext" + std::to_string(i), 0x100 + i, NewEagle::EXT);
+  }
+}
+}  // namespace
+
+TEST(Dbc, EmptyFindsNothing)
+{
+  NewEagle::Dbc dbc;
+
+  EXPECT_EQ(nullptr, dbc.GetMessageById(0x100));
+  EXPECT_EQ(nullptr, dbc.GetMessageById(0x100, NewEagle::EXT));
+}
+
+TEST(Dbc, StandardAndExtendedShareAnId)
+{
+  NewEagle::Dbc dbc;
+  NewEagle::DbcMessage * extended = AddMessage(dbc, "Ext", 0x123, NewEagle::EXT);
+
+  // Only the extended message so far: the untyped lookup falls back to it.
+  EXPECT_EQ(extended, dbc.GetMessageById(0x123));
+  EXPECT_EQ(nullptr, dbc.GetMessageById(0x123, NewEagle::STD));
+
+  NewEagle::DbcMessage * standard = AddMessage(dbc, "Std", 0x123, NewEagle::STD);
+
+  EXPECT_EQ(standard, dbc.GetMessageById(0x123, NewEagle::STD));
+  EXPECT_EQ(extended, dbc.GetMessageById(0x123, NewEagle::EXT));
+  EXPECT_EQ(standard, dbc.GetMessageById(0x123));
+
+  // Bit 31 tags extended keys; it is not part of the ID itself.
+  EXPECT_EQ(nullptr, dbc.GetMessageById(0x80000123u, NewEagle::STD));
+  EXPECT_EQ(nullptr, dbc.GetMessageById(0x124));
+}
+
+TEST(Dbc, IndexGrowsPastHalfFull)
+{
+  NewEagle::Dbc dbc;
+
+  // The table starts at 16 slots and is rebuilt whenever it would be more
+  // than half full; check every entry after each step across several rebuilds.
+  for (uint32_t count = 1; count <= 100; count++) {
+    AddMessage(dbc, "Std" + std::to_string(count - 1), 0x100 + count - 1, NewEagle::STD);
+    AddMessage(dbc, "Ext" + std::to_string(count - 1), 0x100 + count - 1, NewEagle::EXT);
+    ASSERT_EQ(count * 2, dbc.GetMessageCount());
+    ExpectAllFound(dbc, count);
+  }
+
+  EXPECT_EQ(nullptr, dbc.GetMessageById(0x100 + 100, NewEagle::STD));
+  EXPECT_EQ(nullptr, dbc.GetMessageById(0x100 + 100, NewEagle::EXT));
+}
+
+TEST(Dbc, CopiesIndexTheirOwnMessages)
+{
+  const uint32_t count = 40;
+  NewEagle::Dbc copy;
+
+  {
+    NewEagle::Dbc original;
+    AddMessages(original, count);
+
+    NewEagle::Dbc constructed(original);
+    ExpectAllFound(constructed, count);
+    EXPECT_NE(original.GetMessageById(0x100), constructed.GetMessageById(0x100));
+
+    // Assigning over a Dbc with an index of its own replaces it.
+    AddMessage(copy, "Other", 0x7FF, NewEagle::STD);
+    copy = original;
+  }
+
+  // The original is gone, so any entry still pointing into it would fail here.
+  ExpectAllFound(copy, count);
+  EXPECT_EQ(nullptr, copy.GetMessageById(0x7FF));
+  EXPECT_EQ(copy.GetMessage("Std0"), copy.GetMessageById(0x100));
+  EXPECT_EQ(copy.GetMessage("Ext0"), copy.GetMessageById(0x100, NewEagle::EXT));
+}
@@ -0,0 +1,172 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Counts heap allocations while loading DBCs, through a replacement operator
+// new. The per-frame paths are covered by raptor_dbw_can's allocation test.
+
+#include <gtest/gtest.h>
+
+#include <can_dbc_parser/DbcBuilder.hpp>
+#include <can_dbc_parser/DbcMessage.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+
+#ifndef CAN_DBC_PARSER_TEST_DBC
+#define CAN_DBC_PARSER_TEST_DBC ""
+#endif
+
+namespace
+{
+std::atomic<size_t> allocations{0};
+}  // namespace
+
+void * operator new(size_t size)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  void * p = std::malloc(size ? size : 1);
+  if (nullptr == p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void * p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void * p, size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace
+{
+// Upper bounds on allocations per message plus signal for a load of a DBC
+// whose names are already interned, i.e. any load after the first.
+const double MAX_ALLOCATIONS_PER_ENTRY = 2.0;          // BO_ and SG_ lines only, ~1.5
+const double MAX_ALLOCATIONS_PER_ENTRY_SHIPPED = 3.5;  // with CM_ and BA_ lines, ~3.2
+
+// DbcBuilder reports the size of every DBC it loads on stdout.
+class QuietStdout
+{
+public:
+  QuietStdout()
+  : _saved(std::cout.rdbuf(nullptr))
+  {
+  }
+
+  ~QuietStdout()
+  {
+    std::cout.rdbuf(_saved);
+  }
+
+private:
+  std::streambuf * _saved;
+};
+
+std::string WriteDbc(const std::string & text)
+{
+  std::string path =
+    (std::filesystem::temp_directory_path() / "test_dbc_allocations.dbc").string();
+  std::ofstream(path, std::ios::binary) << text;
+  return path;
+}
+
+// Messages of eight 8-bit signals each, alternating byte order and sign.
+std::string SyntheticDbcText(size_t messageCount)
+{
+  std::string text = "VERSION \"\"\n\nBS_:\n\nBU_: Node\n\n";
+  char line[128];
+
+  for (size_t m = 0; m < messageCount; m++) {
+    snprintf(line, sizeof(line), "BO_ %zu Message%zu: 8 Node\n", 0x100 + m, m);
+    text += line;
+
+    for (size_t s = 0; s < 8; s++) {
+      bool intel = (0 == (s & 1));
+      snprintf(
+        line, sizeof(line), " SG_ Signal%zu : %zu|8@%c%c (0.5,-10) [0|0] \"unit\" Node\n",
+        s, intel ? s * 8 : s * 8 + 7, intel ? '1' : '0', (s & 2) ? '-' : '+');
+      text += line;
+    }
+
+    text += "\n";
+  }
+
+  return text;
+}
+
+size_t EntryCount(NewEagle::Dbc & dbc)
+{
+  size_t count = 0;
+  for (auto & message : *dbc.GetMessages()) {
+    count += 1 + message.second.GetSignalCount();
+  }
+  return count;
+}
+
+// Allocations per message plus signal on a second load of file.
+double AllocationsPerEntry(const std::string & file)
+{
+  QuietStdout quiet;
+  NewEagle::Dbc first = NewEagle::DbcBuilder().NewDbc(file);
+
+  size_t before = allocations.load();
+  NewEagle::Dbc second = NewEagle::DbcBuilder().NewDbc(file);
+  size_t used = allocations.load() - before;
+
+  return static_cast<double>(used) / static_cast<double>(EntryCount(second));
+}
+}  // namespace
+
+TEST(DbcAllocations, LoadPerMessageAndSignal)
+{
+  std::string file = WriteDbc(SyntheticDbcText(200));
+  double perEntry = AllocationsPerEntry(file);
+  std::remove(file.c_str());
+
+  EXPECT_LE(perEntry, MAX_ALLOCATIONS_PER_ENTRY);
+}
+
+TEST(DbcAllocations, LoadShippedPerMessageAndSignal)
+{
+  std::string file = CAN_DBC_PARSER_TEST_DBC;
+  if (file.empty() || !std::filesystem::exists(file)) {
+    GTEST_SKIP() << "DBC file not found: " << file;
+  }
+
+  EXPECT_LE(AllocationsPerEntry(file), MAX_ALLOCATIONS_PER_ENTRY_SHIPPED);
+}
@@ -0,0 +1,216 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Runs DbcMessage::DecodeBatch with each column kernel the CPU supports and
+// checks every value against UnpackRaw/ToPhysical: random signals of 1 to 64
+// bits anywhere in a CAN FD payload, and a multiplexed message.
+
+#include <gtest/gtest.h>
+
+#include <can_dbc_parser/DbcMessage.hpp>
+#include <can_dbc_parser/DbcSignal.hpp>
+#include <can_dbc_parser/DbcUtilities.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+// More than one block of frames, and not a multiple of any kernel's width.
+const size_t FRAME_COUNT = 517;
+
+// Frames are laid out with a gap after each one.
+const size_t STRIDE = NewEagle::MAX_FRAME_BYTES + 5;
+
+// Left in column entries DecodeBatch must not write.
+const double UNTOUCHED = -12345.0;
+
+class Random
+{
+public:
+  explicit Random(uint64_t seed)
+  : _state(seed)
+  {
+  }
+
+  uint64_t Next()
+  {
+    _state ^= _state << 13;
+    _state ^= _state >> 7;
+    _state ^= _state << 17;
+    return _state;
+  }
+
+private:
+  uint64_t _state;
+};
+
+NewEagle::DbcSignal RandomSignal(
+  Random & random, uint8_t dlc, uint16_t lastStartBit, const std::string & name,
+  NewEagle::MultiplexerMode mode = NewEagle::NONE, int32_t group = 0)
+{
+  uint8_t length = 1 + random.Next() % 64;
+  uint16_t startBit = random.Next() % (lastStartBit + 1);
+  NewEagle::ByteOrder order = random.Next() % 2 ? NewEagle::BIG_END : NewEagle::LITTLE_END;
+  NewEagle::SignType sign = random.Next() % 2 ? NewEagle::SIGNED : NewEagle::UNSIGNED;
+  bool scaled = random.Next() % 2;
+  double gain = scaled ? 0.125 * (1 + random.Next() % 16) : 1.0;
+  double offset = scaled ? static_cast<double>(random.Next() % 200) - 100.0 : 0.0;
+
+  return NewEagle::DbcSignal(
+    dlc, gain, offset, startBit, order, length, sign, name, mode, group);
+}
+
+std::vector<uint8_t> RandomPayloads(Random & random)
+{
+  std::vector<uint8_t> payloads(FRAME_COUNT * STRIDE);
+
+  for (size_t i = 0; i < payloads.size(); i++) {
+    payloads[i] = static_cast<uint8_t>(random.Next());
+  }
+
+  return payloads;
+}
+
+// Decodes payloads with DecodeBatch into columns prefilled with UNTOUCHED.
+std::vector<std::vector<double>> DecodeColumns(
+  const NewEagle::DbcMessage & message, const std::vector<uint8_t> & payloads)
+{
+  std::vector<std::vector<double>> columns(
+    message.GetSignalCount(), std::vector<double>(FRAME_COUNT, UNTOUCHED));
+  std::vector<double *> pointers;
+
+  for (size_t h = 0; h < columns.size(); h++) {
+    pointers.push_back(columns[h].data());
+  }
+
+  message.DecodeBatch(payloads.data(), STRIDE, FRAME_COUNT, pointers.data());
+  return columns;
+}
+
+double Expected(const uint8_t * payload, const NewEagle::DbcSignal & signal)
+{
+  return NewEagle::ToPhysical(
+    NewEagle::UnpackRaw(payload, signal), signal.GetPlan(), signal.GetGain(),
+    signal.GetOffset());
+}
+
+class DecodeBatchKernel : public ::testing::TestWithParam<NewEagle::DecodeBatchKernel>
+{
+protected:
+  void SetUp() override
+  {
+    if (!NewEagle::SetDecodeBatchKernel(GetParam())) {
+      GTEST_SKIP() << "kernel not supported here";
+    }
+  }
+};
+}  // namespace
+
+TEST_P(DecodeBatchKernel, MatchesUnpackRaw)
+{
+  Random random(0x5EED + GetParam());
+  NewEagle::DbcMessage message(64, 0x300, NewEagle::STD, "Wide", 0x300);
+
+  // Start bits run past the end of the payload too, so some signals span more
+  // than 8 bytes or fall outside the frame and have to decode as 0.0.
+  for (int i = 0; i < 400; i++) {
+    std::string name = "Signal" + std::to_string(i);
+    message.AddSignal(name, RandomSignal(random, 64, 64 * 8 + 15, name));
+  }
+
+  size_t offsets = 0;
+  size_t wide = 0;
+  size_t invalid = 0;
+  for (NewEagle::SignalHandle h = 0; h < message.GetSignalCount(); h++) {
+    const NewEagle::DbcSignalPlan & plan = message.GetSignal(h)->GetPlan();
+    offsets += plan.Valid && plan.ByteOffset > 0;
+    wide += plan.Valid && message.GetSignal(h)->GetLength() > 32;
+    invalid += !plan.Valid;
+  }
+  ASSERT_GT(offsets, 50u);
+  ASSERT_GT(wide, 50u);
+  ASSERT_GT(invalid, 5u);
+
+  std::vector<uint8_t> payloads = RandomPayloads(random);
+  std::vector<std::vector<double>> columns = DecodeColumns(message, payloads);
+
+  for (NewEagle::SignalHandle h = 0; h < columns.size(); h++) {
+    const NewEagle::DbcSignal & signal = *message.GetSignal(h);
+
+    for (size_t k = 0; k < FRAME_COUNT; k++) {
+      ASSERT_EQ(Expected(&payloads[k * STRIDE], signal), columns[h][k]) <<
+        signal.GetName() << " start " << signal.GetStartBit() << " length " <<
+        static_cast<int>(signal.GetLength()) << " frame " << k;
+    }
+  }
+}
+
+TEST_P(DecodeBatchKernel, DecodesSelectedMuxGroups)
+{
+  Random random(0xB00 + GetParam());
+  NewEagle::DbcMessage message(16, 0x301, NewEagle::STD, "Mux", 0x301);
+
+  // The switch is the first byte: raw 0 to 3 selects group 1, 2 or none.
+  message.AddSignal(
+    "Mode",
+    NewEagle::DbcSignal(
+      16, 1.0, 0.0, 0, NewEagle::LITTLE_END, 8, NewEagle::UNSIGNED, "Mode",
+      NewEagle::MUX_SWITCH));
+  for (int i = 0; i < 30; i++) {
+    std::string name = "Signal" + std::to_string(i);
+    NewEagle::MultiplexerMode mode = i < 10 ? NewEagle::NONE : NewEagle::MUX_SIGNAL;
+    message.AddSignal(name, RandomSignal(random, 16, 16 * 8 - 1, name, mode, 1 + i % 2));
+  }
+
+  std::vector<uint8_t> payloads = RandomPayloads(random);
+  for (size_t k = 0; k < FRAME_COUNT; k++) {
+    payloads[k * STRIDE] = static_cast<uint8_t>(random.Next() % 4);
+  }
+
+  std::vector<std::vector<double>> columns = DecodeColumns(message, payloads);
+
+  for (NewEagle::SignalHandle h = 0; h < columns.size(); h++) {
+    const NewEagle::DbcSignal & signal = *message.GetSignal(h);
+
+    for (size_t k = 0; k < FRAME_COUNT; k++) {
+      const uint8_t * payload = &payloads[k * STRIDE];
+      bool selected = NewEagle::MUX_SIGNAL != signal.GetMultiplexerMode() ||
+        payload[0] == signal.GetMultiplexerSwitch();
+      double expected = selected ? Expected(payload, signal) : UNTOUCHED;
+
+      ASSERT_EQ(expected, columns[h][k]) << signal.GetName() << " frame " << k;
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  Kernels, DecodeBatchKernel,
+  ::testing::Values(
+    NewEagle::BATCH_KERNEL_SCALAR, NewEagle::BATCH_KERNEL_SSE2, NewEagle::BATCH_KERNEL_AVX2));
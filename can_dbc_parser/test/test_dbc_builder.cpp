@@ -0,0 +1,171 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <can_dbc_parser/DbcBuilder.hpp>
+#include <can_dbc_parser/DbcMessage.hpp>
+#include <can_dbc_parser/DbcStrings.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+// Two messages with a checksum and a counter signal each. Protected declares
+// CRC8 and a counter; Unprotected declares both off. Neither is
+// declared for Undeclared.
+const char * const PROTECTION_DBC =
+  "BO_ 256 Protected: 8 Node\n"
+  " SG_ Value : 0|8@1+ (1,0) [0|0] \"\" Node\n"
+  " SG_ Counter : 48|4@1+ (1,0) [0|0] \"\" Node\n"
+  " SG_ Checksum : 56|8@1+ (1,0) [0|0] \"\" Node\n"
+  "\n"
+  "BO_ 257 Unprotected: 8 Node\n"
+  " SG_ Value : 0|8@1+ (1,0) [0|0] \"\" Node\n"
+  " SG_ Counter : 48|4@1+ (1,0) [0|0] \"\" Node\n"
+  " SG_ Checksum : 56|8@1+ (1,0) [0|0] \"\" Node\n"
+  "\n"
+  "BO_ 258 Undeclared: 8 Node\n"
+  " SG_ Value : 0|8@1+ (1,0) [0|0] \"\" Node\n"
+  " SG_ Counter : 48|4@1+ (1,0) [0|0] \"\" Node\n"
+  " SG_ Checksum : 56|8@1+ (1,0) [0|0] \"\" Node\n"
+  "\n"
+  "BA_DEF_ SG_  \"GenSigChecksumType\" STRING ;\n"
+  "BA_DEF_ SG_  \"GenSigRollingCounter\" INT 0 1;\n"
+  "BA_DEF_DEF_  \"GenSigChecksumType\" \"NONE\";\n"
+  "BA_DEF_DEF_  \"GenSigRollingCounter\" 0;\n"
+  "BA_ \"GenSigChecksumType\" SG_ 256 Checksum \"CRC8_SAE_J1850\";\n"
+  "BA_ \"GenSigChecksumType\" SG_ 256 Value \"NONE\";\n"
+  "BA_ \"GenSigRollingCounter\" SG_ 256 Counter 1;\n"
+  "BA_ \"GenSigRollingCounter\" SG_ 256 Value 0;\n"
+  "BA_ \"GenSigChecksumType\" SG_ 257 Checksum \"NONE\";\n"
+  "BA_ \"GenSigRollingCounter\" SG_ 257 Counter 0;\n";
+
+class DbcFile
+{
+public:
+  explicit DbcFile(const std::string & text)
+  : _path((std::filesystem::temp_directory_path() / "test_dbc_builder.dbc").string()),
+    _cache(_path + ".cache")
+  {
+    std::ofstream(_path, std::ios::binary) << text;
+    std::remove(_cache.c_str());
+  }
+
+  ~DbcFile()
+  {
+    std::remove(_path.c_str());
+    std::remove(_cache.c_str());
+  }
+
+  const std::string & Path() const
+  {
+    return _path;
+  }
+
+  const std::string & Cache() const
+  {
+    return _cache;
+  }
+
+private:
+  std::string _path;
+  std::string _cache;
+};
+
+void ExpectProtection(NewEagle::Dbc & dbc)
+{
+  NewEagle::DbcMessage * all = dbc.GetMessageById(256);
+  ASSERT_NE(nullptr, all);
+  EXPECT_TRUE(all->IsChecksumDeclared());
+  EXPECT_TRUE(all->IsRollingCounterDeclared());
+  EXPECT_EQ(NewEagle::CHECKSUM_CRC8_SAE_J1850, all->GetChecksumType());
+  EXPECT_EQ(all->GetSignalHandle("Checksum"), all->GetChecksumSignal());
+  EXPECT_EQ(all->GetSignalHandle("Counter"), all->GetRollingCounterSignal());
+
+  NewEagle::DbcMessage * none = dbc.GetMessageById(257);
+  ASSERT_NE(nullptr, none);
+  EXPECT_TRUE(none->IsChecksumDeclared());
+  EXPECT_TRUE(none->IsRollingCounterDeclared());
+  EXPECT_EQ(NewEagle::CHECKSUM_NONE, none->GetChecksumType());
+  EXPECT_EQ(NewEagle::NO_SIGNAL, none->GetRollingCounterSignal());
+
+  NewEagle::DbcMessage * missing = dbc.GetMessageById(258);
+  ASSERT_NE(nullptr, missing);
+  EXPECT_FALSE(missing->IsChecksumDeclared());
+  EXPECT_FALSE(missing->IsRollingCounterDeclared());
+  EXPECT_EQ(NewEagle::CHECKSUM_NONE, missing->GetChecksumType());
+  EXPECT_EQ(NewEagle::NO_SIGNAL, missing->GetRollingCounterSignal());
+}
+}  // namespace
+
+TEST(DbcBuilder, ExplicitNoneIsDeclared)
+{
+  DbcFile file(PROTECTION_DBC);
+  NewEagle::Dbc dbc = NewEagle::DbcBuilder().NewDbc(file.Path());
+
+  ExpectProtection(dbc);
+}
+
+TEST(DbcBuilder, CacheKeepsDeclaredProtection)
+{
+  DbcFile file(PROTECTION_DBC);
+  NewEagle::DbcBuilder().NewDbc(file.Path(), file.Cache());
+  ASSERT_TRUE(std::filesystem::exists(file.Cache()));
+
+  NewEagle::Dbc dbc = NewEagle::DbcBuilder().NewDbc(file.Path(), file.Cache());
+
+  ExpectProtection(dbc);
+}
+
+TEST(DbcStrings, ReloadingAddsNoStrings)
+{
+  DbcFile file(PROTECTION_DBC);
+
+  // Nothing else in this process holds signals at this point.
+  NewEagle::ClearInternedStrings();
+  EXPECT_EQ(0u, NewEagle::InternedStringCount());
+
+  size_t loaded = 0;
+  for (int i = 0; i < 10; i++) {
+    NewEagle::Dbc dbc = NewEagle::DbcBuilder().NewDbc(file.Path());
+    if (0 == i) {
+      loaded = NewEagle::InternedStringCount();
+    }
+  }
+
+  // Value, Counter and Checksum, shared by all three messages.
+  EXPECT_EQ(3u, loaded);
+  EXPECT_EQ(loaded, NewEagle::InternedStringCount());
+
+  NewEagle::ClearInternedStrings();
+  EXPECT_EQ(0u, NewEagle::InternedStringCount());
+}
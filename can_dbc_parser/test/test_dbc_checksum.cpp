@@ -0,0 +1,192 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+
+// Checks the frame checksums against their published check values, and that
+// GetFrame leaves the checksum byte out of the sum and wraps the rolling
+// counter at its signal width.
+
+#include <gtest/gtest.h>
+
+#include <can_dbc_parser/DbcChecksum.hpp>
+#include <can_dbc_parser/DbcMessage.hpp>
+#include <can_dbc_parser/DbcSignal.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace
+{
+const uint8_t CHECK_INPUT[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+const NewEagle::ChecksumType CHECKSUM_TYPES[] = {
+  NewEagle::CHECKSUM_CRC8_SAE_J1850,
+  NewEagle::CHECKSUM_XOR,
+  NewEagle::CHECKSUM_ADD
+};
+
+// Value bytes around a checksum at checksumByte, and a 4-bit counter in the
+// high nibble of the byte before the checksum (or after it, for byte 0).
+NewEagle::DbcMessage MakeProtectedMessage(uint8_t checksumByte, NewEagle::ChecksumType type)
+{
+  NewEagle::DbcMessage message(8, 0x300, NewEagle::STD, "Protected", 0x300);
+  uint8_t counterByte = checksumByte > 0 ? checksumByte - 1 : 1;
+
+  for (uint8_t i = 0; i < 8; i++) {
+    if ((i == checksumByte) || (i == counterByte)) {
+      continue;
+    }
+    std::string name = "Value" + std::to_string(i);
+    message.AddSignal(
+      name,
+      NewEagle::DbcSignal(
+        8, 1.0, 0.0, i * 8, NewEagle::LITTLE_END, 8, NewEagle::UNSIGNED, name,
+        NewEagle::NONE));
+  }
+
+  message.AddSignal(
+    "Counter",
+    NewEagle::DbcSignal(
+      8, 1.0, 0.0, counterByte * 8 + 4, NewEagle::LITTLE_END, 4, NewEagle::UNSIGNED, "Counter",
+      NewEagle::NONE));
+  message.AddSignal(
+    "Checksum",
+    NewEagle::DbcSignal(
+      8, 1.0, 0.0, checksumByte * 8, NewEagle::LITTLE_END, 8, NewEagle::UNSIGNED, "Checksum",
+      NewEagle::NONE));
+  message.SetRollingCounter(message.GetSignalHandle("Counter"));
+  message.SetChecksum(message.GetSignalHandle("Checksum"), type);
+
+  return message;
+}
+
+// The checksum over every byte of the frame except checksumByte.
+uint8_t ExpectedChecksum(
+  NewEagle::ChecksumType type, const Frame & frame, uint8_t checksumByte)
+{
+  uint8_t covered[7];
+  uint8_t length = 0;
+
+  for (uint8_t i = 0; i < 8; i++) {
+    if (i != checksumByte) {
+      covered[length++] = frame.data[i];
+    }
+  }
+
+  return NewEagle::ComputeChecksum(type, covered, length);
+}
+}  // namespace
+
+TEST(DbcChecksum, Crc8SaeJ1850CheckValue)
+{
+  EXPECT_EQ(
+    0x4B,
+    NewEagle::ComputeChecksum(
+      NewEagle::CHECKSUM_CRC8_SAE_J1850, CHECK_INPUT, sizeof(CHECK_INPUT)));
+
+  // The initial value and final XOR cancel out on an empty payload.
+  EXPECT_EQ(0x00, NewEagle::ComputeChecksum(NewEagle::CHECKSUM_CRC8_SAE_J1850, CHECK_INPUT, 0));
+}
+
+TEST(DbcChecksum, XorAndAddSums)
+{
+  const uint8_t bytes[] = {0x01, 0x02, 0x04, 0x80, 0xFF};
+
+  EXPECT_EQ(0x31, NewEagle::ComputeChecksum(NewEagle::CHECKSUM_XOR, CHECK_INPUT, 9));
+  EXPECT_EQ(0x78, NewEagle::ComputeChecksum(NewEagle::CHECKSUM_XOR, bytes, sizeof(bytes)));
+
+  // 477 and 390, modulo 256.
+  EXPECT_EQ(0xDD, NewEagle::ComputeChecksum(NewEagle::CHECKSUM_ADD, CHECK_INPUT, 9));
+  EXPECT_EQ(0x86, NewEagle::ComputeChecksum(NewEagle::CHECKSUM_ADD, bytes, sizeof(bytes)));
+
+  EXPECT_EQ(0x00, NewEagle::ComputeChecksum(NewEagle::CHECKSUM_NONE, bytes, sizeof(bytes)));
+  EXPECT_EQ(
+    0x00,
+    NewEagle::ComputeChecksum(static_cast<NewEagle::ChecksumType>(99), bytes, sizeof(bytes)));
+}
+
+TEST(DbcChecksum, ParseChecksumType)
+{
+  NewEagle::ChecksumType type = NewEagle::CHECKSUM_NONE;
+
+  EXPECT_TRUE(NewEagle::ParseChecksumType("CRC8_SAE_J1850", type));
+  EXPECT_EQ(NewEagle::CHECKSUM_CRC8_SAE_J1850, type);
+  EXPECT_TRUE(NewEagle::ParseChecksumType("XOR", type));
+  EXPECT_EQ(NewEagle::CHECKSUM_XOR, type);
+  EXPECT_TRUE(NewEagle::ParseChecksumType("ADD", type));
+  EXPECT_EQ(NewEagle::CHECKSUM_ADD, type);
+  EXPECT_TRUE(NewEagle::ParseChecksumType("NONE", type));
+  EXPECT_EQ(NewEagle::CHECKSUM_NONE, type);
+
+  type = NewEagle::CHECKSUM_XOR;
+  EXPECT_FALSE(NewEagle::ParseChecksumType("CRC8", type));
+  EXPECT_FALSE(NewEagle::ParseChecksumType("crc8_sae_j1850", type));
+  EXPECT_EQ(NewEagle::CHECKSUM_XOR, type);
+}
+
+TEST(DbcChecksum, ChecksumByteIsExcluded)
+{
+  for (NewEagle::ChecksumType type : CHECKSUM_TYPES) {
+    for (uint8_t checksumByte = 0; checksumByte < 8; checksumByte++) {
+      SCOPED_TRACE(testing::Message() << "type " << type << ", byte " << int(checksumByte));
+
+      NewEagle::DbcMessage message = MakeProtectedMessage(checksumByte, type);
+      NewEagle::SignalHandle checksum = message.GetSignalHandle("Checksum");
+
+      for (uint8_t i = 0; i < 8; i++) {
+        NewEagle::DbcSignal * value = message.GetSignal("Value" + std::to_string(i));
+        if (value != NULL) {
+          value->SetResult(0x11 * (i + 1));
+        }
+      }
+
+      // Whatever was set on the checksum signal is replaced, not summed.
+      for (uint8_t stale : {0x00, 0x5A, 0xFF}) {
+        message.GetSignal(checksum)->SetResult(stale);
+        Frame frame = message.GetFrame();
+
+        EXPECT_EQ(ExpectedChecksum(type, frame, checksumByte), frame.data[checksumByte]);
+      }
+    }
+  }
+}
+
+TEST(DbcChecksum, CounterWrapsInGetFrame)
+{
+  NewEagle::DbcMessage message = MakeProtectedMessage(7, NewEagle::CHECKSUM_CRC8_SAE_J1850);
+  NewEagle::DbcSignal * counter = message.GetSignal("Counter");
+
+  for (uint32_t i = 0; i < 40; i++) {
+    // The message's own counter wins over a value set on the signal.
+    counter->SetResult(9);
+    Frame frame = message.GetFrame();
+
+    EXPECT_EQ(i % 16, static_cast<uint32_t>(frame.data[6] >> 4)) << "frame " << i;
+    EXPECT_EQ(
+      ExpectedChecksum(NewEagle::CHECKSUM_CRC8_SAE_J1850, frame, 7), frame.data[7]) <<
+      "frame " << i;
+  }
+}
@@ -0,0 +1,185 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Checks the decoders can_dbc_generate() builds from test/codegen_test.dbc
+// against DbcMessage::Decode/Encode on random payloads: a classic message,
+// a multiplexed one with a scaled switch, a CAN FD one and an extended ID.
+
+#include <gtest/gtest.h>
+
+#include <can_dbc_parser/Dbc.hpp>
+#include <can_dbc_parser/DbcBuilder.hpp>
+#include <can_dbc_parser/DbcMessage.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <can_dbc_generated/codegen_test.hpp>
+
+namespace
+{
+const size_t FRAME_COUNT = 500;
+
+class Random
+{
+public:
+  explicit Random(uint64_t seed)
+  : _state(seed)
+  {
+  }
+
+  uint64_t Next()
+  {
+    _state ^= _state << 13;
+    _state ^= _state >> 7;
+    _state ^= _state << 17;
+    return _state;
+  }
+
+private:
+  uint64_t _state;
+};
+
+NewEagle::Dbc LoadDbc()
+{
+  std::streambuf * saved = std::cout.rdbuf(nullptr);
+  NewEagle::Dbc dbc = NewEagle::DbcBuilder().NewDbc(CAN_DBC_PARSER_CODEGEN_DBC);
+  std::cout.rdbuf(saved);
+
+  return dbc;
+}
+
+template<typename Generated>
+using Fields = std::vector<std::pair<const char *, double Generated::*>>;
+
+// Decodes random payloads both ways and compares every field, then encodes
+// the decoded values both ways and compares the payloads. The first payload
+// byte is limited to 0-15 so that a switch in its low nibble hits every group.
+template<typename Generated>
+void ExpectSameAsDbcMessage(
+  const NewEagle::DbcMessage & message, const Fields<Generated> & fields)
+{
+  ASSERT_EQ(message.GetSignalCount(), fields.size());
+  EXPECT_EQ(message.GetId(), Generated::ID);
+  EXPECT_EQ(NewEagle::EXT == message.GetIdType(), Generated::EXTENDED);
+  EXPECT_EQ(message.GetDlc(), Generated::DLC);
+
+  size_t size = message.GetFrameSize();
+  Random random(message.GetId());
+
+  for (size_t i = 0; i < FRAME_COUNT; i++) {
+    uint8_t payload[NewEagle::MAX_FRAME_BYTES];
+    for (size_t b = 0; b < size; b++) {
+      payload[b] = static_cast<uint8_t>(random.Next());
+    }
+    payload[0] &= 0x0F;
+
+    // The generated decode zeroes the signals the switch does not select;
+    // Decode leaves them as they were.
+    std::vector<double> values(message.GetSignalCount(), 0.0);
+    message.Decode(payload, values.data());
+    Generated decoded = Generated::decode(payload);
+
+    for (const std::pair<const char *, double Generated::*> & field : fields) {
+      ASSERT_EQ(values[message.GetSignalHandle(field.first)], decoded.*field.second) <<
+        message.GetName() << "." << field.first << " frame " << i;
+    }
+
+    uint8_t expected[NewEagle::MAX_FRAME_BYTES];
+    uint8_t encoded[NewEagle::MAX_FRAME_BYTES];
+    memset(encoded, 0xAA, sizeof(encoded));
+    message.Encode(values.data(), expected, size);
+    decoded.encode(encoded);
+
+    ASSERT_EQ(0, memcmp(expected, encoded, size)) << message.GetName() << " frame " << i;
+  }
+}
+}  // namespace
+
+TEST(DbcCodegen, Classic)
+{
+  NewEagle::Dbc dbc = LoadDbc();
+  ASSERT_NE(nullptr, dbc.GetMessage("Classic"));
+
+  ExpectSameAsDbcMessage<codegen_test::Classic>(
+    *dbc.GetMessage("Classic"), {
+      {"Speed", &codegen_test::Classic::Speed},
+      {"Torque", &codegen_test::Classic::Torque},
+      {"Flag", &codegen_test::Classic::Flag},
+      {"Position", &codegen_test::Classic::Position}});
+}
+
+TEST(DbcCodegen, Multiplexed)
+{
+  NewEagle::Dbc dbc = LoadDbc();
+  ASSERT_NE(nullptr, dbc.GetMessage("Muxed"));
+
+  ExpectSameAsDbcMessage<codegen_test::Muxed>(
+    *dbc.GetMessage("Muxed"), {
+      {"Mode", &codegen_test::Muxed::Mode},
+      {"Count", &codegen_test::Muxed::Count},
+      {"Angle", &codegen_test::Muxed::Angle},
+      {"Status", &codegen_test::Muxed::Status},
+      {"Distance", &codegen_test::Muxed::Distance}});
+}
+
+TEST(DbcCodegen, CanFd)
+{
+  NewEagle::Dbc dbc = LoadDbc();
+  ASSERT_NE(nullptr, dbc.GetMessage("Wide"));
+
+  ExpectSameAsDbcMessage<codegen_test::Wide>(
+    *dbc.GetMessage("Wide"), {
+      {"First", &codegen_test::Wide::First},
+      {"Middle", &codegen_test::Wide::Middle},
+      {"Long", &codegen_test::Wide::Long},
+      {"Late", &codegen_test::Wide::Late}});
+}
+
+TEST(DbcCodegen, Extended)
+{
+  NewEagle::Dbc dbc = LoadDbc();
+  ASSERT_NE(nullptr, dbc.GetMessage("Extended"));
+
+  ExpectSameAsDbcMessage<codegen_test::Extended>(
+    *dbc.GetMessage("Extended"), {
+      {"Level", &codegen_test::Extended::Level}});
+}
+
+TEST(DbcCodegen, DecodesAtCompileTime)
+{
+  constexpr uint8_t payload[8] = {0x03, 0x34, 0x12, 0x07, 0, 0, 0, 0};
+  constexpr codegen_test::Muxed muxed = codegen_test::Muxed::decode(payload);
+
+  static_assert(muxed.Mode == 7.0, "raw 3 scales to 7");
+  static_assert(muxed.Angle == 0.0, "group 3 is not selected");
+  EXPECT_EQ(0.0, muxed.Count);
+}
@@ -0,0 +1,666 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Checks DbcMessage's stateless Decode/Encode against the stateful
+// SetFrame/GetFrame path on random payloads, multiplexed and CAN FD messages
+// included, which multiplexed signals each switch value selects, and that
+// lazy decoding ends up with the values SetFrame would have stored.
+
+#include <gtest/gtest.h>
+
+#include <can_dbc_parser/DbcMessage.hpp>
+#include <can_dbc_parser/DbcSignal.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace NewEagle
+{
+class DbcMessageTestAccess
+{
+public:
+  static void SetLazyGeneration(DbcMessage & message, uint32_t generation)
+  {
+    message._lazyFrame.Generation = generation;
+  }
+};
+}  // namespace NewEagle
+
+namespace
+{
+const size_t FRAME_COUNT = 500;
+
+class Random
+{
+public:
+  explicit Random(uint64_t seed)
+  : _state(seed)
+  {
+  }
+
+  uint64_t Next()
+  {
+    _state ^= _state << 13;
+    _state ^= _state >> 7;
+    _state ^= _state << 17;
+    return _state;
+  }
+
+  void Fill(uint8_t * data, size_t length)
+  {
+    for (size_t i = 0; i < length; i++) {
+      data[i] = static_cast<uint8_t>(Next());
+    }
+  }
+
+private:
+  uint64_t _state;
+};
+
+// Plain signals of both byte orders and signs, a 4-bit switch (Mode) scaled
+// by 2 with offset 1, and two groups selected by the physical switch values 3
+// and 5, i.e. raw 1 and 2. Byte offset moves everything but the switch that
+// many bytes into the payload, for CAN FD messages.
+NewEagle::DbcMessage MakeMuxMessage(uint8_t dlc = 8, uint16_t byteOffset = 0)
+{
+  uint16_t bit = byteOffset * 8;
+  NewEagle::DbcMessage message(dlc, 0x200, NewEagle::STD, "Mux", 0x200);
+
+  message.AddSignal(
+    "Speed",
+    NewEagle::DbcSignal(
+      dlc, 0.5, 0.0, bit, NewEagle::LITTLE_END, 12, NewEagle::UNSIGNED, "Speed",
+      NewEagle::NONE));
+  message.AddSignal(
+    "Torque",
+    NewEagle::DbcSignal(
+      dlc, 1.0, -5.0, bit + 23, NewEagle::BIG_END, 10, NewEagle::SIGNED, "Torque",
+      NewEagle::NONE));
+  message.AddSignal(
+    "Mode",
+    NewEagle::DbcSignal(
+      dlc, 2.0, 1.0, 32, NewEagle::LITTLE_END, 4, NewEagle::UNSIGNED, "Mode",
+      NewEagle::MUX_SWITCH));
+  message.AddSignal(
+    "Angle",
+    NewEagle::DbcSignal(
+      dlc, 0.1, 0.0, bit + 40, NewEagle::LITTLE_END, 16, NewEagle::SIGNED, "Angle",
+      NewEagle::MUX_SIGNAL, 3));
+  message.AddSignal(
+    "Status",
+    NewEagle::DbcSignal(
+      dlc, 1.0, 0.0, bit + 56, NewEagle::LITTLE_END, 8, NewEagle::UNSIGNED, "Status",
+      NewEagle::MUX_SIGNAL, 3));
+  message.AddSignal(
+    "Distance",
+    NewEagle::DbcSignal(
+      dlc, 1.0, 100.0, bit + 47, NewEagle::BIG_END, 24, NewEagle::UNSIGNED, "Distance",
+      NewEagle::MUX_SIGNAL, 5));
+
+  return message;
+}
+
+// Random payload whose switch is raw 0 to 3, so frames select group 3, group 5
+// or neither.
+void RandomMuxPayload(Random & random, uint8_t * data, size_t length)
+{
+  random.Fill(data, length);
+  data[4] = static_cast<uint8_t>((data[4] & 0xF0) | (random.Next() % 4));
+}
+
+std::vector<double> CurrentValues(NewEagle::DbcMessage & message)
+{
+  std::vector<double> values(message.GetSignalCount());
+
+  for (NewEagle::SignalHandle h = 0; h < values.size(); h++) {
+    values[h] = message.GetSignal(h)->GetResult();
+  }
+
+  return values;
+}
+
+// A byte-wide switch (Select) scaled by gain and offset, a plain byte (Plain),
+// and one byte-wide signal each in the groups selected by 3 (Three) and 4 (Four).
+NewEagle::DbcMessage MakeSwitchMessage(double gain, double offset)
+{
+  NewEagle::DbcMessage message(8, 0x201, NewEagle::STD, "Switch", 0x201);
+
+  message.AddSignal(
+    "Select",
+    NewEagle::DbcSignal(
+      8, gain, offset, 0, NewEagle::LITTLE_END, 8, NewEagle::UNSIGNED, "Select",
+      NewEagle::MUX_SWITCH));
+  message.AddSignal(
+    "Three",
+    NewEagle::DbcSignal(
+      8, 1.0, 0.0, 8, NewEagle::LITTLE_END, 8, NewEagle::UNSIGNED, "Three",
+      NewEagle::MUX_SIGNAL, 3));
+  message.AddSignal(
+    "Four",
+    NewEagle::DbcSignal(
+      8, 1.0, 0.0, 16, NewEagle::LITTLE_END, 8, NewEagle::UNSIGNED, "Four",
+      NewEagle::MUX_SIGNAL, 4));
+  message.AddSignal(
+    "Plain",
+    NewEagle::DbcSignal(
+      8, 1.0, 0.0, 24, NewEagle::LITTLE_END, 8, NewEagle::UNSIGNED, "Plain",
+      NewEagle::NONE));
+
+  return message;
+}
+
+// Feeds one frame with the given raw switch to both SetFrame and Decode and
+// checks they agree on what Three, Four and Plain hold afterwards.
+void ExpectFrame(
+  NewEagle::DbcMessage & message, std::vector<double> & values, uint8_t select,
+  uint8_t three, uint8_t four, uint8_t plain, double expectedThree, double expectedFour)
+{
+  uint8_t payload[8] = {select, three, four, plain, 0, 0, 0, 0};
+  message.SetFrame(payload, sizeof(payload));
+  message.Decode(payload, values.data());
+
+  const char * names[] = {"Three", "Four", "Plain"};
+  double expected[] = {expectedThree, expectedFour, static_cast<double>(plain)};
+
+  for (size_t i = 0; i < 3; i++) {
+    NewEagle::SignalHandle h = message.GetSignalHandle(names[i]);
+    EXPECT_EQ(expected[i], message.GetSignal(h)->GetResult()) <<
+      names[i] << ", raw switch " << static_cast<int>(select);
+    EXPECT_EQ(expected[i], values[h]) <<
+      names[i] << ", raw switch " << static_cast<int>(select);
+  }
+}
+
+// Feeds one frame with the given raw switch to SetFrame, without reading any
+// signal back.
+void FeedFrame(
+  NewEagle::DbcMessage & message, uint8_t select, uint8_t three, uint8_t four, uint8_t plain)
+{
+  uint8_t payload[8] = {select, three, four, plain, 0, 0, 0, 0};
+  message.SetFrame(payload, sizeof(payload));
+}
+
+// Sets a random subset of the signals each round, to values decoded from a
+// random payload, and checks GetFrame against Encode of the same values; the
+// rolling counter, if any, is expected to count up from 0. Returns how many
+// rounds changed the multiplexer switch.
+size_t ExpectGetFrameMatchesEncode(NewEagle::DbcMessage & message, uint64_t seed)
+{
+  NewEagle::DbcMessage decoder = message;
+  NewEagle::SignalHandle counter = message.GetRollingCounterSignal();
+  bool multiplexed = message.AnyMultiplexedSignals();
+  NewEagle::SignalHandle mode = multiplexed ? message.GetSignalHandle("Mode") : 0;
+  std::vector<double> values = CurrentValues(message);
+  Random random(seed);
+  size_t switches = 0;
+
+  for (size_t i = 0; i < FRAME_COUNT; i++) {
+    uint8_t payload[8];
+    RandomMuxPayload(random, payload, sizeof(payload));
+
+    std::vector<double> fresh = values;
+    decoder.Decode(payload, fresh.data());
+
+    double previousMode = values[mode];
+    for (NewEagle::SignalHandle h = 0; h < values.size(); h++) {
+      if (0 == random.Next() % 3) {
+        values[h] = fresh[h];
+        message.GetSignal(h)->SetResult(values[h]);
+      }
+    }
+    switches += multiplexed && (values[mode] != previousMode);
+
+    if (NewEagle::NO_SIGNAL != counter) {
+      values[counter] = static_cast<double>(i % 16);
+    }
+
+    Frame expected = message.Encode(values.data());
+    Frame actual = message.GetFrame();
+    EXPECT_EQ(expected.data, actual.data) << message.GetName() << " frame " << i;
+    if (expected.data != actual.data) {
+      break;
+    }
+  }
+
+  return switches;
+}
+}  // namespace
+
+TEST(DbcMessage, DecodeMatchesSetFrame)
+{
+  NewEagle::DbcMessage message = MakeMuxMessage();
+  NewEagle::SignalHandle mode = message.GetSignalHandle("Mode");
+  Random random(1);
+
+  // Both decoders leave the signals the switch does not select untouched, so
+  // the arrays carry over from frame to frame just like the signals do.
+  std::vector<double> values = CurrentValues(message);
+  std::vector<int64_t> raws(values.size());
+  for (NewEagle::SignalHandle h = 0; h < raws.size(); h++) {
+    raws[h] = message.GetSignal(h)->GetRaw();
+  }
+
+  for (size_t i = 0; i < FRAME_COUNT; i++) {
+    Frame::SharedPtr frame = std::make_shared<Frame>();
+    RandomMuxPayload(random, frame->data.data(), frame->data.size());
+
+    message.SetFrame(frame);
+    message.Decode(frame->data.data(), values.data());
+    message.DecodeRaw(frame->data.data(), raws.data());
+
+    for (NewEagle::SignalHandle h = 0; h < values.size(); h++) {
+      const NewEagle::DbcSignal * signal = message.GetSignal(h);
+      ASSERT_EQ(signal->GetResult(), values[h]) << signal->GetName() << " frame " << i;
+      ASSERT_EQ(signal->GetRaw(), raws[h]) << signal->GetName() << " frame " << i;
+    }
+  }
+
+  // Raw 1 is physical 3: DecodeRaw must not look the raw value up as a group.
+  uint8_t payload[8] = {0, 0, 0, 0, 1, 0x34, 0x12, 0};
+  message.DecodeRaw(payload, raws.data());
+  EXPECT_EQ(1, raws[mode]);
+  EXPECT_EQ(0x1234, raws[message.GetSignalHandle("Angle")]);
+}
+
+TEST(DbcMessage, EncodeMatchesGetFrame)
+{
+  NewEagle::DbcMessage decoder = MakeMuxMessage();
+  NewEagle::DbcMessage message = MakeMuxMessage();
+  std::vector<double> values = CurrentValues(message);
+  Random random(2);
+
+  for (size_t i = 0; i < FRAME_COUNT; i++) {
+    uint8_t payload[8];
+    RandomMuxPayload(random, payload, sizeof(payload));
+    decoder.Decode(payload, values.data());
+
+    for (NewEagle::SignalHandle h = 0; h < values.size(); h++) {
+      message.GetSignal(h)->SetResult(values[h]);
+    }
+
+    Frame expected = message.GetFrame();
+    Frame encoded = decoder.Encode(values.data());
+    ASSERT_EQ(expected.data, encoded.data) << "frame " << i;
+    EXPECT_EQ(expected.dlc, encoded.dlc);
+    EXPECT_EQ(expected.id, encoded.id);
+  }
+}
+
+TEST(DbcMessage, UnselectedGroupKeepsItsValues)
+{
+  NewEagle::DbcMessage message = MakeSwitchMessage(1.0, 0.0);
+  std::vector<double> values(message.GetSignalCount(), 0.0);
+
+  ExpectFrame(message, values, 3, 0x11, 0x22, 1, 0x11, 0.0);
+  ExpectFrame(message, values, 4, 0x33, 0x44, 2, 0x11, 0x44);
+
+  // No group for 9: both groups hold on to their last values.
+  ExpectFrame(message, values, 9, 0x55, 0x66, 3, 0x11, 0x44);
+  ExpectFrame(message, values, 3, 0x77, 0x88, 4, 0x77, 0x44);
+
+  // Only the selected group goes into the frame, whatever the others hold.
+  Frame frame = message.GetFrame();
+  EXPECT_EQ(0x77, frame.data[1]);
+  EXPECT_EQ(0x00, frame.data[2]);
+
+  message.GetSignal("Select")->SetResult(4);
+  frame = message.GetFrame();
+  EXPECT_EQ(0x00, frame.data[1]);
+  EXPECT_EQ(0x44, frame.data[2]);
+}
+
+TEST(DbcMessage, FractionalSwitchSelectsNothing)
+{
+  // Raw 6 is 3.0 and selects group 3; raw 7 is 3.5 and must not.
+  NewEagle::DbcMessage message = MakeSwitchMessage(0.5, 0.0);
+  std::vector<double> values(message.GetSignalCount(), 0.0);
+
+  ExpectFrame(message, values, 6, 0x11, 0x22, 1, 0x11, 0.0);
+  ExpectFrame(message, values, 7, 0x33, 0x44, 2, 0x11, 0.0);
+  ExpectFrame(message, values, 8, 0x55, 0x66, 3, 0x11, 0x66);
+
+  message.GetSignal("Three")->SetResult(0x99);
+  message.GetSignal("Select")->SetResult(3.5);
+  Frame frame = message.GetFrame();
+  EXPECT_EQ(7, frame.data[0]);
+  EXPECT_EQ(0x00, frame.data[1]);
+  EXPECT_EQ(0x00, frame.data[2]);
+}
+
+TEST(DbcMessage, OutOfRangeSwitchSelectsNothing)
+{
+  // Raw 0 is 3.0 and selects group 3. Raw 1 is 2^32 + 3, which wraps to 3
+  // if cut to 32 bits, and raw 255 is far past what an int32_t holds.
+  NewEagle::DbcMessage message = MakeSwitchMessage(4294967296.0, 3.0);
+  std::vector<double> values(message.GetSignalCount(), 0.0);
+
+  ExpectFrame(message, values, 0, 0x11, 0x22, 1, 0x11, 0.0);
+  ExpectFrame(message, values, 1, 0x33, 0x44, 2, 0x11, 0.0);
+  ExpectFrame(message, values, 255, 0x55, 0x66, 3, 0x11, 0.0);
+
+  message.GetSignal("Three")->SetResult(0x99);
+  message.GetSignal("Select")->SetResult(4294967299.0);
+  Frame frame = message.GetFrame();
+  EXPECT_EQ(1, frame.data[0]);
+  EXPECT_EQ(0x00, frame.data[1]);
+}
+
+TEST(DbcMessage, CanFdMatchesDecodeAndEncode)
+{
+  // Everything but the switch sits 20 bytes into a 64-byte payload.
+  NewEagle::DbcMessage message = MakeMuxMessage(64, 20);
+  NewEagle::DbcMessage sender = MakeMuxMessage(64, 20);
+  ASSERT_EQ(64u, message.GetFrameSize());
+  ASSERT_GT(message.GetSignal("Speed")->GetPlan().ByteOffset, 8);
+  ASSERT_TRUE(message.GetSignal("Distance")->GetPlan().Valid);
+
+  std::vector<double> values = CurrentValues(message);
+  Random random(3);
+
+  for (size_t i = 0; i < FRAME_COUNT; i++) {
+    uint8_t payload[64];
+    RandomMuxPayload(random, payload, sizeof(payload));
+
+    message.SetFrame(payload, sizeof(payload));
+    message.Decode(payload, values.data());
+
+    for (NewEagle::SignalHandle h = 0; h < values.size(); h++) {
+      ASSERT_EQ(message.GetSignal(h)->GetResult(), values[h]) <<
+        message.GetSignal(h)->GetName() << " frame " << i;
+      sender.GetSignal(h)->SetResult(values[h]);
+    }
+
+    uint8_t expected[64];
+    uint8_t actual[64];
+    EXPECT_EQ(64u, message.Encode(values.data(), expected, sizeof(expected)));
+    EXPECT_EQ(64u, sender.GetFrame(actual, sizeof(actual)));
+    ASSERT_EQ(0, memcmp(expected, actual, sizeof(expected))) << "frame " << i;
+  }
+}
+
+TEST(DbcMessage, CanFdRoundTrip)
+{
+  NewEagle::DbcMessage message = MakeMuxMessage(64, 20);
+  NewEagle::DbcMessage decoder = MakeMuxMessage(64, 20);
+  size_t count = message.GetSignalCount();
+  Random random(4);
+
+  for (size_t i = 0; i < FRAME_COUNT; i++) {
+    uint8_t payload[64];
+    uint8_t copy[64];
+    RandomMuxPayload(random, payload, sizeof(payload));
+
+    message.SetFrame(payload, sizeof(payload));
+    message.GetFrame(copy, sizeof(copy));
+
+    // Only the signal bits survive the trip; they must all come back.
+    std::vector<int64_t> sent(count, 0);
+    std::vector<int64_t> received(count, 0);
+    decoder.DecodeRaw(payload, sent.data());
+    decoder.DecodeRaw(copy, received.data());
+    ASSERT_EQ(sent, received) << "frame " << i;
+  }
+}
+
+TEST(DbcMessage, CanFdShortPayloadIsZeroPadded)
+{
+  NewEagle::DbcMessage message = MakeMuxMessage(64, 20);
+  Random random(5);
+
+  uint8_t payload[64];
+  RandomMuxPayload(random, payload, sizeof(payload));
+
+  // 30 bytes cover Speed and Torque but not the multiplexed signals.
+  uint8_t padded[64] = {0};
+  memcpy(padded, payload, 30);
+
+  std::vector<double> values(message.GetSignalCount(), -1.0);
+  message.Decode(padded, values.data());
+  message.SetFrame(payload, 30);
+
+  for (NewEagle::SignalHandle h = 0; h < values.size(); h++) {
+    const NewEagle::DbcSignal * signal = message.GetSignal(h);
+    bool selected = NewEagle::MUX_SIGNAL != signal->GetMultiplexerMode() ||
+      values[message.GetSignalHandle("Mode")] == signal->GetMultiplexerSwitch();
+    if (selected) {
+      EXPECT_EQ(values[h], signal->GetResult()) << signal->GetName();
+    }
+  }
+
+  // A short buffer gets only what fits.
+  uint8_t out[64];
+  memset(out, 0xAA, sizeof(out));
+  EXPECT_EQ(64u, message.GetFrame(out, 10));
+  EXPECT_EQ(0xAA, out[10]);
+  EXPECT_EQ(0xAA, out[63]);
+}
+
+TEST(DbcMessage, CanFdDoesNotFitInAFrame)
+{
+  NewEagle::DbcMessage message = MakeMuxMessage(64, 20);
+  std::vector<double> values(message.GetSignalCount(), 0.0);
+
+  EXPECT_THROW(message.GetFrame(), std::runtime_error);
+  EXPECT_THROW(message.Encode(values.data()), std::runtime_error);
+
+  // A classic message still gets its DLC.
+  NewEagle::DbcMessage classic = MakeMuxMessage(8);
+  EXPECT_EQ(8, classic.GetFrame().dlc);
+  EXPECT_EQ(8, classic.Encode(values.data()).dlc);
+}
+
+TEST(DbcMessage, GetFrameRepacksOnlyWhatChanged)
+{
+  // The first GetFrame builds the whole payload; after that only changed
+  // signals are repacked, except when the switch changes.
+  NewEagle::DbcMessage message = MakeMuxMessage();
+  EXPECT_GT(ExpectGetFrameMatchesEncode(message, 6), 50u);
+}
+
+TEST(DbcMessage, GetFrameWithOverlappingSignals)
+{
+  // Overlay shares bits with Speed, so every GetFrame rebuilds the payload
+  // and the signal added last wins the shared bits.
+  NewEagle::DbcMessage message = MakeMuxMessage();
+  message.AddSignal(
+    "Overlay",
+    NewEagle::DbcSignal(
+      8, 1.0, 0.0, 4, NewEagle::LITTLE_END, 8, NewEagle::UNSIGNED, "Overlay",
+      NewEagle::NONE));
+
+  EXPECT_GT(ExpectGetFrameMatchesEncode(message, 7), 50u);
+}
+
+TEST(DbcMessage, GetFrameWithCounterAndChecksum)
+{
+  NewEagle::DbcMessage message(8, 0x202, NewEagle::STD, "Protected", 0x202);
+  message.AddSignal(
+    "Value",
+    NewEagle::DbcSignal(
+      8, 1.0, 0.0, 0, NewEagle::LITTLE_END, 16, NewEagle::UNSIGNED, "Value", NewEagle::NONE));
+  message.AddSignal(
+    "Other",
+    NewEagle::DbcSignal(
+      8, 0.5, -3.0, 16, NewEagle::LITTLE_END, 16, NewEagle::SIGNED, "Other", NewEagle::NONE));
+  message.AddSignal(
+    "Counter",
+    NewEagle::DbcSignal(
+      8, 1.0, 0.0, 52, NewEagle::LITTLE_END, 4, NewEagle::UNSIGNED, "Counter",
+      NewEagle::NONE));
+  message.AddSignal(
+    "Checksum",
+    NewEagle::DbcSignal(
+      8, 1.0, 0.0, 56, NewEagle::LITTLE_END, 8, NewEagle::UNSIGNED, "Checksum",
+      NewEagle::NONE));
+  message.SetRollingCounter(message.GetSignalHandle("Counter"));
+  message.SetChecksum(message.GetSignalHandle("Checksum"), NewEagle::CHECKSUM_CRC8_SAE_J1850);
+
+  ExpectGetFrameMatchesEncode(message, 8);
+}
+
+TEST(DbcMessage, LazyDecodeMatchesEager)
+{
+  NewEagle::DbcMessage eager = MakeMuxMessage();
+  NewEagle::DbcMessage lazy = MakeMuxMessage();
+  lazy.SetLazyDecode(true);
+  Random random(10);
+  size_t toggles = 0;
+
+  for (size_t i = 0; i < FRAME_COUNT; i++) {
+    uint8_t payload[8];
+    RandomMuxPayload(random, payload, sizeof(payload));
+    eager.SetFrame(payload, sizeof(payload));
+    lazy.SetFrame(payload, sizeof(payload));
+
+    // Read, set or skip each signal, so some stay pending across the next
+    // frames and whatever switch changes they bring.
+    for (NewEagle::SignalHandle h = 0; h < eager.GetSignalCount(); h++) {
+      switch (random.Next() % 6) {
+        case 0:
+          EXPECT_EQ(eager.GetSignal(h)->GetResult(), lazy.GetSignal(h)->GetResult()) <<
+            eager.GetSignal(h)->GetName() << ", frame " << i;
+          break;
+        case 1:
+          EXPECT_EQ(eager.GetSignal(h)->GetRaw(), lazy.GetSignal(h)->GetRaw()) <<
+            eager.GetSignal(h)->GetName() << ", frame " << i;
+          break;
+        case 2:
+          eager.GetSignal(h)->SetResult(static_cast<double>(h + i));
+          lazy.GetSignal(h)->SetResult(static_cast<double>(h + i));
+          break;
+        default:
+          break;
+      }
+    }
+
+    if (0 == random.Next() % 7) {
+      EXPECT_EQ(eager.GetFrame().data, lazy.GetFrame().data) << "frame " << i;
+    }
+
+    // Switching lazy mode off or on again with reads still pending.
+    if (0 == random.Next() % 23) {
+      lazy.SetLazyDecode(!lazy.GetLazyDecode());
+      toggles++;
+    }
+  }
+
+  EXPECT_EQ(CurrentValues(eager), CurrentValues(lazy));
+  EXPECT_GT(toggles, 10u);
+}
+
+TEST(DbcMessage, LazyDecodeKeepsUnreadGroupsAcrossSwitchChanges)
+{
+  NewEagle::DbcMessage eager = MakeSwitchMessage(1.0, 0.0);
+  NewEagle::DbcMessage lazy = MakeSwitchMessage(1.0, 0.0);
+  lazy.SetLazyDecode(true);
+
+  // Nothing is read until the switch has moved on from both groups: each keeps
+  // the value from the last frame that selected it.
+  for (NewEagle::DbcMessage * message : {&eager, &lazy}) {
+    FeedFrame(*message, 3, 0x11, 0x22, 1);
+    FeedFrame(*message, 4, 0x33, 0x44, 2);
+    FeedFrame(*message, 9, 0x55, 0x66, 3);
+  }
+
+  EXPECT_EQ(0x11, lazy.GetSignal("Three")->GetResult());
+  EXPECT_EQ(0x44, lazy.GetSignal("Four")->GetResult());
+  EXPECT_EQ(3, lazy.GetSignal("Plain")->GetResult());
+  EXPECT_EQ(CurrentValues(eager), CurrentValues(lazy));
+
+  // Only the newly selected group is replaced.
+  for (NewEagle::DbcMessage * message : {&eager, &lazy}) {
+    FeedFrame(*message, 3, 0x77, 0x88, 4);
+  }
+
+  EXPECT_EQ(0x77, lazy.GetSignal("Three")->GetResult());
+  EXPECT_EQ(0x44, lazy.GetSignal("Four")->GetResult());
+  EXPECT_EQ(CurrentValues(eager), CurrentValues(lazy));
+}
+
+TEST(DbcMessage, LazyDecodeOffWithReadsPending)
+{
+  NewEagle::DbcMessage eager = MakeSwitchMessage(1.0, 0.0);
+  NewEagle::DbcMessage lazy = MakeSwitchMessage(1.0, 0.0);
+  lazy.SetLazyDecode(true);
+
+  for (NewEagle::DbcMessage * message : {&eager, &lazy}) {
+    FeedFrame(*message, 3, 0x11, 0x22, 1);
+    FeedFrame(*message, 4, 0x33, 0x44, 2);
+  }
+
+  // The pending signals are decoded on the way out of lazy mode, not lost or
+  // decoded later from whatever the next frame holds.
+  lazy.SetLazyDecode(false);
+  EXPECT_FALSE(lazy.GetLazyDecode());
+
+  for (NewEagle::DbcMessage * message : {&eager, &lazy}) {
+    FeedFrame(*message, 9, 0x55, 0x66, 5);
+  }
+
+  EXPECT_EQ(0x11, lazy.GetSignal("Three")->GetResult());
+  EXPECT_EQ(0x44, lazy.GetSignal("Four")->GetResult());
+  EXPECT_EQ(5, lazy.GetSignal("Plain")->GetResult());
+  EXPECT_EQ(CurrentValues(eager), CurrentValues(lazy));
+}
+
+TEST(DbcMessage, LazyDecodeGenerationWrap)
+{
+  NewEagle::DbcMessage eager = MakeSwitchMessage(1.0, 0.0);
+  NewEagle::DbcMessage lazy = MakeSwitchMessage(1.0, 0.0);
+  lazy.SetLazyDecode(true);
+
+  // Plain is read in generation 1, and must not look current again once the
+  // generation wraps back to 1.
+  for (NewEagle::DbcMessage * message : {&eager, &lazy}) {
+    FeedFrame(*message, 3, 0x11, 0x22, 1);
+  }
+  EXPECT_EQ(1, lazy.GetSignal("Plain")->GetResult());
+
+  NewEagle::DbcMessageTestAccess::SetLazyGeneration(
+    lazy, std::numeric_limits<uint32_t>::max() - 1);
+
+  for (NewEagle::DbcMessage * message : {&eager, &lazy}) {
+    FeedFrame(*message, 4, 0x33, 0x44, 2);
+    FeedFrame(*message, 9, 0x55, 0x66, 3);
+  }
+
+  EXPECT_EQ(3, lazy.GetSignal("Plain")->GetResult());
+  EXPECT_EQ(0x11, lazy.GetSignal("Three")->GetResult());
+  EXPECT_EQ(0x44, lazy.GetSignal("Four")->GetResult());
+  EXPECT_EQ(CurrentValues(eager), CurrentValues(lazy));
+
+  // And frames after the wrap decode as usual.
+  for (NewEagle::DbcMessage * message : {&eager, &lazy}) {
+    FeedFrame(*message, 4, 0x77, 0x88, 6);
+  }
+  EXPECT_EQ(CurrentValues(eager), CurrentValues(lazy));
+}
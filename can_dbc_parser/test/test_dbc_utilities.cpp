@@ -0,0 +1,323 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Checks the plan-based Unpack/Pack against the byte loop they replaced, for
+// every start bit, length, byte order and signedness the old code supported,
+// and UnpackRaw/PackRaw against a bit-at-a-time reference for every length up
+// to 64.
+
+#include <gtest/gtest.h>
+
+#include <can_dbc_parser/DbcSignal.hpp>
+#include <can_dbc_parser/DbcUtilities.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "LegacyUtilities.hpp"
+
+namespace
+{
+const size_t PAYLOAD_COUNT = 16;
+
+std::vector<uint8_t> RandomPayloads(size_t count)
+{
+  std::vector<uint8_t> payloads(8 * count);
+  uint64_t state = 0x9E3779B97F4A7C15ull;
+
+  for (size_t i = 0; i < payloads.size(); i++) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    payloads[i] = static_cast<uint8_t>(state);
+  }
+
+  return payloads;
+}
+
+NewEagle::DbcSignal MakeSignal(
+  uint16_t startBit, uint8_t length, NewEagle::ByteOrder order, NewEagle::SignType sign,
+  double gain, double offset)
+{
+  return NewEagle::DbcSignal(
+    8, gain, offset, startBit, order, length, sign, "Signal", NewEagle::NONE);
+}
+
+// Calls check(signal) for every signal of up to maxLength bits that fits in a
+// classic frame, and returns how many there were. The legacy code handled up
+// to 32 bits.
+template<typename Check>
+size_t ForEachSignal(uint8_t maxLength, double gain, double offset, Check check)
+{
+  size_t count = 0;
+
+  for (NewEagle::ByteOrder order : {NewEagle::LITTLE_END, NewEagle::BIG_END}) {
+    for (NewEagle::SignType sign : {NewEagle::UNSIGNED, NewEagle::SIGNED}) {
+      for (uint8_t length = 1; length <= maxLength; length++) {
+        for (uint16_t startBit = 0; startBit < 64; startBit++) {
+          NewEagle::DbcSignal signal = MakeSignal(startBit, length, order, sign, gain, offset);
+          if (signal.GetPlan().Valid) {
+            check(signal);
+            count++;
+          }
+        }
+      }
+    }
+  }
+
+  return count;
+}
+
+// Every position a signal of each length fits in, per byte order and sign.
+size_t ExpectedSignalCount(size_t maxLength)
+{
+  size_t perOrder = 0;
+  for (size_t length = 1; length <= maxLength; length++) {
+    perOrder += 65 - length;
+  }
+  return 2 * 2 * perOrder;
+}
+
+// Frame bits of a signal from its LSB up, walked the way the DBC defines
+// them: Intel signals count up from the start bit, Motorola signals start at
+// their MSB and run down each byte into bit 7 of the next one.
+std::vector<int32_t> SignalBits(const NewEagle::DbcSignal & signal)
+{
+  std::vector<int32_t> bits;
+  int32_t bit = signal.GetStartBit();
+
+  for (int32_t i = 0; i < signal.GetLength(); i++) {
+    bits.push_back(bit);
+    if (NewEagle::LITTLE_END == signal.GetEndianness()) {
+      bit++;
+    } else {
+      bit = (0 == bit % 8) ? bit + 15 : bit - 1;
+    }
+  }
+
+  if (NewEagle::BIG_END == signal.GetEndianness()) {
+    std::reverse(bits.begin(), bits.end());
+  }
+
+  return bits;
+}
+
+bool FitsInFrame(const NewEagle::DbcSignal & signal)
+{
+  for (int32_t bit : SignalBits(signal)) {
+    if (bit >= 8 * signal.GetDlc()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int64_t ReferenceUnpackRaw(const uint8_t * data, const NewEagle::DbcSignal & signal)
+{
+  std::vector<int32_t> bits = SignalBits(signal);
+  uint64_t raw = 0;
+
+  for (size_t i = 0; i < bits.size(); i++) {
+    raw |= static_cast<uint64_t>((data[bits[i] / 8] >> (bits[i] % 8)) & 1) << i;
+  }
+
+  // Sign-extend from the top bit of the signal.
+  if ((NewEagle::SIGNED == signal.GetSign()) && (bits.size() < 64) &&
+    (0 != (raw >> (bits.size() - 1))))
+  {
+    raw |= ~0ull << bits.size();
+  }
+
+  return static_cast<int64_t>(raw);
+}
+
+void ReferencePackRaw(uint8_t * data, const NewEagle::DbcSignal & signal, int64_t raw)
+{
+  std::vector<int32_t> bits = SignalBits(signal);
+
+  for (size_t i = 0; i < bits.size(); i++) {
+    uint8_t mask = static_cast<uint8_t>(1 << (bits[i] % 8));
+    uint8_t bit = (static_cast<uint64_t>(raw) >> i) & 1;
+    data[bits[i] / 8] = static_cast<uint8_t>((data[bits[i] / 8] & ~mask) | (bit ? mask : 0));
+  }
+}
+
+std::string Describe(const NewEagle::DbcSignal & signal)
+{
+  return std::to_string(signal.GetStartBit()) + "|" + std::to_string(signal.GetLength()) +
+         "@" + (signal.GetEndianness() == NewEagle::LITTLE_END ? "1" : "0") +
+         (signal.GetSign() == NewEagle::SIGNED ? "-" : "+");
+}
+}  // namespace
+
+TEST(DbcUtilities, UnpackMatchesLegacy)
+{
+  std::vector<uint8_t> payloads = RandomPayloads(PAYLOAD_COUNT);
+
+  for (double gain : {1.0, 0.5}) {
+    double offset = (gain == 1.0) ? 0.0 : -10.0;
+
+    size_t count = ForEachSignal(
+      32, gain, offset, [&payloads](const NewEagle::DbcSignal & signal) {
+        for (size_t i = 0; i < PAYLOAD_COUNT; i++) {
+          const uint8_t * payload = &payloads[i * 8];
+          ASSERT_EQ(
+            NewEagle::Legacy::Unpack(payload, signal),
+            NewEagle::Unpack(payload, signal)) << Describe(signal) << " payload " << i;
+        }
+      });
+
+    EXPECT_EQ(ExpectedSignalCount(32), count);
+  }
+}
+
+TEST(DbcUtilities, PackMatchesLegacy)
+{
+  std::vector<uint8_t> payloads = RandomPayloads(PAYLOAD_COUNT);
+
+  for (double gain : {1.0, 0.5}) {
+    double offset = (gain == 1.0) ? 0.0 : -10.0;
+
+    size_t count = ForEachSignal(
+      32, gain, offset, [&payloads](const NewEagle::DbcSignal & signal) {
+        for (size_t i = 0; i < PAYLOAD_COUNT; i++) {
+          // A value the signal can hold, packed over a different payload so
+          // both the signal bits and the bits around them are checked.
+          double value = NewEagle::Legacy::Unpack(&payloads[i * 8], signal);
+          const uint8_t * background = &payloads[((i + 1) % PAYLOAD_COUNT) * 8];
+
+          uint8_t expected[8];
+          uint8_t actual[8];
+          memcpy(expected, background, 8);
+          memcpy(actual, background, 8);
+
+          NewEagle::Legacy::Pack(expected, signal, value);
+          NewEagle::PackValue(actual, signal, value);
+          ASSERT_EQ(0, memcmp(expected, actual, 8)) << Describe(signal) << " payload " << i;
+        }
+      });
+
+    EXPECT_EQ(ExpectedSignalCount(32), count);
+  }
+}
+
+TEST(DbcUtilities, UnpackOutsideFrameIsZero)
+{
+  std::vector<uint8_t> payloads = RandomPayloads(1);
+
+  // Intel signal running past the last byte, Motorola signal starting in it.
+  NewEagle::DbcSignal intel = MakeSignal(60, 8, NewEagle::LITTLE_END, NewEagle::UNSIGNED, 1, 0);
+  NewEagle::DbcSignal motorola = MakeSignal(58, 8, NewEagle::BIG_END, NewEagle::UNSIGNED, 1, 0);
+
+  EXPECT_FALSE(intel.GetPlan().Valid);
+  EXPECT_FALSE(motorola.GetPlan().Valid);
+  EXPECT_EQ(0.0, NewEagle::Unpack(payloads.data(), intel));
+  EXPECT_EQ(0.0, NewEagle::Unpack(payloads.data(), motorola));
+}
+
+TEST(DbcUtilities, UnpackRawMatchesBitWalk)
+{
+  std::vector<uint8_t> payloads = RandomPayloads(PAYLOAD_COUNT);
+
+  // Anything that fits in a classic frame has a valid plan, and nothing else.
+  for (NewEagle::ByteOrder order : {NewEagle::LITTLE_END, NewEagle::BIG_END}) {
+    for (uint8_t length = 1; length <= 64; length++) {
+      for (uint16_t startBit = 0; startBit < 64; startBit++) {
+        NewEagle::DbcSignal signal =
+          MakeSignal(startBit, length, order, NewEagle::UNSIGNED, 1, 0);
+        ASSERT_EQ(FitsInFrame(signal), signal.GetPlan().Valid) << Describe(signal);
+      }
+    }
+  }
+
+  size_t count = ForEachSignal(
+    64, 1, 0, [&payloads](const NewEagle::DbcSignal & signal) {
+      for (size_t i = 0; i < PAYLOAD_COUNT; i++) {
+        const uint8_t * payload = &payloads[i * 8];
+        ASSERT_EQ(
+          ReferenceUnpackRaw(payload, signal),
+          NewEagle::UnpackRaw(payload, signal)) << Describe(signal) << " payload " << i;
+      }
+    });
+
+  EXPECT_EQ(ExpectedSignalCount(64), count);
+}
+
+TEST(DbcUtilities, PackRawMatchesBitWalk)
+{
+  std::vector<uint8_t> payloads = RandomPayloads(PAYLOAD_COUNT);
+
+  size_t count = ForEachSignal(
+    64, 1, 0, [&payloads](const NewEagle::DbcSignal & signal) {
+      for (size_t i = 0; i < PAYLOAD_COUNT; i++) {
+        // A raw value read at the same spot of another payload, packed over
+        // this one, so both the signal bits and the bits around them are checked.
+        int64_t raw = ReferenceUnpackRaw(&payloads[((i + 1) % PAYLOAD_COUNT) * 8], signal);
+
+        uint8_t expected[8];
+        uint8_t actual[8];
+        memcpy(expected, &payloads[i * 8], 8);
+        memcpy(actual, &payloads[i * 8], 8);
+
+        ReferencePackRaw(expected, signal, raw);
+        NewEagle::PackRaw(actual, signal.GetPlan(), raw);
+        ASSERT_EQ(0, memcmp(expected, actual, 8)) << Describe(signal) << " payload " << i;
+        ASSERT_EQ(raw, NewEagle::UnpackRaw(actual, signal)) << Describe(signal);
+      }
+    });
+
+  EXPECT_EQ(ExpectedSignalCount(64), count);
+}
+
+TEST(DbcUtilities, ToRawSaturatesOutOfRange)
+{
+  NewEagle::DbcSignal s64 = MakeSignal(0, 64, NewEagle::LITTLE_END, NewEagle::SIGNED, 1, 0);
+  NewEagle::DbcSignal u64 = MakeSignal(0, 64, NewEagle::LITTLE_END, NewEagle::UNSIGNED, 1, 0);
+  NewEagle::DbcSignal u16 = MakeSignal(0, 16, NewEagle::LITTLE_END, NewEagle::UNSIGNED, 1, 0);
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const int64_t max = std::numeric_limits<int64_t>::max();
+  const int64_t min = std::numeric_limits<int64_t>::min();
+
+  EXPECT_EQ(max, NewEagle::ToRaw(1e30, s64.GetPlan(), 1, 0));
+  EXPECT_EQ(min, NewEagle::ToRaw(-1e30, s64.GetPlan(), 1, 0));
+  EXPECT_EQ(0, NewEagle::ToRaw(nan, s64.GetPlan(), 1, 0));
+
+  // Unsigned 64-bit values above INT64_MAX come back as their two's complement.
+  EXPECT_EQ(min, NewEagle::ToRaw(9223372036854775808.0, u64.GetPlan(), 1, 0));
+  EXPECT_EQ(-1, NewEagle::ToRaw(1e30, u64.GetPlan(), 1, 0));
+  EXPECT_EQ(0, NewEagle::ToRaw(nan, u64.GetPlan(), 1, 0));
+
+  // In range of int64_t: cut to the signal's width, as always.
+  EXPECT_EQ(0xFFFF, NewEagle::ToRaw(-1, u16.GetPlan(), 1, 0));
+  EXPECT_EQ(0x2345, NewEagle::ToRaw(0x12345, u16.GetPlan(), 1, 0));
+  EXPECT_EQ(0xFFFF, NewEagle::ToRaw(1e30, u16.GetPlan(), 1, 0));
+}
@@ -0,0 +1,383 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Benchmarks for the report publishing path: a heap-allocated message
+// published as a unique_ptr against one borrowed from the middleware, and
+// ReportMessage, which picks between the two at run time.
+//
+// Usage: raptor_dbw_can_benchmarks [benchmark flags] [ros args]
+//
+// CPU time per report is the usual benchmark output; allocs_per_report counts
+// calls to operator new. Whether the RMW actually loans a message type is
+// reported as can_loan; when it does not, rclcpp backs the "loaned" message
+// with an ordinary allocation. Run with e.g. RMW_IMPLEMENTATION and a shared
+// memory configuration to compare transports.
+//
+// BM_CommandLatency runs a RaptorDbwCAN node and times a steering command
+// from publication to its AKit_SteeringRequest frame on can_rx, optionally
+// while brake report frames are published on can_tx as fast as possible.
+// threads:1 spins the node on one thread, as the node executable used to.
+//
+// Results are also written as JSON to raptor_dbw_can_benchmarks.json unless
+// --benchmark_out is given.
+
+#include <benchmark/benchmark.h>
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <can_msgs/msg/frame.hpp>
+#include <raptor_dbw_msgs/msg/brake_report.hpp>
+#include <raptor_dbw_msgs/msg/steering_cmd.hpp>
+#include <sensor_msgs/msg/imu.hpp>
+#include <sensor_msgs/msg/joint_state.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "raptor_dbw_can/raptor_dbw_can.hpp"
+#include "raptor_dbw_can/report_message.hpp"
+
+#ifndef RAPTOR_DBW_CAN_BENCHMARK_DBC
+#define RAPTOR_DBW_CAN_BENCHMARK_DBC ""
+#endif
+
+using can_msgs::msg::Frame;
+using raptor_dbw_msgs::msg::BrakeReport;
+using raptor_dbw_msgs::msg::SteeringCmd;
+using sensor_msgs::msg::Imu;
+using sensor_msgs::msg::JointState;
+
+namespace
+{
+std::atomic<size_t> allocations{0};
+}  // namespace
+
+void * operator new(size_t size)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  void * p = std::malloc(size ? size : 1);
+  if (nullptr == p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void * p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void * p, size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace
+{
+rclcpp::Node::SharedPtr node;
+
+// Each fill mirrors what the matching RaptorDbwCAN handler writes.
+const char * Topic(const BrakeReport &) {return "bench/brake_report";}
+const char * Topic(const Imu &) {return "bench/imu";}
+const char * Topic(const JointState &) {return "bench/joint_states";}
+
+void Fill(BrakeReport & report, const builtin_interfaces::msg::Time & stamp)
+{
+  report.header.stamp = stamp;
+  report.pedal_position = 12.5;
+  report.pedal_output = 12.0;
+  report.enabled = true;
+  report.driver_activity = false;
+  report.fault_brake_system = false;
+  report.rolling_counter = 3;
+  report.brake_torque_actual = 40.0;
+  report.intervention_active = false;
+  report.intervention_ready = true;
+  report.parking_brake.status = 1;
+  report.control_type.value = 1;
+}
+
+void Fill(Imu & imu, const builtin_interfaces::msg::Time & stamp)
+{
+  imu.header.stamp = stamp;
+  imu.header.frame_id = "base_footprint";
+  imu.angular_velocity.z = 0.1;
+  imu.linear_acceleration.x = 0.5;
+  imu.linear_acceleration.y = -0.2;
+  imu.linear_acceleration.z = 9.81;
+}
+
+// Joint states are copied from a template kept by the node.
+const JointState & JointTemplate()
+{
+  static JointState joints = [] {
+      JointState j;
+      j.name = {"wheel_fl", "wheel_fr", "wheel_rl", "wheel_rr", "steer_fl", "steer_fr"};
+      j.position.resize(j.name.size());
+      j.velocity.resize(j.name.size());
+      j.effort.resize(j.name.size());
+      return j;
+    }();
+  return joints;
+}
+
+void Fill(JointState & joints, const builtin_interfaces::msg::Time & stamp)
+{
+  joints = JointTemplate();
+  joints.header.stamp = stamp;
+}
+
+enum PublishPath
+{
+  PATH_HEAP = 0,    // std::make_unique, published as a unique_ptr
+  PATH_LOAN,        // borrow_loaned_message, published as a LoanedMessage
+  PATH_REPORT,      // ReportMessage, as used by the node
+};
+
+template<typename MessageT>
+void BM_PublishReport(benchmark::State & state)
+{
+  PublishPath path = static_cast<PublishPath>(state.range(0));
+  auto publisher = node->create_publisher<MessageT>(Topic(MessageT()), 20);
+  builtin_interfaces::msg::Time stamp;
+
+  size_t before = allocations.load(std::memory_order_relaxed);
+  for (auto _ : state) {
+    stamp.nanosec++;
+
+    if (PATH_HEAP == path) {
+      auto msg = std::make_unique<MessageT>();
+      Fill(*msg, stamp);
+      publisher->publish(std::move(msg));
+    } else if (PATH_LOAN == path) {
+      auto msg = publisher->borrow_loaned_message();
+      Fill(msg.get(), stamp);
+      publisher->publish(std::move(msg));
+    } else {
+      raptor_dbw_can::ReportMessage<MessageT> msg(publisher);
+      Fill(*msg, stamp);
+      msg.publish();
+    }
+  }
+  size_t after = allocations.load(std::memory_order_relaxed);
+
+  state.counters["allocs_per_report"] = benchmark::Counter(
+    static_cast<double>(after - before), benchmark::Counter::kAvgIterations);
+  state.counters["can_loan"] = publisher->can_loan_messages() ? 1 : 0;
+}
+
+void PathArgs(benchmark::internal::Benchmark * b)
+{
+  b->ArgName("path");
+  b->Arg(PATH_HEAP);
+  b->Arg(PATH_LOAN);
+  b->Arg(PATH_REPORT);
+}
+
+BENCHMARK_TEMPLATE(BM_PublishReport, BrakeReport)->Apply(PathArgs);
+BENCHMARK_TEMPLATE(BM_PublishReport, Imu)->Apply(PathArgs);
+BENCHMARK_TEMPLATE(BM_PublishReport, JointState)->Apply(PathArgs);
+
+// A RaptorDbwCAN node on its own executor, plus a node standing in for the CAN
+// bridge and a controller.
+class CommandLatencyRig
+{
+public:
+  explicit CommandLatencyRig(size_t threads)
+  : dbw_exec_(rclcpp::ExecutorOptions(), threads)
+  {
+    rclcpp::NodeOptions options;
+    options.parameter_overrides(
+      {
+        rclcpp::Parameter("dbw_dbc_file", std::string(RAPTOR_DBW_CAN_BENCHMARK_DBC)),
+        rclcpp::Parameter("dbw_dbc_cache_file", std::string("")),
+      });
+    dbw_ = std::make_shared<raptor_dbw_can::RaptorDbwCAN>(options);
+
+    bridge_ = std::make_shared<rclcpp::Node>("raptor_dbw_can_latency");
+    pub_reports_ = bridge_->create_publisher<Frame>("can_tx", 500);
+    pub_steering_ = bridge_->create_publisher<SteeringCmd>("steering_cmd", 1);
+    sub_frames_ = bridge_->create_subscription<Frame>(
+      "can_rx", 100, [this](const Frame::SharedPtr msg)
+      {
+        if (raptor_dbw_can::ID_STEERING_CMD == msg->id) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          received_ = std::chrono::steady_clock::now();
+          frames_++;
+          frame_cv_.notify_one();
+        }
+      });
+
+    dbw_exec_.add_node(dbw_->get_node_base_interface());
+    bridge_exec_.add_node(bridge_);
+    dbw_thread_ = std::thread([this] {dbw_exec_.spin();});
+    bridge_thread_ = std::thread([this] {bridge_exec_.spin();});
+  }
+
+  ~CommandLatencyRig()
+  {
+    load_running_ = false;
+    if (load_thread_.joinable()) {
+      load_thread_.join();
+    }
+    dbw_exec_.cancel();
+    bridge_exec_.cancel();
+    dbw_thread_.join();
+    bridge_thread_.join();
+  }
+
+  // Waits for discovery, so the first timed command is not lost.
+  bool connect()
+  {
+    for (int i = 0; i < 50; i++) {
+      if (sendCommand(std::chrono::milliseconds(100)) >= 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Floods can_tx with brake reports until the rig is destroyed.
+  void startLoad()
+  {
+    load_running_ = true;
+    load_thread_ = std::thread(
+      [this]
+      {
+        Frame frame;
+        frame.id = raptor_dbw_can::ID_BRAKE_REPORT;
+        frame.dlc = 8;
+        while (load_running_) {
+          pub_reports_->publish(frame);
+        }
+      });
+  }
+
+  // Returns the command-to-frame latency in seconds, or -1 on timeout.
+  double sendCommand(std::chrono::milliseconds timeout = std::chrono::milliseconds(1000))
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    size_t before = frames_;
+    auto sent = std::chrono::steady_clock::now();
+    pub_steering_->publish(SteeringCmd());
+
+    if (!frame_cv_.wait_for(lock, timeout, [&] {return frames_ != before;})) {
+      return -1;
+    }
+    return std::chrono::duration<double>(received_ - sent).count();
+  }
+
+private:
+  rclcpp::executors::MultiThreadedExecutor dbw_exec_;
+  rclcpp::executors::SingleThreadedExecutor bridge_exec_;
+  std::shared_ptr<raptor_dbw_can::RaptorDbwCAN> dbw_;
+  rclcpp::Node::SharedPtr bridge_;
+  rclcpp::Publisher<Frame>::SharedPtr pub_reports_;
+  rclcpp::Publisher<SteeringCmd>::SharedPtr pub_steering_;
+  rclcpp::Subscription<Frame>::SharedPtr sub_frames_;
+  std::thread dbw_thread_;
+  std::thread bridge_thread_;
+  std::thread load_thread_;
+  std::atomic<bool> load_running_{false};
+
+  std::mutex mutex_;
+  std::condition_variable frame_cv_;
+  size_t frames_ = 0;
+  std::chrono::steady_clock::time_point received_;
+};
+
+void BM_CommandLatency(benchmark::State & state)
+{
+  CommandLatencyRig rig(static_cast<size_t>(state.range(0)));
+  if (!rig.connect()) {
+    state.SkipWithError("RaptorDbwCAN did not answer a steering command");
+    return;
+  }
+  if (state.range(1)) {
+    rig.startLoad();
+  }
+
+  double worst = 0;
+  for (auto _ : state) {
+    double latency = rig.sendCommand();
+    if (latency < 0) {
+      state.SkipWithError("Steering command frame timed out");
+      break;
+    }
+    worst = std::max(worst, latency);
+    state.SetIterationTime(latency);
+  }
+
+  state.counters["max_us"] = worst * 1e6;
+}
+
+BENCHMARK(BM_CommandLatency)
+->ArgNames({"threads", "report_load"})
+->ArgsProduct({{1, 3}, {0, 1}})
+->UseManualTime()
+->Unit(benchmark::kMicrosecond);
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  // JSON results go to a file by default so they can be kept per release.
+  std::vector<char *> args(argv, argv + argc);
+  bool hasOut = false;
+  for (int i = 1; i < argc; i++) {
+    hasOut = hasOut || (0 == strncmp(argv[i], "--benchmark_out=", 16));
+  }
+
+  char outFlag[] = "--benchmark_out=raptor_dbw_can_benchmarks.json";
+  char formatFlag[] = "--benchmark_out_format=json";
+  if (!hasOut) {
+    args.insert(args.begin() + 1, {outFlag, formatFlag});
+  }
+
+  int count = static_cast<int>(args.size());
+  benchmark::Initialize(&count, args.data());
+
+  rclcpp::init(count, args.data());
+  node = std::make_shared<rclcpp::Node>("raptor_dbw_can_benchmarks");
+
+  benchmark::RunSpecifiedBenchmarks();
+
+  node.reset();
+  rclcpp::shutdown();
+  return 0;
+}
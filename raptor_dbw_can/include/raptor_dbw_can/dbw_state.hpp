@@ -0,0 +1,236 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/** \brief This file defines the DbwState class.
+ * \copyright Copyright 2021 New Eagle LLC
+ * \file dbw_state.hpp
+ */
+
+#ifndef RAPTOR_DBW_CAN__DBW_STATE_HPP_
+#define RAPTOR_DBW_CAN__DBW_STATE_HPP_
+
+#include <stdint.h>
+
+#include <atomic>
+
+namespace raptor_dbw_can
+{
+/** \brief Enumeration of driver ignores */
+enum ListIgnores
+{
+  IGNORE_ACCEL = 0,  /**< Acceleration pedal ignore */
+  IGNORE_STEER,      /**< Steering ignore */
+  NUM_IGNORES   /**< Total number of driver ignores */
+};
+
+/** \brief Enumeration of driver overrides */
+enum ListOverrides
+{
+  OVR_ACCEL = 0,  /**< Acceleration pedal override */
+  OVR_BRAKE,      /**< Brake override */
+  OVR_GEAR,       /**< PRND gear override */
+  OVR_STEER,      /**< Steering override */
+  NUM_OVERRIDES   /**< Total number of driver overrides */
+};
+
+/** \brief Enumeration of system faults */
+enum ListFaults
+{
+  FAULT_ACCEL = 0,      /**< Acceleration pedal fault */
+  FAULT_BRAKE,          /**< Brake fault */
+  FAULT_STEER,          /**< Steering fault */
+  FAULT_WATCH,          /**< Watchdog fault */
+  NUM_SERIOUS_FAULTS,   /**< Total number of serious faults (disables DBW) */
+  FAULT_WATCH_BRAKES = NUM_SERIOUS_FAULTS,  /**< Watchdog braking fault */
+  FAULT_WATCH_WARN,     /**< Watchdog non-braking fault warning */
+  NUM_FAULTS            /**< Total number of system faults */
+};
+
+/** \brief Enumeration of system enables */
+enum ListEnables
+{
+  EN_ACCEL = 0,   /**< Acceleration pedal system enabled */
+  EN_BRAKE,       /**< Brake system enabled */
+  EN_STEER,       /**< Steering system enabled */
+  EN_DBW,         /**< DBW system enabled */
+  EN_DBW_PREV,    /**< DBW system previously enabled (track edge) */
+  NUM_ENABLES     /**< Total number of system enables */
+};
+
+/** \brief The enable, override, fault & ignore flags of the DBW system, kept in
+ *    one lock-free word. The report, command & timer callbacks run on different
+ *    threads; every change is a single compare-and-swap of the whole word, so a
+ *    fault or override cannot interleave with an enable and leave it latched.
+ */
+class DbwState
+{
+public:
+/** \brief A consistent snapshot of all the flags. */
+  class Flags
+  {
+public:
+    explicit Flags(uint32_t bits = 0)
+    : bits_{bits} {}
+
+/** \brief Check whether DBW control has been requested (EN_DBW).
+ * \returns TRUE if enabled and not since disabled, even while faulted or overridden
+ */
+    bool enable() const {return bits_ & bit(EN_DBW);}
+
+/** \brief Check the DBW enable state last published (EN_DBW_PREV).
+ * \returns TRUE if the last state published was enabled
+ */
+    bool published() const {return bits_ & bit(EN_DBW_PREV);}
+
+/** \brief Check one fault.
+ * \param[in] which Which fault to check
+ * \returns TRUE if the fault is active
+ */
+    bool fault(ListFaults which) const {return bits_ & bit(which);}
+
+/** \brief Check for an active serious fault.
+ * \returns TRUE if there is any active fault that disables DBW, FALSE otherwise
+ */
+    bool fault() const {return bits_ & SERIOUS_FAULTS;}
+
+/** \brief Check one driver override, whether or not it is ignored.
+ * \param[in] which Which override to check
+ * \returns TRUE if the driver is overriding the system
+ */
+    bool override (ListOverrides which) const {return bits_ & bit(which);}
+
+/** \brief Check one driver ignore.
+ * \param[in] which Which ignore to check
+ * \returns TRUE if the command asked to ignore the driver
+ */
+    bool ignore(ListIgnores which) const {return bits_ & bit(which);}
+
+/** \brief Check whether an override is ignored. Only the accelerator pedal and
+ *    steering overrides can be.
+ * \param[in] which Which override to check
+ * \returns TRUE if the matching ignore is set
+ */
+    bool ignored(ListOverrides which) const
+    {
+      return (OVR_ACCEL == which && ignore(IGNORE_ACCEL)) ||
+             (OVR_STEER == which && ignore(IGNORE_STEER));
+    }
+
+/** \brief Check for an active driver override.
+ * \returns TRUE if there is any active driver override that is not ignored, FALSE otherwise
+ */
+    bool override () const
+    {
+      return override (OVR_BRAKE) || override (OVR_GEAR) ||
+             (override (OVR_ACCEL) && !ignore(IGNORE_ACCEL)) ||
+             (override (OVR_STEER) && !ignore(IGNORE_STEER));
+    }
+
+/** \brief Check for an active driver override.
+ * \returns TRUE if DBW is enabled && there is any active driver override, FALSE otherwise
+ */
+    bool clear() const {return enable() && override ();}
+
+/** \brief Check whether the DBW Node is in control of the vehicle.
+ * \returns TRUE if DBW is enabled && there are no active faults or driver overrides,
+ *          FALSE otherwise
+ */
+    bool enabled() const {return enable() && !fault() && !override ();}
+
+/** \brief The flags as a word. */
+    uint32_t bits() const {return bits_;}
+
+/** \brief Bit of each flag in the word. */
+    static constexpr uint32_t bit(ListEnables which) {return 1u << which;}
+    static constexpr uint32_t bit(ListIgnores which) {return 1u << (8 + which);}
+    static constexpr uint32_t bit(ListOverrides which) {return 1u << (12 + which);}
+    static constexpr uint32_t bit(ListFaults which) {return 1u << (16 + which);}
+
+private:
+    static constexpr uint32_t SERIOUS_FAULTS =
+      ((1u << NUM_SERIOUS_FAULTS) - 1) << 16;
+
+    uint32_t bits_;
+  };
+
+/** \brief The flags just before and just after one change. */
+  struct Change
+  {
+    Flags before;   /**< Flags the change was applied to */
+    Flags after;    /**< Flags the change left */
+  };
+
+/** \brief Start disabled, with disabled as the state last published. */
+  DbwState();
+
+/** \brief Read all the flags at once. */
+  Flags get() const {return Flags(bits_.load());}
+
+/** \brief Request DBW control. Refused while a serious fault is active; latched
+ *    while a driver override is active, taking control once it clears.
+ */
+  Change enable();
+
+/** \brief Release DBW control. */
+  Change disable();
+
+/** \brief Set a driver override. An override that is not ignored releases DBW
+ *    control if the system is in control.
+ * \param[in] which Which override to set
+ * \param[in] override The value to set the override to
+ */
+  Change setOverride(ListOverrides which, bool override);
+
+/** \brief Set a fault. A serious fault releases DBW control, even if an override
+ *    already took it away, so clearing the fault never re-enables the system.
+ * \param[in] which Which fault to set
+ * \param[in] fault The value to set the fault to
+ */
+  Change setFault(ListFaults which, bool fault);
+
+/** \brief Set a driver ignore.
+ * \param[in] which Which ignore to set
+ * \param[in] ignore The value to set the ignore to
+ */
+  Change setIgnore(ListIgnores which, bool ignore);
+
+/** \brief Record enabled() as the state last published (EN_DBW_PREV).
+ *    DBW Enabled needs to publish when published() differs between before & after.
+ */
+  Change publish();
+
+private:
+  template<typename Update>
+  Change update(Update update);
+
+  std::atomic<uint32_t> bits_;
+};
+
+}  // namespace raptor_dbw_can
+
+#endif  // RAPTOR_DBW_CAN__DBW_STATE_HPP_
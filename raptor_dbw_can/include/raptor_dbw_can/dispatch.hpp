@@ -81,6 +81,33 @@ enum ListMessageIDs
   ID_HMI_GLOBAL_ENABLE_REPORT   = 0x3f01,   /**< HMI global enable report ID */
 };
 
+/** \brief Reports RaptorDbwCAN receives, as X(id, handler, minDlc).
+ *    Each entry declares the handler RaptorDbwCAN::handler and routes frames with
+ *    the CAN ID to it. Frames shorter than minDlc are dropped; 0 uses the DLC from
+ *    the DBC file. Adding a report takes an entry here and the handler body.
+ */
+#define RAPTOR_DBW_CAN_REPORTS(X) \
+  X(ID_BRAKE_REPORT, recvBrakeRpt, 0) \
+  X(ID_ACCEL_PEDAL_REPORT, recvAccelPedalRpt, 0) \
+  X(ID_STEERING_REPORT, recvSteeringRpt, 0) \
+  X(ID_GEAR_REPORT, recvGearRpt, 1) \
+  X(ID_REPORT_WHEEL_SPEED, recvWheelSpeedRpt, 0) \
+  X(ID_REPORT_WHEEL_POSITION, recvWheelPositionRpt, 0) \
+  X(ID_REPORT_TIRE_PRESSURE, recvTirePressureRpt, 0) \
+  X(ID_REPORT_SURROUND, recvSurroundRpt, 0) \
+  X(ID_VIN, recvVinRpt, 0) \
+  X(ID_REPORT_IMU, recvImuRpt, 0) \
+  X(ID_REPORT_DRIVER_INPUT, recvDriverInputRpt, 0) \
+  X(ID_MISC_REPORT, recvMiscRpt, 0) \
+  X(ID_LOW_VOLTAGE_SYSTEM_REPORT, recvLowVoltageSystemRpt, 0) \
+  X(ID_BRAKE_2_REPORT, recvBrake2Rpt, 0) \
+  X(ID_STEERING_2_REPORT, recvSteering2Rpt, 0) \
+  X(ID_FAULT_ACTION_REPORT, recvFaultActionRpt, 0) \
+  X(ID_OTHER_ACTUATORS_REPORT, recvOtherActuatorsRpt, 0) \
+  X(ID_GPS_REFERENCE_REPORT, recvGpsReferenceRpt, 0) \
+  X(ID_GPS_REMAINDER_REPORT, recvGpsRemainderRpt, 0) \
+  X(ID_EXIT_REPORT, recvExitRpt, 0)
+
 }  // namespace raptor_dbw_can
 
 #endif  // RAPTOR_DBW_CAN__DISPATCH_HPP_
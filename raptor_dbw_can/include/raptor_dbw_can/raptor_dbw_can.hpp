@@ -50,6 +50,7 @@
 #include <raptor_dbw_msgs/msg/driver_input_report.hpp>
 #include <raptor_dbw_msgs/msg/exit_report.hpp>
 #include <raptor_dbw_msgs/msg/fault_actions_report.hpp>
+#include <raptor_dbw_msgs/msg/fd_frame.hpp>
 #include <raptor_dbw_msgs/msg/gear_cmd.hpp>
 #include <raptor_dbw_msgs/msg/gear_report.hpp>
 #include <raptor_dbw_msgs/msg/global_enable_cmd.hpp>
@@ -77,12 +78,21 @@
 #include <can_dbc_parser/DbcSignal.hpp>
 #include <can_dbc_parser/Dbc.hpp>
 #include <can_dbc_parser/DbcBuilder.hpp>
+#include <can_dbc_parser/DbcCache.hpp>
 
+#include <atomic>
 #include <cmath>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
+#include "raptor_dbw_can/dbw_state.hpp"
 #include "raptor_dbw_can/dispatch.hpp"
+#include "raptor_dbw_can/report_message.hpp"
+#include "raptor_dbw_can/socket_can.hpp"
 
 using namespace std::chrono_literals;  // NOLINT
 
@@ -109,6 +119,7 @@ using raptor_dbw_msgs::msg::DoorState;
 using raptor_dbw_msgs::msg::DriverInputReport;
 using raptor_dbw_msgs::msg::ExitReport;
 using raptor_dbw_msgs::msg::FaultActionsReport;
+using raptor_dbw_msgs::msg::FdFrame;
 using raptor_dbw_msgs::msg::Gear;
 using raptor_dbw_msgs::msg::GearCmd;
 using raptor_dbw_msgs::msg::GearReport;
@@ -147,15 +158,12 @@ namespace raptor_dbw_can
 class RaptorDbwCAN : public rclcpp::Node
 {
 public:
-/** \brief Default constructor.
+/** \brief Default constructor. Also registered as the rclcpp component
+ *    raptor_dbw_can::RaptorDbwCAN.
+ *    Reads the dbw_dbc_file and max_steer_angle (deg) parameters.
  * \param[in] options The options for this node.
- * \param[in] dbw_dbc_file The name of the DBC file to use.
- * \param[in] max_steer_angle Maximum steering angle allowed, deg
  */
-  explicit RaptorDbwCAN(
-    const rclcpp::NodeOptions & options,
-    std::string dbw_dbc_file,
-    float max_steer_angle);
+  explicit RaptorDbwCAN(const rclcpp::NodeOptions & options);
   ~RaptorDbwCAN();
 
 private:
@@ -175,110 +183,27 @@ private:
   void recvDisable(const Empty::SharedPtr msg);
 
 /** \brief Convert reports received over CAN into ROS messages.
+ *    Frames are routed through report_dispatch_; unknown IDs are ignored.
  * \param[in] msg The message received over CAN.
  */
   void recvCAN(const Frame::SharedPtr msg);
 
-/** \brief Convert an Accel Pedal Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvAccelPedalRpt(const Frame::SharedPtr msg);
-
-/** \brief Convert a Brake Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvBrakeRpt(const Frame::SharedPtr msg);
-
-/** \brief Convert a Brake2 Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvBrake2Rpt(const Frame::SharedPtr msg);
-
-/** \brief Convert a Driver Input Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvDriverInputRpt(const Frame::SharedPtr msg);
-
-/** \brief Convert an Exit Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvExitRpt(const Frame::SharedPtr msg);
-
-/** \brief Convert a Fault Action Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvFaultActionRpt(const Frame::SharedPtr msg);
-
-/** \brief Convert a Gear Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvGearRpt(const Frame::SharedPtr msg);
-
-/** \brief Convert a GPS Reference Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
+/** \brief Convert reports received over CAN FD into ROS messages.
+ *    Payloads of up to 64 bytes are loaded into the report's DBC message whole.
+ * \param[in] msg The message received over CAN FD.
  */
-  void recvGpsReferenceRpt(const Frame::SharedPtr msg);
+  void recvCANFD(const FdFrame::SharedPtr msg);
 
-/** \brief Convert a GPS Remainder Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvGpsRemainderRpt(const Frame::SharedPtr msg);
-
-/** \brief Convert an IMU Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvImuRpt(const Frame::SharedPtr msg);
-
-/** \brief Convert a Low Voltage System Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvLowVoltageSystemRpt(const Frame::SharedPtr msg);
-
-/** \brief Convert a Misc. Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvMiscRpt(const Frame::SharedPtr msg);
-
-/** \brief Convert an Other Actuators Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvOtherActuatorsRpt(const Frame::SharedPtr msg);
-
-/** \brief Convert a Steering Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvSteeringRpt(const Frame::SharedPtr msg);
-
-/** \brief Convert a Steering2 Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvSteering2Rpt(const Frame::SharedPtr msg);
-
-/** \brief Convert a Surround Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
+/** \brief Convert a report received over CAN into a ROS message; one handler
+ *    per entry in RAPTOR_DBW_CAN_REPORTS. The VIN report is sent over several
+ *    frames and published once all of them are received.
+ * \param[in] msg The message received over CAN, already loaded into the report's
+ *    DBC message.
  */
-  void recvSurroundRpt(const Frame::SharedPtr msg);
-
-/** \brief Convert a Tire Pressure Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvTirePressureRpt(const Frame::SharedPtr msg);
-
-/** \brief Convert a VIN Report received over CAN into a ROS message. Message is sent over multiple
- *    frames & published once all data is received.
- * \param[in] msg The message received over CAN.
- */
-  void recvVinRpt(const Frame::SharedPtr msg);
-
-/** \brief Convert a Wheel Position Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvWheelPositionRpt(const Frame::SharedPtr msg);
-
-/** \brief Convert a Wheel Speed Report received over CAN into a ROS message.
- * \param[in] msg The message received over CAN.
- */
-  void recvWheelSpeedRpt(const Frame::SharedPtr msg);
+#define RAPTOR_DBW_CAN_DECLARE_REPORT(id, handler, minDlc) \
+  void handler(const Frame::SharedPtr msg);
+  RAPTOR_DBW_CAN_REPORTS(RAPTOR_DBW_CAN_DECLARE_REPORT)
+#undef RAPTOR_DBW_CAN_DECLARE_REPORT
 
 /** \brief Convert an Accelerator Pedal Command sent as a ROS message into a CAN message.
  * \param[in] msg The message to send over CAN.
@@ -320,48 +245,6 @@ private:
 
   // Other useful variables
 
-  /** \brief Enumeration of driver ignores */
-  enum ListIgnores
-  {
-    IGNORE_ACCEL = 0,  /**< Acceleration pedal ignore */
-    IGNORE_STEER,      /**< Steering ignore */
-    NUM_IGNORES   /**< Total number of driver ignores */
-  };
-
-  /** \brief Enumeration of driver overrides */
-  enum ListOverrides
-  {
-    OVR_ACCEL = 0,  /**< Acceleration pedal override */
-    OVR_BRAKE,      /**< Brake override */
-    OVR_GEAR,       /**< PRND gear override */
-    OVR_STEER,      /**< Steering override */
-    NUM_OVERRIDES   /**< Total number of driver overrides */
-  };
-
-  /** \brief Enumeration of system faults */
-  enum ListFaults
-  {
-    FAULT_ACCEL = 0,      /**< Acceleration pedal fault */
-    FAULT_BRAKE,          /**< Brake fault */
-    FAULT_STEER,          /**< Steering fault */
-    FAULT_WATCH,          /**< Watchdog fault */
-    NUM_SERIOUS_FAULTS,   /**< Total number of serious faults (disables DBW) */
-    FAULT_WATCH_BRAKES = NUM_SERIOUS_FAULTS,  /**< Watchdog braking fault */
-    FAULT_WATCH_WARN,     /**< Watchdog non-braking fault warning */
-    NUM_FAULTS            /**< Total number of system faults */
-  };
-
-  /** \brief Enumeration of system enables */
-  enum ListEnables
-  {
-    EN_ACCEL = 0,   /**< Acceleration pedal system enabled */
-    EN_BRAKE,       /**< Brake system enabled */
-    EN_STEER,       /**< Steering system enabled */
-    EN_DBW,         /**< DBW system enabled */
-    EN_DBW_PREV,    /**< DBW system previously enabled (track edge) */
-    NUM_ENABLES     /**< Total number of system enables */
-  };
-
   // Helps print warning messages
   const std::string OVR_SYSTEM[NUM_OVERRIDES] = {
     "accelerator pedal",
@@ -376,37 +259,12 @@ private:
     "watchdog"
   };
 
-  bool ignores_[NUM_IGNORES];
-  bool overrides_[NUM_OVERRIDES];
-  bool faults_[NUM_FAULTS];
-  bool enables_[NUM_ENABLES];
-
-/** \brief Check for an active fault.
- * \returns TRUE if there is any active fault, FALSE otherwise
- */
-  inline bool fault()
-  {
-    return faults_[FAULT_BRAKE] || faults_[FAULT_ACCEL] || faults_[FAULT_STEER] ||
-           faults_[FAULT_WATCH];
-  }
+  // Enable, override, fault & ignore flags, changed by the report, command &
+  // timer callbacks, which run in parallel
+  DbwState state_;
 
-/** \brief Check for an active driver override.
- * \returns TRUE if there is any active driver override, FALSE otherwise
- */
-  inline bool override () {return overrides_[OVR_BRAKE] ||
-           (!ignores_[IGNORE_ACCEL] && overrides_[OVR_ACCEL]) ||
-           (!ignores_[IGNORE_STEER] && overrides_[OVR_STEER]) || overrides_[OVR_GEAR];}
-
-/** \brief Check for an active driver override.
- * \returns TRUE if DBW is enabled && there is any active driver override, FALSE otherwise
- */
-  inline bool clear() {return enables_[EN_DBW] && override ();}
-
-/** \brief Check whether the DBW Node is in control of the vehicle.
- * \returns TRUE if DBW is enabled && there are no active faults or driver overrides,
- *          FALSE otherwise
- */
-  inline bool enabled() {return enables_[EN_DBW] && !fault() && !override ();}
+  // Orders the DBW Enabled messages when two groups publish a change at once
+  std::mutex publish_mutex_;
 
 /** \brief DBW Enabled needs to publish when its state changes.
  * \returns TRUE when DBW enable state changes, FALSE otherwise
@@ -419,12 +277,11 @@ private:
 /** \brief Disables DBW control */
   void disableSystem();
 
-  /** \brief Set the specified override
+  /** \brief Set the specified override; skipped while the command ignores the driver
    * \param[in] which_ovr Which override to set
    * \param[in] override The value to set the override to
-   * \param[in] ignore The value to skip the override
    */
-  void setOverride(ListOverrides which_ovr, bool override, bool ignore);
+  void setOverride(ListOverrides which_ovr, bool override);
 
   /** \brief Set the specified fault; these faults disable DBW control when active
    * \param[in] which_fault Which fault to set
@@ -467,7 +324,7 @@ private:
  */
   void publishJointStates(
     const rclcpp::Time stamp,
-    const SteeringReport steering);
+    const SteeringReport & steering);
 
 /** \brief Calculates & publishes joint states based on updated wheel speed report.
  *    Overloaded function.
@@ -476,7 +333,58 @@ private:
  */
   void publishJointStates(
     const rclcpp::Time stamp,
-    const WheelSpeedReport wheels);
+    const WheelSpeedReport & wheels);
+
+/** \brief Looks up every DBC message & signal used by this node once, so the
+ *    CAN callbacks do not search by name on every frame.
+ *    Throws std::runtime_error if the DBC file is missing any of them.
+ */
+  void resolveDbcSignals();
+
+/** \brief Handler for one report. Called by recvCAN once the frame has been
+ *    loaded into the report's DBC message.
+ */
+  typedef void (RaptorDbwCAN::* ReportHandler)(const Frame::SharedPtr msg);
+
+/** \brief Entry in the receive dispatch table. */
+  struct ReportDispatch
+  {
+    NewEagle::DbcMessage * message;   /**< DBC message the frame is loaded into */
+    uint8_t minDlc;                   /**< Shorter frames are dropped */
+    ReportHandler handler;            /**< Publishes the report */
+  };
+
+/** \brief Receive dispatch table, keyed by CAN ID. Filled by resolveDbcSignals
+ *    from RAPTOR_DBW_CAN_REPORTS. */
+  std::unordered_map<uint32_t, ReportDispatch> report_dispatch_;
+
+/** \brief Load a received payload into the DBC message registered for its CAN
+ *    ID and call the handler. Payloads shorter than the entry's minDlc are dropped.
+ * \param[in] msg Frame carrying the CAN ID and header; its data is not read.
+ * \param[in] data Payload, classic or CAN FD.
+ * \param[in] length Payload length in bytes, up to 64.
+ */
+  void dispatchReport(const Frame::SharedPtr msg, const uint8_t * data, size_t length);
+
+/** \brief Route received frames with the message's CAN ID to a handler.
+ * \param[in] message Pre-resolved DBC message for the report.
+ * \param[in] handler Handler to call.
+ * \param[in] minDlc Shortest frame accepted; 0 uses the DLC from the DBC file.
+ */
+  void addReportHandler(
+    NewEagle::DbcMessage * message, ReportHandler handler, uint8_t minDlc = 0);
+
+/** \brief Send frames to the bus: through SocketCAN when it is in use, and on
+ *    the can_rx topic otherwise or when mirroring.
+ * \param[in] frames Frames to send.
+ * \param[in] count Number of frames.
+ */
+  void sendFrames(const Frame * frames, size_t count);
+
+/** \brief Reads frames from SocketCAN in batches and hands them to recvCAN,
+ *    until socket_can_running_ is cleared. Runs on socket_can_thread_.
+ */
+  void socketCanLoop();
 
   // Licensing
   std::string vin_;
@@ -496,6 +404,8 @@ private:
   rclcpp::Subscription<Empty>::SharedPtr sub_enable_;
   rclcpp::Subscription<Empty>::SharedPtr sub_disable_;
   rclcpp::Subscription<Frame>::SharedPtr sub_can_;
+  rclcpp::Subscription<FdFrame>::SharedPtr sub_can_fd_;
+  Frame::SharedPtr fd_frame_;  /**< ID and header of the FD frame being dispatched */
   rclcpp::Subscription<AcceleratorPedalCmd>::SharedPtr sub_accelerator_pedal_;
   rclcpp::Subscription<BrakeCmd>::SharedPtr sub_brake_;
   rclcpp::Subscription<GearCmd>::SharedPtr sub_gear_;
@@ -528,8 +438,418 @@ private:
   rclcpp::Publisher<WheelPositionReport>::SharedPtr pub_wheel_positions_;
   rclcpp::Publisher<WheelSpeedReport>::SharedPtr pub_wheel_speeds_;
 
+  // SocketCAN transport, NULL when frames go through the can_tx/can_rx topics
+  std::unique_ptr<SocketCAN> socket_can_;
+  std::thread socket_can_thread_;
+  std::atomic<bool> socket_can_running_;
+  bool mirror_can_topics_;
+  rclcpp::Publisher<Frame>::SharedPtr pub_can_mirror_;
+
+  // Callback groups, so a burst of reports cannot hold up a command:
+  // enable/disable & commands, can_tx/can_fd_tx, and timerCallback
+  rclcpp::CallbackGroup::SharedPtr command_group_;
+  rclcpp::CallbackGroup::SharedPtr report_group_;
+  rclcpp::CallbackGroup::SharedPtr timer_group_;
+
+  // Guards the command DBC messages, shared by the commands & timerCallback.
+  // Report messages are only touched by the report group or the SocketCAN thread.
+  std::mutex command_mutex_;
+
   NewEagle::Dbc dbwDbc_;
 
+/** \brief Pre-resolved handles for the DBW_BrakeReport message */
+  struct BrakeRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_BrakeFault;
+    NewEagle::SignalHandle DBW_BrakeDriverActivity;
+    NewEagle::SignalHandle DBW_BrakePdlDriverInput;
+    NewEagle::SignalHandle DBW_BrakePdlPosnFdbck;
+    NewEagle::SignalHandle DBW_BrakeEnabled;
+    NewEagle::SignalHandle DBW_BrakeRollingCntr;
+    NewEagle::SignalHandle DBW_BrakePcntTorqueActual;
+    NewEagle::SignalHandle DBW_BrakeInterventionActv;
+    NewEagle::SignalHandle DBW_BrakeInterventionReady;
+    NewEagle::SignalHandle DBW_BrakeParkingBrkStatus;
+    NewEagle::SignalHandle DBW_BrakeCtrlType;
+  };
+
+/** \brief Pre-resolved handles for the DBW_AccelPdlReport message */
+  struct AccelPedalRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_AccelPdlFault_Ch1;
+    NewEagle::SignalHandle DBW_AccelPdlFault_Ch2;
+    NewEagle::SignalHandle DBW_AccelPdlFault;
+    NewEagle::SignalHandle DBW_AccelPdlDriverActivity;
+    NewEagle::SignalHandle DBW_AccelPdlDriverInput;
+    NewEagle::SignalHandle DBW_AccelPdlPosnFdbck;
+    NewEagle::SignalHandle DBW_AccelPdlEnabled;
+    NewEagle::SignalHandle DBW_AccelPdlIgnoreDriver;
+    NewEagle::SignalHandle DBW_AccelPcntTorqueActual;
+    NewEagle::SignalHandle DBW_AccelCtrlType;
+    NewEagle::SignalHandle DBW_AccelPdlRollingCntr;
+  };
+
+/** \brief Pre-resolved handles for the DBW_SteeringReport message */
+  struct SteeringRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_SteeringFault;
+    NewEagle::SignalHandle DBW_SteeringDriverActivity;
+    NewEagle::SignalHandle DBW_SteeringWhlAngleAct;
+    NewEagle::SignalHandle DBW_SteeringWhlAngleDes;
+    NewEagle::SignalHandle DBW_SteeringWhlPcntTrqCmd;
+    NewEagle::SignalHandle DBW_SteeringEnabled;
+    NewEagle::SignalHandle DBW_SteeringRollingCntr;
+    NewEagle::SignalHandle DBW_SteeringCtrlType;
+    NewEagle::SignalHandle DBW_OverheatPreventMode;
+    NewEagle::SignalHandle DBW_SteeringOverheatWarning;
+  };
+
+/** \brief Pre-resolved handles for the DBW_PrndReport message */
+  struct GearRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_PrndDriverActivity;
+    NewEagle::SignalHandle DBW_PrndCtrlEnabled;
+    NewEagle::SignalHandle DBW_PrndStateActual;
+    NewEagle::SignalHandle DBW_PrndFault;
+    NewEagle::SignalHandle DBW_PrndStateReject;
+    NewEagle::SignalHandle DBW_TransCurGear;
+    NewEagle::SignalHandle DBW_PrndMismatchFlash;
+  };
+
+/** \brief Pre-resolved handles for the DBW_WheelSpeedReport message */
+  struct WheelSpeedRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_WhlSpd_FL;
+    NewEagle::SignalHandle DBW_WhlSpd_FR;
+    NewEagle::SignalHandle DBW_WhlSpd_RL;
+    NewEagle::SignalHandle DBW_WhlSpd_RR;
+  };
+
+/** \brief Pre-resolved handles for the DBW_WheelPositionReport message */
+  struct WheelPositionRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_WhlPulseCnt_FL;
+    NewEagle::SignalHandle DBW_WhlPulseCnt_FR;
+    NewEagle::SignalHandle DBW_WhlPulseCnt_RL;
+    NewEagle::SignalHandle DBW_WhlPulseCnt_RR;
+    NewEagle::SignalHandle DBW_WhlPulsesPerRev;
+  };
+
+/** \brief Pre-resolved handles for the DBW_TirePressReport message */
+  struct TirePressureRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_TirePressFL;
+    NewEagle::SignalHandle DBW_TirePressFR;
+    NewEagle::SignalHandle DBW_TirePressRL;
+    NewEagle::SignalHandle DBW_TirePressRR;
+  };
+
+/** \brief Pre-resolved handles for the DBW_RadarSonar message */
+  struct SurroundRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_Reserved2;
+    NewEagle::SignalHandle DBW_SonarRearDist;
+    NewEagle::SignalHandle DBW_Reserved3;
+    NewEagle::SignalHandle DBW_SonarVld;
+    NewEagle::SignalHandle DBW_SonarArcNumRR;
+    NewEagle::SignalHandle DBW_SonarArcNumRL;
+    NewEagle::SignalHandle DBW_SonarArcNumRC;
+    NewEagle::SignalHandle DBW_SonarArcNumFR;
+    NewEagle::SignalHandle DBW_SonarArcNumFL;
+    NewEagle::SignalHandle DBW_SonarArcNumFC;
+  };
+
+/** \brief Pre-resolved handles for the DBW_VinReport message */
+  struct VinRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_VinMultiplexor;
+    NewEagle::SignalHandle DBW_VinDigit_01;
+    NewEagle::SignalHandle DBW_VinDigit_02;
+    NewEagle::SignalHandle DBW_VinDigit_03;
+    NewEagle::SignalHandle DBW_VinDigit_04;
+    NewEagle::SignalHandle DBW_VinDigit_05;
+    NewEagle::SignalHandle DBW_VinDigit_06;
+    NewEagle::SignalHandle DBW_VinDigit_07;
+    NewEagle::SignalHandle DBW_VinDigit_08;
+    NewEagle::SignalHandle DBW_VinDigit_09;
+    NewEagle::SignalHandle DBW_VinDigit_10;
+    NewEagle::SignalHandle DBW_VinDigit_11;
+    NewEagle::SignalHandle DBW_VinDigit_12;
+    NewEagle::SignalHandle DBW_VinDigit_13;
+    NewEagle::SignalHandle DBW_VinDigit_14;
+    NewEagle::SignalHandle DBW_VinDigit_15;
+    NewEagle::SignalHandle DBW_VinDigit_16;
+    NewEagle::SignalHandle DBW_VinDigit_17;
+  };
+
+/** \brief Pre-resolved handles for the DBW_ImuReport message */
+  struct ImuRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_ImuYawRate;
+    NewEagle::SignalHandle DBW_ImuAccelX;
+    NewEagle::SignalHandle DBW_ImuAccelY;
+  };
+
+/** \brief Pre-resolved handles for the DBW_DriverInputs message */
+  struct DriverInputRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_DrvInptTurnSignal;
+    NewEagle::SignalHandle DBW_DrvInptHiBeam;
+    NewEagle::SignalHandle DBW_DrvInptWiper;
+    NewEagle::SignalHandle DBW_DrvInptCruiseResumeBtn;
+    NewEagle::SignalHandle DBW_DrvInptCruiseCancelBtn;
+    NewEagle::SignalHandle DBW_DrvInptCruiseAccelBtn;
+    NewEagle::SignalHandle DBW_DrvInptCruiseDecelBtn;
+    NewEagle::SignalHandle DBW_DrvInptCruiseOnOffBtn;
+    NewEagle::SignalHandle DBW_DrvInptAccOnOffBtn;
+    NewEagle::SignalHandle DBW_DrvInptAccIncDistBtn;
+    NewEagle::SignalHandle DBW_DrvInptAccDecDistBtn;
+    NewEagle::SignalHandle DBW_DrvInputStrWhlBtnA;
+    NewEagle::SignalHandle DBW_DrvInputStrWhlBtnB;
+    NewEagle::SignalHandle DBW_DrvInputStrWhlBtnC;
+    NewEagle::SignalHandle DBW_DrvInputStrWhlBtnD;
+    NewEagle::SignalHandle DBW_DrvInputStrWhlBtnE;
+    NewEagle::SignalHandle DBW_OccupAnyDoorOrHoodAjar;
+    NewEagle::SignalHandle DBW_OccupAnyAirbagDeployed;
+    NewEagle::SignalHandle DBW_OccupAnySeatbeltUnbuckled;
+  };
+
+/** \brief Pre-resolved handles for the DBW_Misc message */
+  struct MiscRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_MiscFuelLvl;
+    NewEagle::SignalHandle DBW_MiscByWireEnabled;
+    NewEagle::SignalHandle DBW_MiscVehicleSpeed;
+    NewEagle::SignalHandle DBW_SoftwareBuildNumber;
+    NewEagle::SignalHandle DBW_MiscFault;
+    NewEagle::SignalHandle DBW_MiscByWireReady;
+    NewEagle::SignalHandle DBW_MiscDriverActivity;
+    NewEagle::SignalHandle DBW_MiscAKitCommFault;
+    NewEagle::SignalHandle DBW_AmbientTemp;
+  };
+
+/** \brief Pre-resolved handles for the DBW_LowVoltSysReport message */
+  struct LowVoltageSystemRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_LvVehBattVlt;
+    NewEagle::SignalHandle DBW_LvBattCurr;
+    NewEagle::SignalHandle DBW_LvAlternatorCurr;
+    NewEagle::SignalHandle DBW_LvDbwBattVlt;
+    NewEagle::SignalHandle DBW_LvDcdcCurr;
+    NewEagle::SignalHandle DBW_LvInvtrContactorCmd;
+  };
+
+/** \brief Pre-resolved handles for the DBW_BrakeReport2 message */
+  struct Brake2RptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_BrakePress_bar;
+    NewEagle::SignalHandle DBW_RoadSlopeEstimate;
+    NewEagle::SignalHandle DBW_SpeedSetpt;
+  };
+
+/** \brief Pre-resolved handles for the DBW_SteeringReport2 message */
+  struct Steering2RptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_SteeringVehCurvatureAct;
+    NewEagle::SignalHandle DBW_SteerTrq_Driver;
+    NewEagle::SignalHandle DBW_SteerTrq_Motor;
+    NewEagle::SignalHandle DBW_SteerTrq_DriverExpectedValue;
+  };
+
+/** \brief Pre-resolved handles for the DBW_FaultActionsReport message */
+  struct FaultActionRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_FltAct_AutonDsblNoBrakes;
+    NewEagle::SignalHandle DBW_FltAct_AutonDsblApplyBrakes;
+    NewEagle::SignalHandle DBW_FltAct_CANGatewayDsbl;
+    NewEagle::SignalHandle DBW_FltAct_InvtrCntctrDsbl;
+    NewEagle::SignalHandle DBW_FltAct_PreventEnterAutonMode;
+    NewEagle::SignalHandle DBW_FltAct_WarnDriverOnly;
+    NewEagle::SignalHandle DBW_FltAct_Chime_FcwBeeps;
+    NewEagle::SignalHandle DBW_IdxOfLastActiveFault;
+    NewEagle::SignalHandle DBW_EmgrStopBtnPrssd;
+    NewEagle::SignalHandle DBW_RemoteEmgrStopBtnPrssd;
+  };
+
+/** \brief Pre-resolved handles for the DBW_OtherActuatorsReport message */
+  struct OtherActuatorsRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_IgnitionState;
+    NewEagle::SignalHandle DBW_HornState;
+    NewEagle::SignalHandle DBW_TurnSignalState;
+    NewEagle::SignalHandle DBW_TurnSignalSyncBit;
+    NewEagle::SignalHandle DBW_HighBeamState;
+    NewEagle::SignalHandle DBW_LowBeamState;
+    NewEagle::SignalHandle DBW_FrontWiperState;
+    NewEagle::SignalHandle DBW_RearWiperState;
+    NewEagle::SignalHandle DBW_RightRearDoorState;
+    NewEagle::SignalHandle DBW_LeftRearDoorState;
+    NewEagle::SignalHandle DBW_LiftgateDoorState;
+    NewEagle::SignalHandle DBW_DoorLockState;
+  };
+
+/** \brief Pre-resolved handles for the DBW_GpsReference message */
+  struct GpsReferenceRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_GpsRefLat;
+    NewEagle::SignalHandle DBW_GpsRefLong;
+    NewEagle::SignalHandle Dbw_GpsHeading;
+  };
+
+/** \brief Pre-resolved handles for the DBW_GpsRemainder message */
+  struct GpsRemainderRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_GpsRemainderLat;
+    NewEagle::SignalHandle DBW_GpsRemainderLong;
+  };
+
+/** \brief Pre-resolved handles for the DBW_ExitReport message */
+  struct ExitRptSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle DBW_Exit_AKitDsbl;
+    NewEagle::SignalHandle DBW_Exit_DrvInCtrl;
+    NewEagle::SignalHandle DBW_Exit_AutonDsblNoBrakes;
+    NewEagle::SignalHandle DBW_Exit_AutonDsblAppyBrakes;
+    NewEagle::SignalHandle DBW_Exit_Cntr;
+  };
+
+/** \brief Pre-resolved handles for the AKit_BrakeRequest message */
+  struct BrakeCmdSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle AKit_BrakePedalReq;
+    NewEagle::SignalHandle AKit_BrakeCtrlEnblReq;
+    NewEagle::SignalHandle AKit_BrakeCtrlReqType;
+    NewEagle::SignalHandle AKit_BrakePcntTorqueReq;
+    NewEagle::SignalHandle AKit_SpeedModeDecelLim;
+    NewEagle::SignalHandle AKit_SpeedModeNegJerkLim;
+    NewEagle::SignalHandle AKit_ParkingBrkReq;
+    NewEagle::SignalHandle AKit_BrakeRollingCntr;
+    NewEagle::SignalHandle AKit_BrakeChecksum;
+  };
+
+/** \brief Pre-resolved handles for the AKit_AccelPdlRequest message */
+  struct AcceleratorPedalCmdSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle AKit_AccelPdlReq;
+    NewEagle::SignalHandle AKit_AccelPdlEnblReq;
+    NewEagle::SignalHandle Akit_AccelPdlIgnoreDriverOvrd;
+    NewEagle::SignalHandle AKit_AccelPdlRollingCntr;
+    NewEagle::SignalHandle AKit_AccelReqType;
+    NewEagle::SignalHandle AKit_AccelPcntTorqueReq;
+    NewEagle::SignalHandle AKit_AccelPdlChecksum;
+    NewEagle::SignalHandle AKit_SpeedReq;
+    NewEagle::SignalHandle AKit_SpeedModeRoadSlope;
+    NewEagle::SignalHandle AKit_SpeedModeAccelLim;
+    NewEagle::SignalHandle AKit_SpeedModePosJerkLim;
+  };
+
+/** \brief Pre-resolved handles for the AKit_SteeringRequest message */
+  struct SteeringCmdSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle AKit_SteeringWhlAngleReq;
+    NewEagle::SignalHandle AKit_SteeringWhlAngleVelocityLim;
+    NewEagle::SignalHandle AKit_SteerCtrlEnblReq;
+    NewEagle::SignalHandle AKit_SteeringWhlIgnoreDriverOvrd;
+    NewEagle::SignalHandle AKit_SteeringWhlPcntTrqReq;
+    NewEagle::SignalHandle AKit_SteeringReqType;
+    NewEagle::SignalHandle AKit_SteeringVehCurvatureReq;
+    NewEagle::SignalHandle AKit_SteeringChecksum;
+    NewEagle::SignalHandle AKit_SteerRollingCntr;
+  };
+
+/** \brief Pre-resolved handles for the AKit_PrndRequest message */
+  struct GearCmdSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle AKit_PrndCtrlEnblReq;
+    NewEagle::SignalHandle AKit_PrndStateReq;
+    NewEagle::SignalHandle AKit_PrndChecksum;
+    NewEagle::SignalHandle AKit_PrndRollingCntr;
+  };
+
+/** \brief Pre-resolved handles for the AKit_GlobalEnbl message */
+  struct GlobalEnableCmdSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle AKit_GlobalEnblRollingCntr;
+    NewEagle::SignalHandle AKit_GlobalByWireEnblReq;
+    NewEagle::SignalHandle AKit_EnblJoystickLimits;
+    NewEagle::SignalHandle AKit_SoftwareBuildNumber;
+    NewEagle::SignalHandle Akit_GlobalEnblChecksum;
+  };
+
+/** \brief Pre-resolved handles for the AKit_OtherActuators message */
+  struct MiscCmdSignals
+  {
+    NewEagle::DbcMessage * message;
+    NewEagle::SignalHandle AKit_TurnSignalReq;
+    NewEagle::SignalHandle AKit_RightRearDoorReq;
+    NewEagle::SignalHandle AKit_HighBeamReq;
+    NewEagle::SignalHandle AKit_FrontWiperReq;
+    NewEagle::SignalHandle AKit_RearWiperReq;
+    NewEagle::SignalHandle AKit_IgnitionReq;
+    NewEagle::SignalHandle AKit_LeftRearDoorReq;
+    NewEagle::SignalHandle AKit_LiftgateDoorReq;
+    NewEagle::SignalHandle AKit_BlockBasicCruiseCtrlBtns;
+    NewEagle::SignalHandle AKit_BlockAdapCruiseCtrlBtns;
+    NewEagle::SignalHandle AKit_BlockTurnSigStalkInpts;
+    NewEagle::SignalHandle AKit_OtherChecksum;
+    NewEagle::SignalHandle AKit_HornReq;
+    NewEagle::SignalHandle AKit_LowBeamReq;
+    NewEagle::SignalHandle AKit_DoorLockReq;
+    NewEagle::SignalHandle AKit_OtherRollingCntr;
+  };
+
+  BrakeRptSignals brake_rpt_signals_;
+  AccelPedalRptSignals accel_pedal_rpt_signals_;
+  SteeringRptSignals steering_rpt_signals_;
+  GearRptSignals gear_rpt_signals_;
+  WheelSpeedRptSignals wheel_speed_rpt_signals_;
+  WheelPositionRptSignals wheel_position_rpt_signals_;
+  TirePressureRptSignals tire_pressure_rpt_signals_;
+  SurroundRptSignals surround_rpt_signals_;
+  VinRptSignals vin_rpt_signals_;
+  ImuRptSignals imu_rpt_signals_;
+  DriverInputRptSignals driver_input_rpt_signals_;
+  MiscRptSignals misc_rpt_signals_;
+  LowVoltageSystemRptSignals low_voltage_system_rpt_signals_;
+  Brake2RptSignals brake2_rpt_signals_;
+  Steering2RptSignals steering2_rpt_signals_;
+  FaultActionRptSignals fault_action_rpt_signals_;
+  OtherActuatorsRptSignals other_actuators_rpt_signals_;
+  GpsReferenceRptSignals gps_reference_rpt_signals_;
+  GpsRemainderRptSignals gps_remainder_rpt_signals_;
+  ExitRptSignals exit_rpt_signals_;
+  BrakeCmdSignals brake_cmd_signals_;
+  AcceleratorPedalCmdSignals accelerator_pedal_cmd_signals_;
+  SteeringCmdSignals steering_cmd_signals_;
+  GearCmdSignals gear_cmd_signals_;
+  GlobalEnableCmdSignals global_enable_cmd_signals_;
+  MiscCmdSignals misc_cmd_signals_;
+
   // Test stuff
   rclcpp::Publisher<RelayCommand>::SharedPtr pdu1_relay_pub_;
   uint32_t count_;
@@ -0,0 +1,102 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/** \brief This file defines the ReportMessage class.
+ * \copyright Copyright 2021 New Eagle LLC
+ * \file report_message.hpp
+ */
+
+#ifndef RAPTOR_DBW_CAN__REPORT_MESSAGE_HPP_
+#define RAPTOR_DBW_CAN__REPORT_MESSAGE_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace raptor_dbw_can
+{
+/** \brief An outgoing report, filled in place and then published.
+ *    The message is borrowed from the middleware when the RMW can loan it
+ *    (shared memory transports, fixed-size message types) and nobody in this
+ *    process subscribes through intra-process comms, which do not carry
+ *    loans. Otherwise it is allocated on the heap and published as a
+ *    unique_ptr, so intra-process subscribers still take it without a copy.
+ */
+template<typename MessageT>
+class ReportMessage
+{
+public:
+/** \brief Borrow or allocate a default-constructed message.
+ * \param[in] publisher Publisher the message will go out on.
+ */
+  explicit ReportMessage(const typename rclcpp::Publisher<MessageT>::SharedPtr & publisher)
+  : publisher_(*publisher)
+  {
+    if (publisher_.can_loan_messages() &&
+      0 == publisher_.get_intra_process_subscription_count())
+    {
+      loaned_.emplace(publisher_.borrow_loaned_message());
+      message_ = &loaned_->get();
+    } else {
+      owned_ = std::make_unique<MessageT>();
+      message_ = owned_.get();
+    }
+  }
+
+  ReportMessage(const ReportMessage &) = delete;
+  ReportMessage & operator=(const ReportMessage &) = delete;
+
+  MessageT * operator->() {return message_;}
+  MessageT & operator*() {return *message_;}
+
+/** \brief TRUE if the message memory is on loan from the middleware. */
+  bool loaned() const {return loaned_.has_value();}
+
+/** \brief Publish the message. It must not be used afterwards. */
+  void publish()
+  {
+    if (loaned_) {
+      publisher_.publish(std::move(*loaned_));
+      loaned_.reset();
+    } else {
+      publisher_.publish(std::move(owned_));
+    }
+    message_ = nullptr;
+  }
+
+private:
+  rclcpp::Publisher<MessageT> & publisher_;
+  std::optional<rclcpp::LoanedMessage<MessageT>> loaned_;
+  std::unique_ptr<MessageT> owned_;
+  MessageT * message_;
+};
+}  // namespace raptor_dbw_can
+
+#endif  // RAPTOR_DBW_CAN__REPORT_MESSAGE_HPP_
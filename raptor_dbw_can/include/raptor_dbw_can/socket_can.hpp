@@ -0,0 +1,99 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/** \brief This file defines the SocketCAN class.
+ * \copyright Copyright 2021 New Eagle LLC
+ * \file socket_can.hpp
+ */
+
+#ifndef RAPTOR_DBW_CAN__SOCKET_CAN_HPP_
+#define RAPTOR_DBW_CAN__SOCKET_CAN_HPP_
+
+#include <linux/can.h>
+#include <time.h>
+
+#include <string>
+
+namespace raptor_dbw_can
+{
+/** \brief A frame read from the bus. */
+struct ReceivedFrame
+{
+  struct canfd_frame frame;   /**< Frame; len is the DLC for classic frames */
+  bool fd;                    /**< TRUE if this was a CAN FD frame */
+  struct timespec stamp;      /**< Kernel receive time (CLOCK_REALTIME) */
+};
+
+/** \brief Raw SocketCAN transport, reading and writing frames in batches. */
+class SocketCAN
+{
+public:
+/** \brief Open a raw CAN socket on a network interface.
+ *    Throws std::runtime_error if the socket cannot be opened or bound.
+ * \param[in] interface Interface name, e.g. can0 or vcan0.
+ */
+  explicit SocketCAN(const std::string & interface);
+
+/** \brief Take over an already open socket, e.g. one end of a
+ *    socketpair(AF_UNIX, SOCK_SEQPACKET) standing in for the bus.
+ *    Each record is one struct can_frame or struct canfd_frame.
+ * \param[in] fd The socket; closed by the destructor.
+ */
+  explicit SocketCAN(int fd);
+  ~SocketCAN();
+
+  SocketCAN(const SocketCAN &) = delete;
+  SocketCAN & operator=(const SocketCAN &) = delete;
+
+/** \brief Read all frames that are waiting, up to max_frames, with one recvmmsg call.
+ * \param[out] frames Received frames.
+ * \param[in] max_frames Capacity of frames.
+ * \param[in] timeout_ms How long to wait for the first frame, -1 to wait forever.
+ * \returns Number of frames read, 0 on timeout, -1 on error (see errno)
+ */
+  int receive(ReceivedFrame * frames, int max_frames, int timeout_ms);
+
+/** \brief Write classic CAN frames, up to 64 per sendmmsg call.
+ * Interrupted calls are retried, and so is a full transmit queue until no frame
+ *   has gone out for 20 ms.
+ * \param[in] frames Frames to send.
+ * \param[in] count Number of frames.
+ * \returns Number of frames written, fewer than count only if the queue stayed
+ *   full or a write failed, -1 if none were written (see errno)
+ */
+  int send(const struct can_frame * frames, int count);
+
+private:
+  void enableTimestamps();
+
+  int fd_;
+};
+
+}  // namespace raptor_dbw_can
+
+#endif  // RAPTOR_DBW_CAN__SOCKET_CAN_HPP_
@@ -0,0 +1,125 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "raptor_dbw_can/dbw_state.hpp"
+
+namespace raptor_dbw_can
+{
+
+static_assert(
+  std::atomic<uint32_t>::is_always_lock_free,
+  "DBW state is shared between callback groups without a lock");
+static_assert(NUM_ENABLES <= 8 && NUM_IGNORES <= 4 && NUM_OVERRIDES <= 4 && NUM_FAULTS <= 16,
+  "DBW state flags overlap in the state word");
+
+DbwState::DbwState()
+: bits_{Flags::bit(EN_DBW_PREV)}
+{
+}
+
+template<typename Update>
+DbwState::Change DbwState::update(Update update)
+{
+  uint32_t before = bits_.load();
+  uint32_t after;
+  do {
+    after = update(Flags(before));
+  } while (!bits_.compare_exchange_weak(before, after));
+  return Change{Flags(before), Flags(after)};
+}
+
+DbwState::Change DbwState::enable()
+{
+  return update(
+    [](Flags flags)
+    {
+      if (flags.fault()) {
+        return flags.bits();
+      }
+      return flags.bits() | Flags::bit(EN_DBW);
+    });
+}
+
+DbwState::Change DbwState::disable()
+{
+  return update([](Flags flags) {return flags.bits() & ~Flags::bit(EN_DBW);});
+}
+
+DbwState::Change DbwState::setOverride(ListOverrides which, bool override)
+{
+  return update(
+    [which, override](Flags flags)
+    {
+      uint32_t bits = flags.bits() & ~Flags::bit(which);
+      if (override) {
+        bits |= Flags::bit(which);
+        if (flags.enabled() && !flags.ignored(which)) {
+          bits &= ~Flags::bit(EN_DBW);
+        }
+      }
+      return bits;
+    });
+}
+
+DbwState::Change DbwState::setFault(ListFaults which, bool fault)
+{
+  return update(
+    [which, fault](Flags flags)
+    {
+      uint32_t bits = flags.bits() & ~Flags::bit(which);
+      if (fault) {
+        bits |= Flags::bit(which);
+        if (which < NUM_SERIOUS_FAULTS) {
+          bits &= ~Flags::bit(EN_DBW);
+        }
+      }
+      return bits;
+    });
+}
+
+DbwState::Change DbwState::setIgnore(ListIgnores which, bool ignore)
+{
+  return update(
+    [which, ignore](Flags flags)
+    {
+      uint32_t bits = flags.bits() & ~Flags::bit(which);
+      return ignore ? (bits | Flags::bit(which)) : bits;
+    });
+}
+
+DbwState::Change DbwState::publish()
+{
+  return update(
+    [](Flags flags)
+    {
+      uint32_t bits = flags.bits() & ~Flags::bit(EN_DBW_PREV);
+      return flags.enabled() ? (bits | Flags::bit(EN_DBW_PREV)) : bits;
+    });
+}
+
+}  // namespace raptor_dbw_can
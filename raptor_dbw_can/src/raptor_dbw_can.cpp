@@ -28,36 +28,25 @@
 
 #include "raptor_dbw_can/raptor_dbw_can.hpp"
 
+#include <errno.h>
+
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <stdexcept>
 #include <string>
+#include <utility>
 
 namespace raptor_dbw_can
 {
 
-RaptorDbwCAN::RaptorDbwCAN(
-  const rclcpp::NodeOptions & options,
-  std::string dbw_dbc_file,
-  float max_steer_angle)
+RaptorDbwCAN::RaptorDbwCAN(const rclcpp::NodeOptions & options)
 : Node("raptor_dbw_can_node", options),
-  dbw_dbc_file_{dbw_dbc_file},
-  max_steer_angle_{max_steer_angle}
+  dbw_dbc_file_{this->declare_parameter<std::string>("dbw_dbc_file", "")},
+  max_steer_angle_{static_cast<float>(this->declare_parameter<double>("max_steer_angle", 470.0))},
+  socket_can_running_{false},
+  mirror_can_topics_{false}
 {
-  // Initialize enable state machine
-  int i{0};
-  for (i = 0; i < NUM_ENABLES; i++) {
-    enables_[i] = (i == EN_DBW_PREV) ? true : false;
-  }
-  for (i = 0; i < NUM_OVERRIDES; i++) {
-    overrides_[i] = false;
-  }
-  for (i = 0; i < NUM_IGNORES; i++) {
-    ignores_[i] = false;
-  }
-  for (i = 0; i < NUM_FAULTS; i++) {
-    faults_[i] = false;
-  }
-
   // Frame ID
   frame_id_ = "base_footprint";
   this->declare_parameter<std::string>("frame_id", frame_id_);
@@ -132,49 +121,520 @@ RaptorDbwCAN::RaptorDbwCAN(
   pub_sys_enable_ = this->create_publisher<Bool>("dbw_enabled", 1);
   publishDbwEnabled();
 
+  // Read and write frames on a SocketCAN interface (e.g. can0) instead of
+  // going through a CAN bridge node and the can_tx/can_rx topics. The topics
+  // can still be mirrored for logging and tools.
+  std::string socketcan_interface =
+    this->declare_parameter<std::string>("socketcan_interface", "");
+  mirror_can_topics_ = this->declare_parameter<bool>("mirror_can_topics", false);
+
+  // Commands, reports and the timer each get a callback group, so with a
+  // multi-threaded executor they run in parallel.
+  command_group_ = this->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  report_group_ = this->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  timer_group_ = this->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+
+  rclcpp::SubscriptionOptions command_options;
+  command_options.callback_group = command_group_;
+  rclcpp::SubscriptionOptions report_options;
+  report_options.callback_group = report_group_;
+
   // Set up Subscribers
   sub_enable_ = this->create_subscription<Empty>(
-    "enable", 10, std::bind(&RaptorDbwCAN::recvEnable, this, std::placeholders::_1));
+    "enable", 10, std::bind(&RaptorDbwCAN::recvEnable, this, std::placeholders::_1),
+    command_options);
 
   sub_disable_ = this->create_subscription<Empty>(
-    "disable", 10, std::bind(&RaptorDbwCAN::recvDisable, this, std::placeholders::_1));
-
-  sub_can_ = this->create_subscription<Frame>(
-    "can_tx", 500, std::bind(&RaptorDbwCAN::recvCAN, this, std::placeholders::_1));
+    "disable", 10, std::bind(&RaptorDbwCAN::recvDisable, this, std::placeholders::_1),
+    command_options);
+
+  if (socketcan_interface.empty()) {
+    sub_can_ = this->create_subscription<Frame>(
+      "can_tx", 500, std::bind(&RaptorDbwCAN::recvCAN, this, std::placeholders::_1),
+      report_options);
+
+    fd_frame_ = std::make_shared<Frame>();
+    sub_can_fd_ = this->create_subscription<FdFrame>(
+      "can_fd_tx", 500, std::bind(&RaptorDbwCAN::recvCANFD, this, std::placeholders::_1),
+      report_options);
+  } else if (mirror_can_topics_) {
+    pub_can_mirror_ = this->create_publisher<Frame>("can_tx", 500);
+  }
 
   sub_brake_ = this->create_subscription<BrakeCmd>(
-    "brake_cmd", 1, std::bind(&RaptorDbwCAN::recvBrakeCmd, this, std::placeholders::_1));
+    "brake_cmd", 1, std::bind(&RaptorDbwCAN::recvBrakeCmd, this, std::placeholders::_1),
+    command_options);
 
   sub_accelerator_pedal_ = this->create_subscription<AcceleratorPedalCmd>(
     "accelerator_pedal_cmd", 1,
-    std::bind(&RaptorDbwCAN::recvAcceleratorPedalCmd, this, std::placeholders::_1));
+    std::bind(&RaptorDbwCAN::recvAcceleratorPedalCmd, this, std::placeholders::_1),
+    command_options);
 
   sub_steering_ = this->create_subscription<SteeringCmd>(
-    "steering_cmd", 1, std::bind(&RaptorDbwCAN::recvSteeringCmd, this, std::placeholders::_1));
+    "steering_cmd", 1, std::bind(&RaptorDbwCAN::recvSteeringCmd, this, std::placeholders::_1),
+    command_options);
 
   sub_gear_ = this->create_subscription<GearCmd>(
-    "gear_cmd", 1, std::bind(&RaptorDbwCAN::recvGearCmd, this, std::placeholders::_1));
+    "gear_cmd", 1, std::bind(&RaptorDbwCAN::recvGearCmd, this, std::placeholders::_1),
+    command_options);
 
   sub_misc_ = this->create_subscription<MiscCmd>(
-    "misc_cmd", 1, std::bind(&RaptorDbwCAN::recvMiscCmd, this, std::placeholders::_1));
+    "misc_cmd", 1, std::bind(&RaptorDbwCAN::recvMiscCmd, this, std::placeholders::_1),
+    command_options);
 
   sub_global_enable_ = this->create_subscription<GlobalEnableCmd>(
     "global_enable_cmd", 1,
-    std::bind(&RaptorDbwCAN::recvGlobalEnableCmd, this, std::placeholders::_1));
+    std::bind(&RaptorDbwCAN::recvGlobalEnableCmd, this, std::placeholders::_1),
+    command_options);
 
   pdu1_relay_pub_ = this->create_publisher<RelayCommand>(
     "/pduB/relay_cmd", 1000);
   count_ = 0;
 
-  dbwDbc_ = NewEagle::DbcBuilder().NewDbc(dbw_dbc_file_);
+  // Compiled copy of the DBC, rebuilt automatically when the DBC file changes.
+  // Kept under $ROS_HOME by default; an empty path disables the cache.
+  std::string dbw_dbc_cache_file =
+    this->declare_parameter<std::string>(
+    "dbw_dbc_cache_file", NewEagle::DbcCache::DefaultFile(dbw_dbc_file_));
+
+  if (dbw_dbc_cache_file.empty()) {
+    dbwDbc_ = NewEagle::DbcBuilder().NewDbc(dbw_dbc_file_);
+  } else {
+    dbwDbc_ = NewEagle::DbcBuilder().NewDbc(dbw_dbc_file_, dbw_dbc_cache_file);
+  }
+  resolveDbcSignals();
+
+  if (!socketcan_interface.empty()) {
+    socket_can_ = std::make_unique<SocketCAN>(socketcan_interface);
+    socket_can_running_ = true;
+    socket_can_thread_ = std::thread(&RaptorDbwCAN::socketCanLoop, this);
+  }
 
   // Set up Timer
   timer_ = this->create_wall_timer(
-    200ms, std::bind(&RaptorDbwCAN::timerCallback, this));
+    200ms, std::bind(&RaptorDbwCAN::timerCallback, this), timer_group_);
 }
 
 RaptorDbwCAN::~RaptorDbwCAN()
 {
+  socket_can_running_ = false;
+  if (socket_can_thread_.joinable()) {
+    socket_can_thread_.join();
+  }
+}
+
+static NewEagle::DbcMessage * requireMessage(
+  NewEagle::DbcMessage * message,
+  const std::string & name)
+{
+  if (message == NULL) {
+    throw std::runtime_error("Message " + name + " not found in DBC file");
+  }
+  return message;
+}
+
+// A DBC without the GenSigChecksumType/GenSigRollingCounter attributes leaves the
+// command handlers to fill in the counter and checksum signals themselves, as
+// they always have; say so once, since the vehicle may expect more.
+static void warnUnprotected(
+  const rclcpp::Logger & logger,
+  const NewEagle::DbcMessage * message)
+{
+  if (!message->IsChecksumDeclared() || !message->IsRollingCounterDeclared()) {
+    RCLCPP_WARN(
+      logger,
+      "%s declares no checksum or rolling counter in the DBC; sending the command's "
+      "rolling_counter and a zero checksum", message->GetName().c_str());
+  }
+}
+
+void RaptorDbwCAN::resolveDbcSignals()
+{
+  {
+    BrakeRptSignals & sig = brake_rpt_signals_;
+    sig.message = requireMessage(dbwDbc_.GetMessageById(ID_BRAKE_REPORT), "DBW_BrakeReport");
+    sig.DBW_BrakeFault = sig.message->GetSignalHandle("DBW_BrakeFault");
+    sig.DBW_BrakeDriverActivity = sig.message->GetSignalHandle("DBW_BrakeDriverActivity");
+    sig.DBW_BrakePdlDriverInput = sig.message->GetSignalHandle("DBW_BrakePdlDriverInput");
+    sig.DBW_BrakePdlPosnFdbck = sig.message->GetSignalHandle("DBW_BrakePdlPosnFdbck");
+    sig.DBW_BrakeEnabled = sig.message->GetSignalHandle("DBW_BrakeEnabled");
+    sig.DBW_BrakeRollingCntr = sig.message->GetSignalHandle("DBW_BrakeRollingCntr");
+    sig.DBW_BrakePcntTorqueActual = sig.message->GetSignalHandle("DBW_BrakePcntTorqueActual");
+    sig.DBW_BrakeInterventionActv = sig.message->GetSignalHandle("DBW_BrakeInterventionActv");
+    sig.DBW_BrakeInterventionReady = sig.message->GetSignalHandle("DBW_BrakeInterventionReady");
+    sig.DBW_BrakeParkingBrkStatus = sig.message->GetSignalHandle("DBW_BrakeParkingBrkStatus");
+    sig.DBW_BrakeCtrlType = sig.message->GetSignalHandle("DBW_BrakeCtrlType");
+  }
+
+  {
+    AccelPedalRptSignals & sig = accel_pedal_rpt_signals_;
+    sig.message = requireMessage(
+      dbwDbc_.GetMessageById(ID_ACCEL_PEDAL_REPORT), "DBW_AccelPdlReport");
+    sig.DBW_AccelPdlFault_Ch1 = sig.message->GetSignalHandle("DBW_AccelPdlFault_Ch1");
+    sig.DBW_AccelPdlFault_Ch2 = sig.message->GetSignalHandle("DBW_AccelPdlFault_Ch2");
+    sig.DBW_AccelPdlFault = sig.message->GetSignalHandle("DBW_AccelPdlFault");
+    sig.DBW_AccelPdlDriverActivity = sig.message->GetSignalHandle("DBW_AccelPdlDriverActivity");
+    sig.DBW_AccelPdlDriverInput = sig.message->GetSignalHandle("DBW_AccelPdlDriverInput");
+    sig.DBW_AccelPdlPosnFdbck = sig.message->GetSignalHandle("DBW_AccelPdlPosnFdbck");
+    sig.DBW_AccelPdlEnabled = sig.message->GetSignalHandle("DBW_AccelPdlEnabled");
+    sig.DBW_AccelPdlIgnoreDriver = sig.message->GetSignalHandle("DBW_AccelPdlIgnoreDriver");
+    sig.DBW_AccelPcntTorqueActual = sig.message->GetSignalHandle("DBW_AccelPcntTorqueActual");
+    sig.DBW_AccelCtrlType = sig.message->GetSignalHandle("DBW_AccelCtrlType");
+    sig.DBW_AccelPdlRollingCntr = sig.message->GetSignalHandle("DBW_AccelPdlRollingCntr");
+  }
+
+  {
+    SteeringRptSignals & sig = steering_rpt_signals_;
+    sig.message = requireMessage(dbwDbc_.GetMessageById(ID_STEERING_REPORT), "DBW_SteeringReport");
+    sig.DBW_SteeringFault = sig.message->GetSignalHandle("DBW_SteeringFault");
+    sig.DBW_SteeringDriverActivity = sig.message->GetSignalHandle("DBW_SteeringDriverActivity");
+    sig.DBW_SteeringWhlAngleAct = sig.message->GetSignalHandle("DBW_SteeringWhlAngleAct");
+    sig.DBW_SteeringWhlAngleDes = sig.message->GetSignalHandle("DBW_SteeringWhlAngleDes");
+    sig.DBW_SteeringWhlPcntTrqCmd = sig.message->GetSignalHandle("DBW_SteeringWhlPcntTrqCmd");
+    sig.DBW_SteeringEnabled = sig.message->GetSignalHandle("DBW_SteeringEnabled");
+    sig.DBW_SteeringRollingCntr = sig.message->GetSignalHandle("DBW_SteeringRollingCntr");
+    sig.DBW_SteeringCtrlType = sig.message->GetSignalHandle("DBW_SteeringCtrlType");
+    sig.DBW_OverheatPreventMode = sig.message->GetSignalHandle("DBW_OverheatPreventMode");
+    sig.DBW_SteeringOverheatWarning = sig.message->GetSignalHandle("DBW_SteeringOverheatWarning");
+  }
+
+  {
+    GearRptSignals & sig = gear_rpt_signals_;
+    sig.message = requireMessage(dbwDbc_.GetMessageById(ID_GEAR_REPORT), "DBW_PrndReport");
+    sig.DBW_PrndDriverActivity = sig.message->GetSignalHandle("DBW_PrndDriverActivity");
+    sig.DBW_PrndCtrlEnabled = sig.message->GetSignalHandle("DBW_PrndCtrlEnabled");
+    sig.DBW_PrndStateActual = sig.message->GetSignalHandle("DBW_PrndStateActual");
+    sig.DBW_PrndFault = sig.message->GetSignalHandle("DBW_PrndFault");
+    sig.DBW_PrndStateReject = sig.message->GetSignalHandle("DBW_PrndStateReject");
+    sig.DBW_TransCurGear = sig.message->GetSignalHandle("DBW_TransCurGear");
+    sig.DBW_PrndMismatchFlash = sig.message->GetSignalHandle("DBW_PrndMismatchFlash");
+  }
+
+  {
+    WheelSpeedRptSignals & sig = wheel_speed_rpt_signals_;
+    sig.message = requireMessage(
+      dbwDbc_.GetMessageById(ID_REPORT_WHEEL_SPEED), "DBW_WheelSpeedReport");
+    sig.DBW_WhlSpd_FL = sig.message->GetSignalHandle("DBW_WhlSpd_FL");
+    sig.DBW_WhlSpd_FR = sig.message->GetSignalHandle("DBW_WhlSpd_FR");
+    sig.DBW_WhlSpd_RL = sig.message->GetSignalHandle("DBW_WhlSpd_RL");
+    sig.DBW_WhlSpd_RR = sig.message->GetSignalHandle("DBW_WhlSpd_RR");
+  }
+
+  {
+    WheelPositionRptSignals & sig = wheel_position_rpt_signals_;
+    sig.message = requireMessage(
+      dbwDbc_.GetMessageById(ID_REPORT_WHEEL_POSITION), "DBW_WheelPositionReport");
+    sig.DBW_WhlPulseCnt_FL = sig.message->GetSignalHandle("DBW_WhlPulseCnt_FL");
+    sig.DBW_WhlPulseCnt_FR = sig.message->GetSignalHandle("DBW_WhlPulseCnt_FR");
+    sig.DBW_WhlPulseCnt_RL = sig.message->GetSignalHandle("DBW_WhlPulseCnt_RL");
+    sig.DBW_WhlPulseCnt_RR = sig.message->GetSignalHandle("DBW_WhlPulseCnt_RR");
+    sig.DBW_WhlPulsesPerRev = sig.message->GetSignalHandle("DBW_WhlPulsesPerRev");
+  }
+
+  {
+    TirePressureRptSignals & sig = tire_pressure_rpt_signals_;
+    sig.message = requireMessage(
+      dbwDbc_.GetMessageById(ID_REPORT_TIRE_PRESSURE), "DBW_TirePressReport");
+    sig.DBW_TirePressFL = sig.message->GetSignalHandle("DBW_TirePressFL");
+    sig.DBW_TirePressFR = sig.message->GetSignalHandle("DBW_TirePressFR");
+    sig.DBW_TirePressRL = sig.message->GetSignalHandle("DBW_TirePressRL");
+    sig.DBW_TirePressRR = sig.message->GetSignalHandle("DBW_TirePressRR");
+  }
+
+  {
+    SurroundRptSignals & sig = surround_rpt_signals_;
+    sig.message = requireMessage(dbwDbc_.GetMessageById(ID_REPORT_SURROUND), "DBW_RadarSonar");
+    sig.DBW_Reserved2 = sig.message->GetSignalHandle("DBW_Reserved2");
+    sig.DBW_SonarRearDist = sig.message->GetSignalHandle("DBW_SonarRearDist");
+    sig.DBW_Reserved3 = sig.message->GetSignalHandle("DBW_Reserved3");
+    sig.DBW_SonarVld = sig.message->GetSignalHandle("DBW_SonarVld");
+    sig.DBW_SonarArcNumRR = sig.message->GetSignalHandle("DBW_SonarArcNumRR");
+    sig.DBW_SonarArcNumRL = sig.message->GetSignalHandle("DBW_SonarArcNumRL");
+    sig.DBW_SonarArcNumRC = sig.message->GetSignalHandle("DBW_SonarArcNumRC");
+    sig.DBW_SonarArcNumFR = sig.message->GetSignalHandle("DBW_SonarArcNumFR");
+    sig.DBW_SonarArcNumFL = sig.message->GetSignalHandle("DBW_SonarArcNumFL");
+    sig.DBW_SonarArcNumFC = sig.message->GetSignalHandle("DBW_SonarArcNumFC");
+  }
+
+  {
+    VinRptSignals & sig = vin_rpt_signals_;
+    sig.message = requireMessage(dbwDbc_.GetMessageById(ID_VIN), "DBW_VinReport");
+    sig.DBW_VinMultiplexor = sig.message->GetSignalHandle("DBW_VinMultiplexor");
+    sig.DBW_VinDigit_01 = sig.message->GetSignalHandle("DBW_VinDigit_01");
+    sig.DBW_VinDigit_02 = sig.message->GetSignalHandle("DBW_VinDigit_02");
+    sig.DBW_VinDigit_03 = sig.message->GetSignalHandle("DBW_VinDigit_03");
+    sig.DBW_VinDigit_04 = sig.message->GetSignalHandle("DBW_VinDigit_04");
+    sig.DBW_VinDigit_05 = sig.message->GetSignalHandle("DBW_VinDigit_05");
+    sig.DBW_VinDigit_06 = sig.message->GetSignalHandle("DBW_VinDigit_06");
+    sig.DBW_VinDigit_07 = sig.message->GetSignalHandle("DBW_VinDigit_07");
+    sig.DBW_VinDigit_08 = sig.message->GetSignalHandle("DBW_VinDigit_08");
+    sig.DBW_VinDigit_09 = sig.message->GetSignalHandle("DBW_VinDigit_09");
+    sig.DBW_VinDigit_10 = sig.message->GetSignalHandle("DBW_VinDigit_10");
+    sig.DBW_VinDigit_11 = sig.message->GetSignalHandle("DBW_VinDigit_11");
+    sig.DBW_VinDigit_12 = sig.message->GetSignalHandle("DBW_VinDigit_12");
+    sig.DBW_VinDigit_13 = sig.message->GetSignalHandle("DBW_VinDigit_13");
+    sig.DBW_VinDigit_14 = sig.message->GetSignalHandle("DBW_VinDigit_14");
+    sig.DBW_VinDigit_15 = sig.message->GetSignalHandle("DBW_VinDigit_15");
+    sig.DBW_VinDigit_16 = sig.message->GetSignalHandle("DBW_VinDigit_16");
+    sig.DBW_VinDigit_17 = sig.message->GetSignalHandle("DBW_VinDigit_17");
+  }
+
+  {
+    ImuRptSignals & sig = imu_rpt_signals_;
+    sig.message = requireMessage(dbwDbc_.GetMessageById(ID_REPORT_IMU), "DBW_ImuReport");
+    sig.DBW_ImuYawRate = sig.message->GetSignalHandle("DBW_ImuYawRate");
+    sig.DBW_ImuAccelX = sig.message->GetSignalHandle("DBW_ImuAccelX");
+    sig.DBW_ImuAccelY = sig.message->GetSignalHandle("DBW_ImuAccelY");
+  }
+
+  {
+    DriverInputRptSignals & sig = driver_input_rpt_signals_;
+    sig.message = requireMessage(
+      dbwDbc_.GetMessageById(ID_REPORT_DRIVER_INPUT), "DBW_DriverInputs");
+    sig.DBW_DrvInptTurnSignal = sig.message->GetSignalHandle("DBW_DrvInptTurnSignal");
+    sig.DBW_DrvInptHiBeam = sig.message->GetSignalHandle("DBW_DrvInptHiBeam");
+    sig.DBW_DrvInptWiper = sig.message->GetSignalHandle("DBW_DrvInptWiper");
+    sig.DBW_DrvInptCruiseResumeBtn = sig.message->GetSignalHandle("DBW_DrvInptCruiseResumeBtn");
+    sig.DBW_DrvInptCruiseCancelBtn = sig.message->GetSignalHandle("DBW_DrvInptCruiseCancelBtn");
+    sig.DBW_DrvInptCruiseAccelBtn = sig.message->GetSignalHandle("DBW_DrvInptCruiseAccelBtn");
+    sig.DBW_DrvInptCruiseDecelBtn = sig.message->GetSignalHandle("DBW_DrvInptCruiseDecelBtn");
+    sig.DBW_DrvInptCruiseOnOffBtn = sig.message->GetSignalHandle("DBW_DrvInptCruiseOnOffBtn");
+    sig.DBW_DrvInptAccOnOffBtn = sig.message->GetSignalHandle("DBW_DrvInptAccOnOffBtn");
+    sig.DBW_DrvInptAccIncDistBtn = sig.message->GetSignalHandle("DBW_DrvInptAccIncDistBtn");
+    sig.DBW_DrvInptAccDecDistBtn = sig.message->GetSignalHandle("DBW_DrvInptAccDecDistBtn");
+    sig.DBW_DrvInputStrWhlBtnA = sig.message->GetSignalHandle("DBW_DrvInputStrWhlBtnA");
+    sig.DBW_DrvInputStrWhlBtnB = sig.message->GetSignalHandle("DBW_DrvInputStrWhlBtnB");
+    sig.DBW_DrvInputStrWhlBtnC = sig.message->GetSignalHandle("DBW_DrvInputStrWhlBtnC");
+    sig.DBW_DrvInputStrWhlBtnD = sig.message->GetSignalHandle("DBW_DrvInputStrWhlBtnD");
+    sig.DBW_DrvInputStrWhlBtnE = sig.message->GetSignalHandle("DBW_DrvInputStrWhlBtnE");
+    sig.DBW_OccupAnyDoorOrHoodAjar = sig.message->GetSignalHandle("DBW_OccupAnyDoorOrHoodAjar");
+    sig.DBW_OccupAnyAirbagDeployed = sig.message->GetSignalHandle("DBW_OccupAnyAirbagDeployed");
+    sig.DBW_OccupAnySeatbeltUnbuckled =
+      sig.message->GetSignalHandle("DBW_OccupAnySeatbeltUnbuckled");
+  }
+
+  {
+    MiscRptSignals & sig = misc_rpt_signals_;
+    sig.message = requireMessage(dbwDbc_.GetMessageById(ID_MISC_REPORT), "DBW_Misc");
+    sig.DBW_MiscFuelLvl = sig.message->GetSignalHandle("DBW_MiscFuelLvl");
+    sig.DBW_MiscByWireEnabled = sig.message->GetSignalHandle("DBW_MiscByWireEnabled");
+    sig.DBW_MiscVehicleSpeed = sig.message->GetSignalHandle("DBW_MiscVehicleSpeed");
+    sig.DBW_SoftwareBuildNumber = sig.message->GetSignalHandle("DBW_SoftwareBuildNumber");
+    sig.DBW_MiscFault = sig.message->GetSignalHandle("DBW_MiscFault");
+    sig.DBW_MiscByWireReady = sig.message->GetSignalHandle("DBW_MiscByWireReady");
+    sig.DBW_MiscDriverActivity = sig.message->GetSignalHandle("DBW_MiscDriverActivity");
+    sig.DBW_MiscAKitCommFault = sig.message->GetSignalHandle("DBW_MiscAKitCommFault");
+    sig.DBW_AmbientTemp = sig.message->GetSignalHandle("DBW_AmbientTemp");
+  }
+
+  {
+    LowVoltageSystemRptSignals & sig = low_voltage_system_rpt_signals_;
+    sig.message = requireMessage(
+      dbwDbc_.GetMessageById(ID_LOW_VOLTAGE_SYSTEM_REPORT), "DBW_LowVoltSysReport");
+    sig.DBW_LvVehBattVlt = sig.message->GetSignalHandle("DBW_LvVehBattVlt");
+    sig.DBW_LvBattCurr = sig.message->GetSignalHandle("DBW_LvBattCurr");
+    sig.DBW_LvAlternatorCurr = sig.message->GetSignalHandle("DBW_LvAlternatorCurr");
+    sig.DBW_LvDbwBattVlt = sig.message->GetSignalHandle("DBW_LvDbwBattVlt");
+    sig.DBW_LvDcdcCurr = sig.message->GetSignalHandle("DBW_LvDcdcCurr");
+    sig.DBW_LvInvtrContactorCmd = sig.message->GetSignalHandle("DBW_LvInvtrContactorCmd");
+  }
+
+  {
+    Brake2RptSignals & sig = brake2_rpt_signals_;
+    sig.message = requireMessage(dbwDbc_.GetMessageById(ID_BRAKE_2_REPORT), "DBW_BrakeReport2");
+    sig.DBW_BrakePress_bar = sig.message->GetSignalHandle("DBW_BrakePress_bar");
+    sig.DBW_RoadSlopeEstimate = sig.message->GetSignalHandle("DBW_RoadSlopeEstimate");
+    sig.DBW_SpeedSetpt = sig.message->GetSignalHandle("DBW_SpeedSetpt");
+  }
+
+  {
+    Steering2RptSignals & sig = steering2_rpt_signals_;
+    sig.message = requireMessage(
+      dbwDbc_.GetMessageById(ID_STEERING_2_REPORT), "DBW_SteeringReport2");
+    sig.DBW_SteeringVehCurvatureAct = sig.message->GetSignalHandle("DBW_SteeringVehCurvatureAct");
+    sig.DBW_SteerTrq_Driver = sig.message->GetSignalHandle("DBW_SteerTrq_Driver");
+    sig.DBW_SteerTrq_Motor = sig.message->GetSignalHandle("DBW_SteerTrq_Motor");
+    sig.DBW_SteerTrq_DriverExpectedValue =
+      sig.message->GetSignalHandle("DBW_SteerTrq_DriverExpectedValue");
+  }
+
+  {
+    FaultActionRptSignals & sig = fault_action_rpt_signals_;
+    sig.message = requireMessage(
+      dbwDbc_.GetMessageById(ID_FAULT_ACTION_REPORT), "DBW_FaultActionsReport");
+    sig.DBW_FltAct_AutonDsblNoBrakes = sig.message->GetSignalHandle("DBW_FltAct_AutonDsblNoBrakes");
+    sig.DBW_FltAct_AutonDsblApplyBrakes =
+      sig.message->GetSignalHandle("DBW_FltAct_AutonDsblApplyBrakes");
+    sig.DBW_FltAct_CANGatewayDsbl = sig.message->GetSignalHandle("DBW_FltAct_CANGatewayDsbl");
+    sig.DBW_FltAct_InvtrCntctrDsbl = sig.message->GetSignalHandle("DBW_FltAct_InvtrCntctrDsbl");
+    sig.DBW_FltAct_PreventEnterAutonMode =
+      sig.message->GetSignalHandle("DBW_FltAct_PreventEnterAutonMode");
+    sig.DBW_FltAct_WarnDriverOnly = sig.message->GetSignalHandle("DBW_FltAct_WarnDriverOnly");
+    sig.DBW_FltAct_Chime_FcwBeeps = sig.message->GetSignalHandle("DBW_FltAct_Chime_FcwBeeps");
+    sig.DBW_IdxOfLastActiveFault = sig.message->GetSignalHandle("DBW_IdxOfLastActiveFault");
+    sig.DBW_EmgrStopBtnPrssd = sig.message->GetSignalHandle("DBW_EmgrStopBtnPrssd");
+    sig.DBW_RemoteEmgrStopBtnPrssd = sig.message->GetSignalHandle("DBW_RemoteEmgrStopBtnPrssd");
+  }
+
+  {
+    OtherActuatorsRptSignals & sig = other_actuators_rpt_signals_;
+    sig.message = requireMessage(
+      dbwDbc_.GetMessageById(ID_OTHER_ACTUATORS_REPORT), "DBW_OtherActuatorsReport");
+    sig.DBW_IgnitionState = sig.message->GetSignalHandle("DBW_IgnitionState");
+    sig.DBW_HornState = sig.message->GetSignalHandle("DBW_HornState");
+    sig.DBW_TurnSignalState = sig.message->GetSignalHandle("DBW_TurnSignalState");
+    sig.DBW_TurnSignalSyncBit = sig.message->GetSignalHandle("DBW_TurnSignalSyncBit");
+    sig.DBW_HighBeamState = sig.message->GetSignalHandle("DBW_HighBeamState");
+    sig.DBW_LowBeamState = sig.message->GetSignalHandle("DBW_LowBeamState");
+    sig.DBW_FrontWiperState = sig.message->GetSignalHandle("DBW_FrontWiperState");
+    sig.DBW_RearWiperState = sig.message->GetSignalHandle("DBW_RearWiperState");
+    sig.DBW_RightRearDoorState = sig.message->GetSignalHandle("DBW_RightRearDoorState");
+    sig.DBW_LeftRearDoorState = sig.message->GetSignalHandle("DBW_LeftRearDoorState");
+    sig.DBW_LiftgateDoorState = sig.message->GetSignalHandle("DBW_LiftgateDoorState");
+    sig.DBW_DoorLockState = sig.message->GetSignalHandle("DBW_DoorLockState");
+  }
+
+  {
+    GpsReferenceRptSignals & sig = gps_reference_rpt_signals_;
+    sig.message = requireMessage(
+      dbwDbc_.GetMessageById(ID_GPS_REFERENCE_REPORT), "DBW_GpsReference");
+    sig.DBW_GpsRefLat = sig.message->GetSignalHandle("DBW_GpsRefLat");
+    sig.DBW_GpsRefLong = sig.message->GetSignalHandle("DBW_GpsRefLong");
+    sig.Dbw_GpsHeading = sig.message->GetSignalHandle("Dbw_GpsHeading");
+  }
+
+  {
+    GpsRemainderRptSignals & sig = gps_remainder_rpt_signals_;
+    sig.message = requireMessage(
+      dbwDbc_.GetMessageById(ID_GPS_REMAINDER_REPORT), "DBW_GpsRemainder");
+    sig.DBW_GpsRemainderLat = sig.message->GetSignalHandle("DBW_GpsRemainderLat");
+    sig.DBW_GpsRemainderLong = sig.message->GetSignalHandle("DBW_GpsRemainderLong");
+  }
+
+  {
+    ExitRptSignals & sig = exit_rpt_signals_;
+    sig.message = requireMessage(dbwDbc_.GetMessageById(ID_EXIT_REPORT), "DBW_ExitReport");
+    sig.DBW_Exit_AKitDsbl = sig.message->GetSignalHandle("DBW_Exit_AKitDsbl");
+    sig.DBW_Exit_DrvInCtrl = sig.message->GetSignalHandle("DBW_Exit_DrvInCtrl");
+    sig.DBW_Exit_AutonDsblNoBrakes = sig.message->GetSignalHandle("DBW_Exit_AutonDsblNoBrakes");
+    sig.DBW_Exit_AutonDsblAppyBrakes = sig.message->GetSignalHandle("DBW_Exit_AutonDsblAppyBrakes");
+    sig.DBW_Exit_Cntr = sig.message->GetSignalHandle("DBW_Exit_Cntr");
+  }
+
+  {
+    BrakeCmdSignals & sig = brake_cmd_signals_;
+    sig.message = requireMessage(dbwDbc_.GetMessage("AKit_BrakeRequest"), "AKit_BrakeRequest");
+    sig.AKit_BrakePedalReq = sig.message->GetSignalHandle("AKit_BrakePedalReq");
+    sig.AKit_BrakeCtrlEnblReq = sig.message->GetSignalHandle("AKit_BrakeCtrlEnblReq");
+    sig.AKit_BrakeCtrlReqType = sig.message->GetSignalHandle("AKit_BrakeCtrlReqType");
+    sig.AKit_BrakePcntTorqueReq = sig.message->GetSignalHandle("AKit_BrakePcntTorqueReq");
+    sig.AKit_SpeedModeDecelLim = sig.message->GetSignalHandle("AKit_SpeedModeDecelLim");
+    sig.AKit_SpeedModeNegJerkLim = sig.message->GetSignalHandle("AKit_SpeedModeNegJerkLim");
+    sig.AKit_ParkingBrkReq = sig.message->GetSignalHandle("AKit_ParkingBrkReq");
+    sig.AKit_BrakeRollingCntr = sig.message->GetSignalHandle("AKit_BrakeRollingCntr");
+    sig.AKit_BrakeChecksum = sig.message->GetSignalHandle("AKit_BrakeChecksum");
+    warnUnprotected(this->get_logger(), sig.message);
+  }
+
+  {
+    AcceleratorPedalCmdSignals & sig = accelerator_pedal_cmd_signals_;
+    sig.message = requireMessage(
+      dbwDbc_.GetMessage("AKit_AccelPdlRequest"), "AKit_AccelPdlRequest");
+    sig.AKit_AccelPdlReq = sig.message->GetSignalHandle("AKit_AccelPdlReq");
+    sig.AKit_AccelPdlEnblReq = sig.message->GetSignalHandle("AKit_AccelPdlEnblReq");
+    sig.Akit_AccelPdlIgnoreDriverOvrd =
+      sig.message->GetSignalHandle("Akit_AccelPdlIgnoreDriverOvrd");
+    sig.AKit_AccelPdlRollingCntr = sig.message->GetSignalHandle("AKit_AccelPdlRollingCntr");
+    sig.AKit_AccelReqType = sig.message->GetSignalHandle("AKit_AccelReqType");
+    sig.AKit_AccelPcntTorqueReq = sig.message->GetSignalHandle("AKit_AccelPcntTorqueReq");
+    sig.AKit_AccelPdlChecksum = sig.message->GetSignalHandle("AKit_AccelPdlChecksum");
+    sig.AKit_SpeedReq = sig.message->GetSignalHandle("AKit_SpeedReq");
+    sig.AKit_SpeedModeRoadSlope = sig.message->GetSignalHandle("AKit_SpeedModeRoadSlope");
+    sig.AKit_SpeedModeAccelLim = sig.message->GetSignalHandle("AKit_SpeedModeAccelLim");
+    sig.AKit_SpeedModePosJerkLim = sig.message->GetSignalHandle("AKit_SpeedModePosJerkLim");
+    warnUnprotected(this->get_logger(), sig.message);
+  }
+
+  {
+    SteeringCmdSignals & sig = steering_cmd_signals_;
+    sig.message = requireMessage(
+      dbwDbc_.GetMessage("AKit_SteeringRequest"), "AKit_SteeringRequest");
+    sig.AKit_SteeringWhlAngleReq = sig.message->GetSignalHandle("AKit_SteeringWhlAngleReq");
+    sig.AKit_SteeringWhlAngleVelocityLim =
+      sig.message->GetSignalHandle("AKit_SteeringWhlAngleVelocityLim");
+    sig.AKit_SteerCtrlEnblReq = sig.message->GetSignalHandle("AKit_SteerCtrlEnblReq");
+    sig.AKit_SteeringWhlIgnoreDriverOvrd =
+      sig.message->GetSignalHandle("AKit_SteeringWhlIgnoreDriverOvrd");
+    sig.AKit_SteeringWhlPcntTrqReq = sig.message->GetSignalHandle("AKit_SteeringWhlPcntTrqReq");
+    sig.AKit_SteeringReqType = sig.message->GetSignalHandle("AKit_SteeringReqType");
+    sig.AKit_SteeringVehCurvatureReq = sig.message->GetSignalHandle("AKit_SteeringVehCurvatureReq");
+    sig.AKit_SteeringChecksum = sig.message->GetSignalHandle("AKit_SteeringChecksum");
+    sig.AKit_SteerRollingCntr = sig.message->GetSignalHandle("AKit_SteerRollingCntr");
+    warnUnprotected(this->get_logger(), sig.message);
+  }
+
+  {
+    GearCmdSignals & sig = gear_cmd_signals_;
+    sig.message = requireMessage(dbwDbc_.GetMessage("AKit_PrndRequest"), "AKit_PrndRequest");
+    sig.AKit_PrndCtrlEnblReq = sig.message->GetSignalHandle("AKit_PrndCtrlEnblReq");
+    sig.AKit_PrndStateReq = sig.message->GetSignalHandle("AKit_PrndStateReq");
+    sig.AKit_PrndChecksum = sig.message->GetSignalHandle("AKit_PrndChecksum");
+    sig.AKit_PrndRollingCntr = sig.message->GetSignalHandle("AKit_PrndRollingCntr");
+    warnUnprotected(this->get_logger(), sig.message);
+  }
+
+  {
+    GlobalEnableCmdSignals & sig = global_enable_cmd_signals_;
+    sig.message = requireMessage(dbwDbc_.GetMessage("AKit_GlobalEnbl"), "AKit_GlobalEnbl");
+    sig.AKit_GlobalEnblRollingCntr = sig.message->GetSignalHandle("AKit_GlobalEnblRollingCntr");
+    sig.AKit_GlobalByWireEnblReq = sig.message->GetSignalHandle("AKit_GlobalByWireEnblReq");
+    sig.AKit_EnblJoystickLimits = sig.message->GetSignalHandle("AKit_EnblJoystickLimits");
+    sig.AKit_SoftwareBuildNumber = sig.message->GetSignalHandle("AKit_SoftwareBuildNumber");
+    sig.Akit_GlobalEnblChecksum = sig.message->GetSignalHandle("Akit_GlobalEnblChecksum");
+    warnUnprotected(this->get_logger(), sig.message);
+  }
+
+  {
+    MiscCmdSignals & sig = misc_cmd_signals_;
+    sig.message = requireMessage(dbwDbc_.GetMessage("AKit_OtherActuators"), "AKit_OtherActuators");
+    sig.AKit_TurnSignalReq = sig.message->GetSignalHandle("AKit_TurnSignalReq");
+    sig.AKit_RightRearDoorReq = sig.message->GetSignalHandle("AKit_RightRearDoorReq");
+    sig.AKit_HighBeamReq = sig.message->GetSignalHandle("AKit_HighBeamReq");
+    sig.AKit_FrontWiperReq = sig.message->GetSignalHandle("AKit_FrontWiperReq");
+    sig.AKit_RearWiperReq = sig.message->GetSignalHandle("AKit_RearWiperReq");
+    sig.AKit_IgnitionReq = sig.message->GetSignalHandle("AKit_IgnitionReq");
+    sig.AKit_LeftRearDoorReq = sig.message->GetSignalHandle("AKit_LeftRearDoorReq");
+    sig.AKit_LiftgateDoorReq = sig.message->GetSignalHandle("AKit_LiftgateDoorReq");
+    sig.AKit_BlockBasicCruiseCtrlBtns =
+      sig.message->GetSignalHandle("AKit_BlockBasicCruiseCtrlBtns");
+    sig.AKit_BlockAdapCruiseCtrlBtns = sig.message->GetSignalHandle("AKit_BlockAdapCruiseCtrlBtns");
+    sig.AKit_BlockTurnSigStalkInpts = sig.message->GetSignalHandle("AKit_BlockTurnSigStalkInpts");
+    sig.AKit_OtherChecksum = sig.message->GetSignalHandle("AKit_OtherChecksum");
+    sig.AKit_HornReq = sig.message->GetSignalHandle("AKit_HornReq");
+    sig.AKit_LowBeamReq = sig.message->GetSignalHandle("AKit_LowBeamReq");
+    sig.AKit_DoorLockReq = sig.message->GetSignalHandle("AKit_DoorLockReq");
+    sig.AKit_OtherRollingCntr = sig.message->GetSignalHandle("AKit_OtherRollingCntr");
+    warnUnprotected(this->get_logger(), sig.message);
+  }
+
+  static const struct
+  {
+    uint32_t id;
+    const char * name;
+    ReportHandler handler;
+    uint8_t minDlc;
+  } reports[] = {
+#define RAPTOR_DBW_CAN_REPORT_ENTRY(id, handler, minDlc) \
+  {id, #id, &RaptorDbwCAN::handler, minDlc},
+    RAPTOR_DBW_CAN_REPORTS(RAPTOR_DBW_CAN_REPORT_ENTRY)
+#undef RAPTOR_DBW_CAN_REPORT_ENTRY
+  };
+
+  for (const auto & report : reports) {
+    addReportHandler(
+      requireMessage(dbwDbc_.GetMessageById(report.id), report.name),
+      report.handler, report.minDlc);
+  }
 }
 
 void RaptorDbwCAN::recvEnable(const Empty::SharedPtr msg)
@@ -193,889 +653,871 @@ void RaptorDbwCAN::recvDisable(const Empty::SharedPtr msg)
 
 void RaptorDbwCAN::recvCAN(const Frame::SharedPtr msg)
 {
-  if (!msg->is_rtr && !msg->is_error) {
-    switch (msg->id) {
-      case ID_BRAKE_REPORT:
-        recvBrakeRpt(msg);
-        break;
-
-      case ID_ACCEL_PEDAL_REPORT:
-        recvAccelPedalRpt(msg);
-        break;
-
-      case ID_STEERING_REPORT:
-        recvSteeringRpt(msg);
-        break;
-
-      case ID_GEAR_REPORT:
-        recvGearRpt(msg);
-        break;
-
-      case ID_REPORT_WHEEL_SPEED:
-        recvWheelSpeedRpt(msg);
-        break;
-
-      case ID_REPORT_WHEEL_POSITION:
-        recvWheelPositionRpt(msg);
-        break;
-
-      case ID_REPORT_TIRE_PRESSURE:
-        recvTirePressureRpt(msg);
-        break;
-
-      case ID_REPORT_SURROUND:
-        recvSurroundRpt(msg);
-        break;
-
-      case ID_VIN:
-        recvVinRpt(msg);
-        break;
-
-      case ID_REPORT_IMU:
-        recvImuRpt(msg);
-        break;
-
-      case ID_REPORT_DRIVER_INPUT:
-        recvDriverInputRpt(msg);
-        break;
-
-      case ID_MISC_REPORT:
-        recvMiscRpt(msg);
-        break;
-
-      case ID_LOW_VOLTAGE_SYSTEM_REPORT:
-        recvLowVoltageSystemRpt(msg);
-        break;
-
-      case ID_BRAKE_2_REPORT:
-        recvBrake2Rpt(msg);
-        break;
-
-      case ID_STEERING_2_REPORT:
-        recvSteering2Rpt(msg);
-        break;
-
-      case ID_FAULT_ACTION_REPORT:
-        recvFaultActionRpt(msg);
-        break;
-
-      case ID_OTHER_ACTUATORS_REPORT:
-        recvOtherActuatorsRpt(msg);
-        break;
-
-      case ID_GPS_REFERENCE_REPORT:
-        recvGpsReferenceRpt(msg);
-        break;
-
-      case ID_GPS_REMAINDER_REPORT:
-        recvGpsRemainderRpt(msg);
-        break;
-
-      case ID_EXIT_REPORT:
-        recvExitRpt(msg);
-        break;
-
-      case ID_BRAKE_CMD:
-        break;
-      case ID_ACCELERATOR_PEDAL_CMD:
-        break;
-      case ID_STEERING_CMD:
-        break;
-      case ID_GEAR_CMD:
-        break;
-      default:
-        break;
-    }
+  if (msg->is_rtr || msg->is_error) {
+    return;
   }
+
+  dispatchReport(msg, msg->data.data(), msg->dlc);
 }
 
-void RaptorDbwCAN::recvBrakeRpt(const Frame::SharedPtr msg)
+void RaptorDbwCAN::dispatchReport(
+  const Frame::SharedPtr msg, const uint8_t * data, size_t length)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_BRAKE_REPORT);
+  auto entry = report_dispatch_.find(msg->id);
+  if (entry == report_dispatch_.end()) {
+    return;
+  }
 
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
+  const ReportDispatch & report = entry->second;
+  if (length >= report.minDlc) {
+    report.message->SetFrame(data, length);
+    (this->*report.handler)(msg);
+  }
+}
 
-    bool brakeSystemFault =
-      message->GetSignal("DBW_BrakeFault")->GetResult() ? true : false;
-    bool dbwSystemFault = brakeSystemFault;
-    bool driverActivity = message->GetSignal("DBW_BrakeDriverActivity")->GetResult() ? true : false;
+void RaptorDbwCAN::addReportHandler(
+  NewEagle::DbcMessage * message, ReportHandler handler, uint8_t minDlc)
+{
+  ReportDispatch & report = report_dispatch_[message->GetId()];
+  report.message = message;
+  report.minDlc = (0 == minDlc) ? message->GetDlc() : minDlc;
+  report.handler = handler;
+}
 
-    setFault(FAULT_BRAKE, brakeSystemFault);
-    faultWatchdog(dbwSystemFault, brakeSystemFault);
-    setOverride(OVR_BRAKE, driverActivity, false);
+void RaptorDbwCAN::recvCANFD(const FdFrame::SharedPtr msg)
+{
+  if (msg->is_error) {
+    return;
+  }
 
-    BrakeReport brakeReport;
-    brakeReport.header.stamp = msg->header.stamp;
-    brakeReport.pedal_position = message->GetSignal("DBW_BrakePdlDriverInput")->GetResult();
-    brakeReport.pedal_output = message->GetSignal("DBW_BrakePdlPosnFdbck")->GetResult();
+  // The handlers only read the ID and header from the frame; the payload, up
+  // to 64 bytes, goes to the DBC message directly.
+  fd_frame_->header = msg->header;
+  fd_frame_->id = msg->id;
+  fd_frame_->is_extended = msg->is_extended;
+  fd_frame_->dlc = static_cast<uint8_t>(std::min<size_t>(msg->len, CAN_MAX_DLEN));
 
-    brakeReport.enabled =
-      message->GetSignal("DBW_BrakeEnabled")->GetResult() ? true : false;
-    brakeReport.driver_activity = driverActivity;
+  dispatchReport(fd_frame_, msg->data.data(), std::min<size_t>(msg->len, msg->data.size()));
+}
 
-    brakeReport.fault_brake_system = brakeSystemFault;
+void RaptorDbwCAN::sendFrames(const Frame * frames, size_t count)
+{
+  if (socket_can_) {
+    static constexpr size_t BATCH = 8;
+    struct can_frame out[BATCH];
+
+    for (size_t first = 0; first < count; first += BATCH) {
+      size_t n = std::min(count - first, BATCH);
+
+      for (size_t i = 0; i < n; i++) {
+        const Frame & frame = frames[first + i];
+        memset(&out[i], 0, sizeof(out[i]));
+        out[i].can_id = frame.id;
+        if (frame.is_extended) {
+          out[i].can_id |= CAN_EFF_FLAG;
+        }
+        if (frame.is_rtr) {
+          out[i].can_id |= CAN_RTR_FLAG;
+        }
+        out[i].can_dlc = std::min<uint8_t>(frame.dlc, CAN_MAX_DLEN);
+        std::copy(frame.data.begin(), frame.data.end(), out[i].data);
+      }
 
-    brakeReport.rolling_counter = message->GetSignal("DBW_BrakeRollingCntr")->GetResult();
+      if (socket_can_->send(out, static_cast<int>(n)) != static_cast<int>(n)) {
+        RCLCPP_ERROR_THROTTLE(
+          this->get_logger(), m_clock, CLOCK_1_SEC,
+          "Unable to send on SocketCAN: %s", strerror(errno));
+      }
+    }
+  }
 
-    brakeReport.brake_torque_actual =
-      message->GetSignal("DBW_BrakePcntTorqueActual")->GetResult();
+  if (!socket_can_ || mirror_can_topics_) {
+    for (size_t i = 0; i < count; i++) {
+      pub_can_->publish(std::make_unique<Frame>(frames[i]));
+    }
+  }
+}
 
-    brakeReport.intervention_active =
-      message->GetSignal("DBW_BrakeInterventionActv")->GetResult() ? true : false;
-    brakeReport.intervention_ready =
-      message->GetSignal("DBW_BrakeInterventionReady")->GetResult() ? true : false;
+void RaptorDbwCAN::socketCanLoop()
+{
+  static constexpr int BATCH = 32;
+  ReceivedFrame received[BATCH];
 
-    brakeReport.parking_brake.status =
-      message->GetSignal("DBW_BrakeParkingBrkStatus")->GetResult();
+  // The handlers do not keep the frame, so one is reused for every read.
+  Frame::SharedPtr frame = std::make_shared<Frame>();
 
-    brakeReport.control_type.value = message->GetSignal("DBW_BrakeCtrlType")->GetResult();
+  while (socket_can_running_) {
+    // The timeout only bounds how long shutdown waits for this thread.
+    int count = socket_can_->receive(received, BATCH, 100);
 
-    pub_brake_->publish(brakeReport);
-    if (brakeSystemFault) {
-      RCLCPP_WARN_THROTTLE(
+    if (count < 0) {
+      RCLCPP_ERROR_THROTTLE(
         this->get_logger(), m_clock, CLOCK_1_SEC,
-        "Brake report received a system fault.");
+        "Unable to read from SocketCAN: %s", strerror(errno));
+      std::this_thread::sleep_for(100ms);
+      continue;
     }
-  }
-}
 
-void RaptorDbwCAN::recvAccelPedalRpt(const Frame::SharedPtr msg)
-{
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_ACCEL_PEDAL_REPORT);
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
-
-    bool faultCh1 = message->GetSignal("DBW_AccelPdlFault_Ch1")->GetResult() ? true : false;
-    bool faultCh2 = message->GetSignal("DBW_AccelPdlFault_Ch2")->GetResult() ? true : false;
-    bool accelPdlSystemFault =
-      message->GetSignal("DBW_AccelPdlFault")->GetResult() ? true : false;
-    bool dbwSystemFault = accelPdlSystemFault;
-
-    setFault(FAULT_ACCEL, faultCh1 && faultCh2);
-    faultWatchdog(dbwSystemFault, accelPdlSystemFault);
-    setOverride(
-      OVR_ACCEL, message->GetSignal("DBW_AccelPdlDriverActivity")->GetResult(),
-      ignores_[IGNORE_ACCEL]);
-
-    AcceleratorPedalReport accelPedalReprt;
-    accelPedalReprt.header.stamp = msg->header.stamp;
-    accelPedalReprt.pedal_input =
-      message->GetSignal("DBW_AccelPdlDriverInput")->GetResult();
-    accelPedalReprt.pedal_output = message->GetSignal("DBW_AccelPdlPosnFdbck")->GetResult();
-    accelPedalReprt.enabled =
-      message->GetSignal("DBW_AccelPdlEnabled")->GetResult() ? true : false;
-    accelPedalReprt.ignore_driver =
-      message->GetSignal("DBW_AccelPdlIgnoreDriver")->GetResult() ? true : false;
-    accelPedalReprt.driver_activity =
-      message->GetSignal("DBW_AccelPdlDriverActivity")->GetResult() ? true : false;
-    accelPedalReprt.torque_actual =
-      message->GetSignal("DBW_AccelPcntTorqueActual")->GetResult();
-
-    accelPedalReprt.control_type.value =
-      message->GetSignal("DBW_AccelCtrlType")->GetResult();
-
-    accelPedalReprt.rolling_counter =
-      message->GetSignal("DBW_AccelPdlRollingCntr")->GetResult();
-
-    accelPedalReprt.fault_accel_pedal_system = accelPdlSystemFault;
-
-    accelPedalReprt.fault_ch1 = faultCh1;
-    accelPedalReprt.fault_ch2 = faultCh2;
-
-    pub_accel_pedal_->publish(accelPedalReprt);
-
-    if (faultCh1 || faultCh2) {
-      RCLCPP_WARN_THROTTLE(
-        this->get_logger(), m_clock, CLOCK_1_SEC,
-        "Acclerator pedal report received a system fault.");
+    for (int i = 0; i < count; i++) {
+      const struct canfd_frame & in = received[i].frame;
+
+      size_t length = std::min<size_t>(in.len, CANFD_MAX_DLEN);
+      size_t classic = std::min<size_t>(length, CAN_MAX_DLEN);
+
+      frame->header.stamp.sec = static_cast<int32_t>(received[i].stamp.tv_sec);
+      frame->header.stamp.nanosec = static_cast<uint32_t>(received[i].stamp.tv_nsec);
+      frame->is_extended = (in.can_id & CAN_EFF_FLAG) != 0;
+      frame->is_rtr = (in.can_id & CAN_RTR_FLAG) != 0;
+      frame->is_error = (in.can_id & CAN_ERR_FLAG) != 0;
+      frame->id = in.can_id & (frame->is_extended ? CAN_EFF_MASK : CAN_SFF_MASK);
+      frame->dlc = static_cast<uint8_t>(classic);
+      frame->data.fill(0);
+      std::copy(in.data, in.data + classic, frame->data.begin());
+
+      // FD payloads go to the DBC message whole; the Frame only carries the
+      // ID and header for the handlers.
+      if (!frame->is_rtr && !frame->is_error) {
+        dispatchReport(frame, in.data, length);
+      }
+
+      // can_tx only carries classic frames.
+      if (mirror_can_topics_ && (length <= CAN_MAX_DLEN)) {
+        pub_can_mirror_->publish(std::make_unique<Frame>(*frame));
+      }
     }
   }
 }
 
-void RaptorDbwCAN::recvSteeringRpt(const Frame::SharedPtr msg)
+void RaptorDbwCAN::recvBrakeRpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_STEERING_REPORT);
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
+  const BrakeRptSignals & sig = brake_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
 
-    bool steeringSystemFault =
-      message->GetSignal("DBW_SteeringFault")->GetResult() ? true : false;
-    bool dbwSystemFault = steeringSystemFault;
-    bool driverActivity =
-      message->GetSignal("DBW_SteeringDriverActivity")->GetResult() ? true : false;
+  bool brakeSystemFault =
+    message->GetSignal(sig.DBW_BrakeFault)->GetRaw() ? true : false;
+  bool dbwSystemFault = brakeSystemFault;
+  bool driverActivity =
+    message->GetSignal(sig.DBW_BrakeDriverActivity)->GetRaw() ? true : false;
 
-    setFault(FAULT_STEER, steeringSystemFault);
-    faultWatchdog(dbwSystemFault);
-    setOverride(OVR_STEER, driverActivity, ignores_[IGNORE_STEER]);
+  setFault(FAULT_BRAKE, brakeSystemFault);
+  faultWatchdog(dbwSystemFault, brakeSystemFault);
+  setOverride(OVR_BRAKE, driverActivity);
 
-    SteeringReport steeringReport;
-    steeringReport.header.stamp = msg->header.stamp;
-    steeringReport.steering_wheel_angle =
-      message->GetSignal("DBW_SteeringWhlAngleAct")->GetResult();
-    steeringReport.steering_wheel_angle_cmd =
-      message->GetSignal("DBW_SteeringWhlAngleDes")->GetResult();
-    steeringReport.steering_wheel_torque =
-      message->GetSignal("DBW_SteeringWhlPcntTrqCmd")->GetResult() * 0.0625;
+  ReportMessage<BrakeReport> brakeReport(pub_brake_);
+  brakeReport->header.stamp = msg->header.stamp;
+  brakeReport->pedal_position = message->GetSignal(sig.DBW_BrakePdlDriverInput)->GetResult();
+  brakeReport->pedal_output = message->GetSignal(sig.DBW_BrakePdlPosnFdbck)->GetResult();
 
-    steeringReport.enabled =
-      message->GetSignal("DBW_SteeringEnabled")->GetResult() ? true : false;
-    steeringReport.driver_activity = driverActivity;
+  brakeReport->enabled =
+    message->GetSignal(sig.DBW_BrakeEnabled)->GetRaw() ? true : false;
+  brakeReport->driver_activity = driverActivity;
 
-    steeringReport.rolling_counter =
-      message->GetSignal("DBW_SteeringRollingCntr")->GetResult();
+  brakeReport->fault_brake_system = brakeSystemFault;
 
-    steeringReport.control_type.value =
-      message->GetSignal("DBW_SteeringCtrlType")->GetResult();
+  brakeReport->rolling_counter = message->GetSignal(sig.DBW_BrakeRollingCntr)->GetRaw();
 
-    steeringReport.overheat_prevention_mode =
-      message->GetSignal("DBW_OverheatPreventMode")->GetResult() ? true : false;
+  brakeReport->brake_torque_actual =
+    message->GetSignal(sig.DBW_BrakePcntTorqueActual)->GetResult();
 
-    steeringReport.steering_overheat_warning = message->GetSignal(
-      "DBW_SteeringOverheatWarning")->GetResult() ? true : false;
+  brakeReport->intervention_active =
+    message->GetSignal(sig.DBW_BrakeInterventionActv)->GetRaw() ? true : false;
+  brakeReport->intervention_ready =
+    message->GetSignal(sig.DBW_BrakeInterventionReady)->GetRaw() ? true : false;
 
-    steeringReport.fault_steering_system = steeringSystemFault;
+  brakeReport->parking_brake.status =
+    message->GetSignal(sig.DBW_BrakeParkingBrkStatus)->GetRaw();
 
-    pub_steering_->publish(steeringReport);
+  brakeReport->control_type.value = message->GetSignal(sig.DBW_BrakeCtrlType)->GetRaw();
 
-    publishJointStates(msg->header.stamp, steeringReport);
+  brakeReport.publish();
+  if (brakeSystemFault) {
+    RCLCPP_WARN_THROTTLE(
+      this->get_logger(), m_clock, CLOCK_1_SEC,
+      "Brake report received a system fault.");
+  }
+}
 
-    if (steeringSystemFault) {
-      RCLCPP_WARN_THROTTLE(
-        this->get_logger(), m_clock, CLOCK_1_SEC,
-        "Steering report received a system fault.");
-    }
+void RaptorDbwCAN::recvAccelPedalRpt(const Frame::SharedPtr msg)
+{
+  const AccelPedalRptSignals & sig = accel_pedal_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
+  bool faultCh1 = message->GetSignal(sig.DBW_AccelPdlFault_Ch1)->GetRaw() ? true : false;
+  bool faultCh2 = message->GetSignal(sig.DBW_AccelPdlFault_Ch2)->GetRaw() ? true : false;
+  bool accelPdlSystemFault =
+    message->GetSignal(sig.DBW_AccelPdlFault)->GetRaw() ? true : false;
+  bool dbwSystemFault = accelPdlSystemFault;
+
+  setFault(FAULT_ACCEL, faultCh1 && faultCh2);
+  faultWatchdog(dbwSystemFault, accelPdlSystemFault);
+  setOverride(OVR_ACCEL, message->GetSignal(sig.DBW_AccelPdlDriverActivity)->GetRaw());
+
+  ReportMessage<AcceleratorPedalReport> accelPedalReprt(pub_accel_pedal_);
+  accelPedalReprt->header.stamp = msg->header.stamp;
+  accelPedalReprt->pedal_input =
+    message->GetSignal(sig.DBW_AccelPdlDriverInput)->GetResult();
+  accelPedalReprt->pedal_output = message->GetSignal(sig.DBW_AccelPdlPosnFdbck)->GetResult();
+  accelPedalReprt->enabled =
+    message->GetSignal(sig.DBW_AccelPdlEnabled)->GetRaw() ? true : false;
+  accelPedalReprt->ignore_driver =
+    message->GetSignal(sig.DBW_AccelPdlIgnoreDriver)->GetRaw() ? true : false;
+  accelPedalReprt->driver_activity =
+    message->GetSignal(sig.DBW_AccelPdlDriverActivity)->GetRaw() ? true : false;
+  accelPedalReprt->torque_actual =
+    message->GetSignal(sig.DBW_AccelPcntTorqueActual)->GetResult();
+
+  accelPedalReprt->control_type.value =
+    message->GetSignal(sig.DBW_AccelCtrlType)->GetRaw();
+
+  accelPedalReprt->rolling_counter =
+    message->GetSignal(sig.DBW_AccelPdlRollingCntr)->GetRaw();
+
+  accelPedalReprt->fault_accel_pedal_system = accelPdlSystemFault;
+
+  accelPedalReprt->fault_ch1 = faultCh1;
+  accelPedalReprt->fault_ch2 = faultCh2;
+
+  accelPedalReprt.publish();
+
+  if (faultCh1 || faultCh2) {
+    RCLCPP_WARN_THROTTLE(
+      this->get_logger(), m_clock, CLOCK_1_SEC,
+      "Acclerator pedal report received a system fault.");
   }
 }
 
-void RaptorDbwCAN::recvGearRpt(const Frame::SharedPtr msg)
+void RaptorDbwCAN::recvSteeringRpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_GEAR_REPORT);
+  const SteeringRptSignals & sig = steering_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
+  bool steeringSystemFault =
+    message->GetSignal(sig.DBW_SteeringFault)->GetRaw() ? true : false;
+  bool dbwSystemFault = steeringSystemFault;
+  bool driverActivity =
+    message->GetSignal(sig.DBW_SteeringDriverActivity)->GetRaw() ? true : false;
 
-  if (msg->dlc >= 1) {
-    message->SetFrame(msg);
+  setFault(FAULT_STEER, steeringSystemFault);
+  faultWatchdog(dbwSystemFault);
+  setOverride(OVR_STEER, driverActivity);
 
-    bool driverActivity =
-      message->GetSignal("DBW_PrndDriverActivity")->GetResult() ? true : false;
+  ReportMessage<SteeringReport> steeringReport(pub_steering_);
+  steeringReport->header.stamp = msg->header.stamp;
+  steeringReport->steering_wheel_angle =
+    message->GetSignal(sig.DBW_SteeringWhlAngleAct)->GetResult();
+  steeringReport->steering_wheel_angle_cmd =
+    message->GetSignal(sig.DBW_SteeringWhlAngleDes)->GetResult();
+  steeringReport->steering_wheel_torque =
+    message->GetSignal(sig.DBW_SteeringWhlPcntTrqCmd)->GetResult() * 0.0625;
 
-    setOverride(OVR_GEAR, driverActivity, false);
-    GearReport out;
-    out.header.stamp = msg->header.stamp;
+  steeringReport->enabled =
+    message->GetSignal(sig.DBW_SteeringEnabled)->GetRaw() ? true : false;
+  steeringReport->driver_activity = driverActivity;
 
-    out.enabled = message->GetSignal("DBW_PrndCtrlEnabled")->GetResult() ? true : false;
-    out.state.gear = message->GetSignal("DBW_PrndStateActual")->GetResult();
-    out.driver_activity = driverActivity;
-    out.gear_select_system_fault =
-      message->GetSignal("DBW_PrndFault")->GetResult() ? true : false;
+  steeringReport->rolling_counter =
+    message->GetSignal(sig.DBW_SteeringRollingCntr)->GetRaw();
 
-    out.reject = message->GetSignal("DBW_PrndStateReject")->GetResult() ? true : false;
+  steeringReport->control_type.value =
+    message->GetSignal(sig.DBW_SteeringCtrlType)->GetRaw();
 
-    out.trans_curr_gear = message->GetSignal("DBW_TransCurGear")->GetResult();
-    out.gear_mismatch_flash =
-      message->GetSignal("DBW_PrndMismatchFlash")->GetResult() ? true : false;
+  steeringReport->overheat_prevention_mode =
+    message->GetSignal(sig.DBW_OverheatPreventMode)->GetRaw() ? true : false;
 
-    if (out.gear_mismatch_flash) {
-      std::string err_msg(
-        "ERROR - shift lever is in Park, but transmission is in Drive.");
-      err_msg = err_msg + " Please adjust the shift lever.";
-      RCLCPP_ERROR_THROTTLE(
-        this->get_logger(), m_clock, CLOCK_1_SEC, err_msg.c_str());
-    }
+  steeringReport->steering_overheat_warning = message->GetSignal(
+    sig.DBW_SteeringOverheatWarning)->GetRaw() ? true : false;
+
+  steeringReport->fault_steering_system = steeringSystemFault;
+
+  publishJointStates(msg->header.stamp, *steeringReport);
+
+  steeringReport.publish();
 
-    pub_gear_->publish(out);
+  if (steeringSystemFault) {
+    RCLCPP_WARN_THROTTLE(
+      this->get_logger(), m_clock, CLOCK_1_SEC,
+      "Steering report received a system fault.");
   }
 }
 
-void RaptorDbwCAN::recvWheelSpeedRpt(const Frame::SharedPtr msg)
+void RaptorDbwCAN::recvGearRpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_REPORT_WHEEL_SPEED);
+  const GearRptSignals & sig = gear_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
+
+  bool driverActivity =
+    message->GetSignal(sig.DBW_PrndDriverActivity)->GetRaw() ? true : false;
+
+  setOverride(OVR_GEAR, driverActivity);
+  ReportMessage<GearReport> out(pub_gear_);
+  out->header.stamp = msg->header.stamp;
 
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
+  out->enabled = message->GetSignal(sig.DBW_PrndCtrlEnabled)->GetRaw() ? true : false;
+  out->state.gear = message->GetSignal(sig.DBW_PrndStateActual)->GetRaw();
+  out->driver_activity = driverActivity;
+  out->gear_select_system_fault =
+    message->GetSignal(sig.DBW_PrndFault)->GetRaw() ? true : false;
 
-    WheelSpeedReport out;
-    out.header.stamp = msg->header.stamp;
+  out->reject = message->GetSignal(sig.DBW_PrndStateReject)->GetRaw() ? true : false;
 
-    out.front_left = message->GetSignal("DBW_WhlSpd_FL")->GetResult();
-    out.front_right = message->GetSignal("DBW_WhlSpd_FR")->GetResult();
-    out.rear_left = message->GetSignal("DBW_WhlSpd_RL")->GetResult();
-    out.rear_right = message->GetSignal("DBW_WhlSpd_RR")->GetResult();
+  out->trans_curr_gear = message->GetSignal(sig.DBW_TransCurGear)->GetRaw();
+  out->gear_mismatch_flash =
+    message->GetSignal(sig.DBW_PrndMismatchFlash)->GetRaw() ? true : false;
 
-    pub_wheel_speeds_->publish(out);
-    publishJointStates(msg->header.stamp, out);
+  if (out->gear_mismatch_flash) {
+    std::string err_msg(
+      "ERROR - shift lever is in Park, but transmission is in Drive.");
+    err_msg = err_msg + " Please adjust the shift lever.";
+    RCLCPP_ERROR_THROTTLE(
+      this->get_logger(), m_clock, CLOCK_1_SEC, err_msg.c_str());
   }
+
+  out.publish();
 }
 
-void RaptorDbwCAN::recvWheelPositionRpt(const Frame::SharedPtr msg)
+void RaptorDbwCAN::recvWheelSpeedRpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_REPORT_WHEEL_POSITION);
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
+  const WheelSpeedRptSignals & sig = wheel_speed_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
 
-    WheelPositionReport out;
-    out.header.stamp = msg->header.stamp;
-    out.front_left = message->GetSignal("DBW_WhlPulseCnt_FL")->GetResult();
-    out.front_right = message->GetSignal("DBW_WhlPulseCnt_FR")->GetResult();
-    out.rear_left = message->GetSignal("DBW_WhlPulseCnt_RL")->GetResult();
-    out.rear_right = message->GetSignal("DBW_WhlPulseCnt_RR")->GetResult();
-    out.wheel_pulses_per_rev = message->GetSignal("DBW_WhlPulsesPerRev")->GetResult();
+  ReportMessage<WheelSpeedReport> out(pub_wheel_speeds_);
+  out->header.stamp = msg->header.stamp;
 
-    pub_wheel_positions_->publish(out);
-  }
+  out->front_left = message->GetSignal(sig.DBW_WhlSpd_FL)->GetResult();
+  out->front_right = message->GetSignal(sig.DBW_WhlSpd_FR)->GetResult();
+  out->rear_left = message->GetSignal(sig.DBW_WhlSpd_RL)->GetResult();
+  out->rear_right = message->GetSignal(sig.DBW_WhlSpd_RR)->GetResult();
+
+  publishJointStates(msg->header.stamp, *out);
+  out.publish();
 }
 
-void RaptorDbwCAN::recvTirePressureRpt(const Frame::SharedPtr msg)
+void RaptorDbwCAN::recvWheelPositionRpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_REPORT_TIRE_PRESSURE);
-
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
+  const WheelPositionRptSignals & sig = wheel_position_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
+  ReportMessage<WheelPositionReport> out(pub_wheel_positions_);
+  out->header.stamp = msg->header.stamp;
+  out->front_left = message->GetSignal(sig.DBW_WhlPulseCnt_FL)->GetRaw();
+  out->front_right = message->GetSignal(sig.DBW_WhlPulseCnt_FR)->GetRaw();
+  out->rear_left = message->GetSignal(sig.DBW_WhlPulseCnt_RL)->GetRaw();
+  out->rear_right = message->GetSignal(sig.DBW_WhlPulseCnt_RR)->GetRaw();
+  out->wheel_pulses_per_rev = message->GetSignal(sig.DBW_WhlPulsesPerRev)->GetResult();
+
+  out.publish();
+}
 
-    TirePressureReport out;
-    out.header.stamp = msg->header.stamp;
-    out.front_left = message->GetSignal("DBW_TirePressFL")->GetResult();
-    out.front_right = message->GetSignal("DBW_TirePressFR")->GetResult();
-    out.rear_left = message->GetSignal("DBW_TirePressRL")->GetResult();
-    out.rear_right = message->GetSignal("DBW_TirePressRR")->GetResult();
-    pub_tire_pressure_->publish(out);
-  }
+void RaptorDbwCAN::recvTirePressureRpt(const Frame::SharedPtr msg)
+{
+  const TirePressureRptSignals & sig = tire_pressure_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
+
+  ReportMessage<TirePressureReport> out(pub_tire_pressure_);
+  out->header.stamp = msg->header.stamp;
+  out->front_left = message->GetSignal(sig.DBW_TirePressFL)->GetResult();
+  out->front_right = message->GetSignal(sig.DBW_TirePressFR)->GetResult();
+  out->rear_left = message->GetSignal(sig.DBW_TirePressRL)->GetResult();
+  out->rear_right = message->GetSignal(sig.DBW_TirePressRR)->GetResult();
+  out.publish();
 }
 
 void RaptorDbwCAN::recvSurroundRpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_REPORT_SURROUND);
-
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
+  const SurroundRptSignals & sig = surround_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
 
-    SurroundReport out;
-    out.header.stamp = msg->header.stamp;
+  ReportMessage<SurroundReport> out(pub_surround_);
+  out->header.stamp = msg->header.stamp;
 
-    out.front_radar_object_distance = message->GetSignal("DBW_Reserved2")->GetResult();
-    out.rear_radar_object_distance = message->GetSignal("DBW_SonarRearDist")->GetResult();
+  out->front_radar_object_distance = message->GetSignal(sig.DBW_Reserved2)->GetResult();
+  out->rear_radar_object_distance = message->GetSignal(sig.DBW_SonarRearDist)->GetResult();
 
-    out.front_radar_distance_valid =
-      message->GetSignal("DBW_Reserved3")->GetResult() ? true : false;
-    out.parking_sonar_data_valid =
-      message->GetSignal("DBW_SonarVld")->GetResult() ? true : false;
+  out->front_radar_distance_valid =
+    message->GetSignal(sig.DBW_Reserved3)->GetRaw() ? true : false;
+  out->parking_sonar_data_valid =
+    message->GetSignal(sig.DBW_SonarVld)->GetRaw() ? true : false;
 
-    out.rear_right.status = message->GetSignal("DBW_SonarArcNumRR")->GetResult();
-    out.rear_left.status = message->GetSignal("DBW_SonarArcNumRL")->GetResult();
-    out.rear_center.status = message->GetSignal("DBW_SonarArcNumRC")->GetResult();
+  out->rear_right.status = message->GetSignal(sig.DBW_SonarArcNumRR)->GetRaw();
+  out->rear_left.status = message->GetSignal(sig.DBW_SonarArcNumRL)->GetRaw();
+  out->rear_center.status = message->GetSignal(sig.DBW_SonarArcNumRC)->GetRaw();
 
-    out.front_right.status = message->GetSignal("DBW_SonarArcNumFR")->GetResult();
-    out.front_left.status = message->GetSignal("DBW_SonarArcNumFL")->GetResult();
-    out.front_center.status = message->GetSignal("DBW_SonarArcNumFC")->GetResult();
+  out->front_right.status = message->GetSignal(sig.DBW_SonarArcNumFR)->GetRaw();
+  out->front_left.status = message->GetSignal(sig.DBW_SonarArcNumFL)->GetRaw();
+  out->front_center.status = message->GetSignal(sig.DBW_SonarArcNumFC)->GetRaw();
 
-    pub_surround_->publish(out);
-  }
+  out.publish();
 }
 
-void RaptorDbwCAN::recvVinRpt(const Frame::SharedPtr msg)
+void RaptorDbwCAN::recvVinRpt(const Frame::SharedPtr)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_VIN);
-
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
-
-    if (message->GetSignal("DBW_VinMultiplexor")->GetResult() == VIN_MUX_VIN0) {
-      vin_.push_back(message->GetSignal("DBW_VinDigit_01")->GetResult());
-      vin_.push_back(message->GetSignal("DBW_VinDigit_02")->GetResult());
-      vin_.push_back(message->GetSignal("DBW_VinDigit_03")->GetResult());
-      vin_.push_back(message->GetSignal("DBW_VinDigit_04")->GetResult());
-      vin_.push_back(message->GetSignal("DBW_VinDigit_05")->GetResult());
-      vin_.push_back(message->GetSignal("DBW_VinDigit_06")->GetResult());
-      vin_.push_back(message->GetSignal("DBW_VinDigit_07")->GetResult());
-    } else if (message->GetSignal("DBW_VinMultiplexor")->GetResult() == VIN_MUX_VIN1) {
-      vin_.push_back(message->GetSignal("DBW_VinDigit_08")->GetResult());
-      vin_.push_back(message->GetSignal("DBW_VinDigit_09")->GetResult());
-      vin_.push_back(message->GetSignal("DBW_VinDigit_10")->GetResult());
-      vin_.push_back(message->GetSignal("DBW_VinDigit_11")->GetResult());
-      vin_.push_back(message->GetSignal("DBW_VinDigit_12")->GetResult());
-      vin_.push_back(message->GetSignal("DBW_VinDigit_13")->GetResult());
-      vin_.push_back(message->GetSignal("DBW_VinDigit_14")->GetResult());
-    } else if (message->GetSignal("DBW_VinMultiplexor")->GetResult() == VIN_MUX_VIN2) {
-      vin_.push_back(message->GetSignal("DBW_VinDigit_15")->GetResult());
-      vin_.push_back(message->GetSignal("DBW_VinDigit_16")->GetResult());
-      vin_.push_back(message->GetSignal("DBW_VinDigit_17")->GetResult());
-      String msg; msg.data = vin_;
-      pub_vin_->publish(msg);
-    }
+  const VinRptSignals & sig = vin_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
+
+  if (message->GetSignal(sig.DBW_VinMultiplexor)->GetRaw() == VIN_MUX_VIN0) {
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_01)->GetRaw());
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_02)->GetRaw());
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_03)->GetRaw());
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_04)->GetRaw());
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_05)->GetRaw());
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_06)->GetRaw());
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_07)->GetRaw());
+  } else if (message->GetSignal(sig.DBW_VinMultiplexor)->GetRaw() == VIN_MUX_VIN1) {
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_08)->GetRaw());
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_09)->GetRaw());
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_10)->GetRaw());
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_11)->GetRaw());
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_12)->GetRaw());
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_13)->GetRaw());
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_14)->GetRaw());
+  } else if (message->GetSignal(sig.DBW_VinMultiplexor)->GetRaw() == VIN_MUX_VIN2) {
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_15)->GetRaw());
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_16)->GetRaw());
+    vin_.push_back(message->GetSignal(sig.DBW_VinDigit_17)->GetRaw());
+    auto vin = std::make_unique<String>();
+    vin->data = vin_;
+    pub_vin_->publish(std::move(vin));
   }
 }
 
 void RaptorDbwCAN::recvImuRpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_REPORT_IMU);
-
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
-
-    Imu out;
-    out.header.stamp = msg->header.stamp;
-    out.header.frame_id = frame_id_;
-
-    out.angular_velocity.z =
-      static_cast<double>(message->GetSignal("DBW_ImuYawRate")->GetResult()) *
-      (M_PI / 180.0F);
-    out.linear_acceleration.x =
-      static_cast<double>(message->GetSignal("DBW_ImuAccelX")->GetResult());
-    out.linear_acceleration.y =
-      static_cast<double>(message->GetSignal("DBW_ImuAccelY")->GetResult());
-
-    pub_imu_->publish(out);
-  }
+  const ImuRptSignals & sig = imu_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
+
+  ReportMessage<Imu> out(pub_imu_);
+  out->header.stamp = msg->header.stamp;
+  out->header.frame_id = frame_id_;
+
+  out->angular_velocity.z =
+    static_cast<double>(message->GetSignal(sig.DBW_ImuYawRate)->GetResult()) *
+    (M_PI / 180.0F);
+  out->linear_acceleration.x =
+    static_cast<double>(message->GetSignal(sig.DBW_ImuAccelX)->GetResult());
+  out->linear_acceleration.y =
+    static_cast<double>(message->GetSignal(sig.DBW_ImuAccelY)->GetResult());
+
+  out.publish();
 }
 
 void RaptorDbwCAN::recvDriverInputRpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_REPORT_DRIVER_INPUT);
-
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
-
-    DriverInputReport out;
-    out.header.stamp = msg->header.stamp;
-
-    out.turn_signal.value = message->GetSignal("DBW_DrvInptTurnSignal")->GetResult();
-    out.high_beam_headlights.status = message->GetSignal("DBW_DrvInptHiBeam")->GetResult();
-    out.wiper.status = message->GetSignal("DBW_DrvInptWiper")->GetResult();
-
-    out.cruise_resume_button =
-      message->GetSignal("DBW_DrvInptCruiseResumeBtn")->GetResult() ? true : false;
-    out.cruise_cancel_button =
-      message->GetSignal("DBW_DrvInptCruiseCancelBtn")->GetResult() ? true : false;
-    out.cruise_accel_button =
-      message->GetSignal("DBW_DrvInptCruiseAccelBtn")->GetResult() ? true : false;
-    out.cruise_decel_button =
-      message->GetSignal("DBW_DrvInptCruiseDecelBtn")->GetResult() ? true : false;
-    out.cruise_on_off_button =
-      message->GetSignal("DBW_DrvInptCruiseOnOffBtn")->GetResult() ? true : false;
-
-    out.adaptive_cruise_on_off_button =
-      message->GetSignal("DBW_DrvInptAccOnOffBtn")->GetResult() ? true : false;
-    out.adaptive_cruise_increase_distance_button = message->GetSignal(
-      "DBW_DrvInptAccIncDistBtn")->GetResult() ? true : false;
-    out.adaptive_cruise_decrease_distance_button = message->GetSignal(
-      "DBW_DrvInptAccDecDistBtn")->GetResult() ? true : false;
-
-    out.steer_wheel_button_a =
-      message->GetSignal("DBW_DrvInputStrWhlBtnA")->GetResult() ? true : false;
-    out.steer_wheel_button_b =
-      message->GetSignal("DBW_DrvInputStrWhlBtnB")->GetResult() ? true : false;
-    out.steer_wheel_button_c =
-      message->GetSignal("DBW_DrvInputStrWhlBtnC")->GetResult() ? true : false;
-    out.steer_wheel_button_d =
-      message->GetSignal("DBW_DrvInputStrWhlBtnD")->GetResult() ? true : false;
-    out.steer_wheel_button_e =
-      message->GetSignal("DBW_DrvInputStrWhlBtnE")->GetResult() ? true : false;
-
-    out.door_or_hood_ajar =
-      message->GetSignal("DBW_OccupAnyDoorOrHoodAjar")->GetResult() ? true : false;
-
-    out.airbag_deployed =
-      message->GetSignal("DBW_OccupAnyAirbagDeployed")->GetResult() ? true : false;
-    out.any_seatbelt_unbuckled =
-      message->GetSignal("DBW_OccupAnySeatbeltUnbuckled")->GetResult() ? true : false;
-
-    pub_driver_input_->publish(out);
-  }
+  const DriverInputRptSignals & sig = driver_input_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
+
+  ReportMessage<DriverInputReport> out(pub_driver_input_);
+  out->header.stamp = msg->header.stamp;
+
+  out->turn_signal.value = message->GetSignal(sig.DBW_DrvInptTurnSignal)->GetRaw();
+  out->high_beam_headlights.status = message->GetSignal(sig.DBW_DrvInptHiBeam)->GetRaw();
+  out->wiper.status = message->GetSignal(sig.DBW_DrvInptWiper)->GetRaw();
+
+  out->cruise_resume_button =
+    message->GetSignal(sig.DBW_DrvInptCruiseResumeBtn)->GetRaw() ? true : false;
+  out->cruise_cancel_button =
+    message->GetSignal(sig.DBW_DrvInptCruiseCancelBtn)->GetRaw() ? true : false;
+  out->cruise_accel_button =
+    message->GetSignal(sig.DBW_DrvInptCruiseAccelBtn)->GetRaw() ? true : false;
+  out->cruise_decel_button =
+    message->GetSignal(sig.DBW_DrvInptCruiseDecelBtn)->GetRaw() ? true : false;
+  out->cruise_on_off_button =
+    message->GetSignal(sig.DBW_DrvInptCruiseOnOffBtn)->GetRaw() ? true : false;
+
+  out->adaptive_cruise_on_off_button =
+    message->GetSignal(sig.DBW_DrvInptAccOnOffBtn)->GetRaw() ? true : false;
+  out->adaptive_cruise_increase_distance_button = message->GetSignal(
+    sig.DBW_DrvInptAccIncDistBtn)->GetRaw() ? true : false;
+  out->adaptive_cruise_decrease_distance_button = message->GetSignal(
+    sig.DBW_DrvInptAccDecDistBtn)->GetRaw() ? true : false;
+
+  out->steer_wheel_button_a =
+    message->GetSignal(sig.DBW_DrvInputStrWhlBtnA)->GetRaw() ? true : false;
+  out->steer_wheel_button_b =
+    message->GetSignal(sig.DBW_DrvInputStrWhlBtnB)->GetRaw() ? true : false;
+  out->steer_wheel_button_c =
+    message->GetSignal(sig.DBW_DrvInputStrWhlBtnC)->GetRaw() ? true : false;
+  out->steer_wheel_button_d =
+    message->GetSignal(sig.DBW_DrvInputStrWhlBtnD)->GetRaw() ? true : false;
+  out->steer_wheel_button_e =
+    message->GetSignal(sig.DBW_DrvInputStrWhlBtnE)->GetRaw() ? true : false;
+
+  out->door_or_hood_ajar =
+    message->GetSignal(sig.DBW_OccupAnyDoorOrHoodAjar)->GetRaw() ? true : false;
+
+  out->airbag_deployed =
+    message->GetSignal(sig.DBW_OccupAnyAirbagDeployed)->GetRaw() ? true : false;
+  out->any_seatbelt_unbuckled =
+    message->GetSignal(sig.DBW_OccupAnySeatbeltUnbuckled)->GetRaw() ? true : false;
+
+  out.publish();
 }
 
 void RaptorDbwCAN::recvMiscRpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_MISC_REPORT);
-
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
-
-    MiscReport out;
-    out.header.stamp = msg->header.stamp;
-
-    out.fuel_level =
-      static_cast<double>(message->GetSignal("DBW_MiscFuelLvl")->GetResult());
-    out.drive_by_wire_enabled =
-      static_cast<bool>(message->GetSignal("DBW_MiscByWireEnabled")->GetResult());
-    out.vehicle_speed =
-      static_cast<double>(message->GetSignal("DBW_MiscVehicleSpeed")->GetResult());
-    out.software_build_number =
-      message->GetSignal("DBW_SoftwareBuildNumber")->GetResult();
-    out.general_actuator_fault =
-      message->GetSignal("DBW_MiscFault")->GetResult() ? true : false;
-    out.by_wire_ready =
-      message->GetSignal("DBW_MiscByWireReady")->GetResult() ? true : false;
-    out.general_driver_activity =
-      message->GetSignal("DBW_MiscDriverActivity")->GetResult() ? true : false;
-    out.comms_fault =
-      message->GetSignal("DBW_MiscAKitCommFault")->GetResult() ? true : false;
-    out.ambient_temp =
-      static_cast<double>(message->GetSignal("DBW_AmbientTemp")->GetResult());
-
-    pub_misc_->publish(out);
-  }
+  const MiscRptSignals & sig = misc_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
+
+  ReportMessage<MiscReport> out(pub_misc_);
+  out->header.stamp = msg->header.stamp;
+
+  out->fuel_level =
+    static_cast<double>(message->GetSignal(sig.DBW_MiscFuelLvl)->GetResult());
+  out->drive_by_wire_enabled =
+    static_cast<bool>(message->GetSignal(sig.DBW_MiscByWireEnabled)->GetRaw());
+  out->vehicle_speed =
+    static_cast<double>(message->GetSignal(sig.DBW_MiscVehicleSpeed)->GetResult());
+  out->software_build_number =
+    message->GetSignal(sig.DBW_SoftwareBuildNumber)->GetRaw();
+  out->general_actuator_fault =
+    message->GetSignal(sig.DBW_MiscFault)->GetRaw() ? true : false;
+  out->by_wire_ready =
+    message->GetSignal(sig.DBW_MiscByWireReady)->GetRaw() ? true : false;
+  out->general_driver_activity =
+    message->GetSignal(sig.DBW_MiscDriverActivity)->GetRaw() ? true : false;
+  out->comms_fault =
+    message->GetSignal(sig.DBW_MiscAKitCommFault)->GetRaw() ? true : false;
+  out->ambient_temp =
+    static_cast<double>(message->GetSignal(sig.DBW_AmbientTemp)->GetResult());
+
+  out.publish();
 }
 
 void RaptorDbwCAN::recvLowVoltageSystemRpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_LOW_VOLTAGE_SYSTEM_REPORT);
-
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
+  const LowVoltageSystemRptSignals & sig = low_voltage_system_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
 
-    LowVoltageSystemReport lvSystemReport;
-    lvSystemReport.header.stamp = msg->header.stamp;
+  ReportMessage<LowVoltageSystemReport> lvSystemReport(pub_low_voltage_system_);
+  lvSystemReport->header.stamp = msg->header.stamp;
 
-    lvSystemReport.vehicle_battery_volts =
-      static_cast<double>(message->GetSignal("DBW_LvVehBattVlt")->GetResult());
-    lvSystemReport.vehicle_battery_current =
-      static_cast<double>(message->GetSignal("DBW_LvBattCurr")->GetResult());
-    lvSystemReport.vehicle_alternator_current =
-      static_cast<double>(message->GetSignal("DBW_LvAlternatorCurr")->GetResult());
+  lvSystemReport->vehicle_battery_volts =
+    static_cast<double>(message->GetSignal(sig.DBW_LvVehBattVlt)->GetResult());
+  lvSystemReport->vehicle_battery_current =
+    static_cast<double>(message->GetSignal(sig.DBW_LvBattCurr)->GetResult());
+  lvSystemReport->vehicle_alternator_current =
+    static_cast<double>(message->GetSignal(sig.DBW_LvAlternatorCurr)->GetResult());
 
-    lvSystemReport.dbw_battery_volts =
-      static_cast<double>(message->GetSignal("DBW_LvDbwBattVlt")->GetResult());
-    lvSystemReport.dcdc_current =
-      static_cast<double>(message->GetSignal("DBW_LvDcdcCurr")->GetResult());
+  lvSystemReport->dbw_battery_volts =
+    static_cast<double>(message->GetSignal(sig.DBW_LvDbwBattVlt)->GetResult());
+  lvSystemReport->dcdc_current =
+    static_cast<double>(message->GetSignal(sig.DBW_LvDcdcCurr)->GetResult());
 
-    lvSystemReport.aux_inverter_contactor =
-      message->GetSignal("DBW_LvInvtrContactorCmd")->GetResult() ? true : false;
+  lvSystemReport->aux_inverter_contactor =
+    message->GetSignal(sig.DBW_LvInvtrContactorCmd)->GetRaw() ? true : false;
 
-    pub_low_voltage_system_->publish(lvSystemReport);
-  }
+  lvSystemReport.publish();
 }
 
 void RaptorDbwCAN::recvBrake2Rpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_BRAKE_2_REPORT);
+  const Brake2RptSignals & sig = brake2_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
 
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
+  ReportMessage<Brake2Report> brake2Report(pub_brake_2_report_);
+  brake2Report->header.stamp = msg->header.stamp;
 
-    Brake2Report brake2Report;
-    brake2Report.header.stamp = msg->header.stamp;
+  brake2Report->brake_pressure = message->GetSignal(sig.DBW_BrakePress_bar)->GetResult();
 
-    brake2Report.brake_pressure = message->GetSignal("DBW_BrakePress_bar")->GetResult();
+  brake2Report->estimated_road_slope =
+    message->GetSignal(sig.DBW_RoadSlopeEstimate)->GetResult();
 
-    brake2Report.estimated_road_slope =
-      message->GetSignal("DBW_RoadSlopeEstimate")->GetResult();
+  brake2Report->speed_set_point = message->GetSignal(sig.DBW_SpeedSetpt)->GetResult();
 
-    brake2Report.speed_set_point = message->GetSignal("DBW_SpeedSetpt")->GetResult();
-
-    pub_brake_2_report_->publish(brake2Report);
-  }
+  brake2Report.publish();
 }
 
 void RaptorDbwCAN::recvSteering2Rpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_STEERING_2_REPORT);
-
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
+  const Steering2RptSignals & sig = steering2_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
 
-    Steering2Report steering2Report;
-    steering2Report.header.stamp = msg->header.stamp;
+  ReportMessage<Steering2Report> steering2Report(pub_steering_2_report_);
+  steering2Report->header.stamp = msg->header.stamp;
 
-    steering2Report.vehicle_curvature_actual = message->GetSignal(
-      "DBW_SteeringVehCurvatureAct")->GetResult();
+  steering2Report->vehicle_curvature_actual = message->GetSignal(
+    sig.DBW_SteeringVehCurvatureAct)->GetResult();
 
-    steering2Report.max_torque_driver =
-      message->GetSignal("DBW_SteerTrq_Driver")->GetResult();
+  steering2Report->max_torque_driver =
+    message->GetSignal(sig.DBW_SteerTrq_Driver)->GetResult();
 
-    steering2Report.max_torque_motor =
-      message->GetSignal("DBW_SteerTrq_Motor")->GetResult();
+  steering2Report->max_torque_motor =
+    message->GetSignal(sig.DBW_SteerTrq_Motor)->GetResult();
 
-    steering2Report.expect_torque_driver =
-      message->GetSignal("DBW_SteerTrq_DriverExpectedValue")->GetResult();
+  steering2Report->expect_torque_driver =
+    message->GetSignal(sig.DBW_SteerTrq_DriverExpectedValue)->GetResult();
 
-    pub_steering_2_report_->publish(steering2Report);
-  }
+  steering2Report.publish();
 }
 
 void RaptorDbwCAN::recvFaultActionRpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_FAULT_ACTION_REPORT);
-
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
-
-    FaultActionsReport faultActionsReport;
-    faultActionsReport.header.stamp = msg->header.stamp;
-
-    faultActionsReport.autonomous_disabled_no_brakes = message->GetSignal(
-      "DBW_FltAct_AutonDsblNoBrakes")->GetResult();
-
-    faultActionsReport.autonomous_disabled_apply_brakes = message->GetSignal(
-      "DBW_FltAct_AutonDsblApplyBrakes")->GetResult();
-    faultActionsReport.can_gateway_disabled =
-      message->GetSignal("DBW_FltAct_CANGatewayDsbl")->GetResult();
-    faultActionsReport.inverter_contactor_disabled = message->GetSignal(
-      "DBW_FltAct_InvtrCntctrDsbl")->GetResult();
-    faultActionsReport.prevent_enter_autonomous_mode = message->GetSignal(
-      "DBW_FltAct_PreventEnterAutonMode")->GetResult();
-    faultActionsReport.warn_driver_only =
-      message->GetSignal("DBW_FltAct_WarnDriverOnly")->GetResult();
-    faultActionsReport.chime_fcw_beeps =
-      message->GetSignal("DBW_FltAct_Chime_FcwBeeps")->GetResult();
-    faultActionsReport.last_active_fault_idx =
-      message->GetSignal("DBW_IdxOfLastActiveFault")->GetResult();
-    faultActionsReport.estop_btn_pressed =
-      message->GetSignal("DBW_EmgrStopBtnPrssd")->GetResult();
-    faultActionsReport.remote_estop_btn_pressed.value =
-      message->GetSignal("DBW_RemoteEmgrStopBtnPrssd")->GetResult();
-
-    pub_fault_actions_report_->publish(faultActionsReport);
-  }
+  const FaultActionRptSignals & sig = fault_action_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
+
+  ReportMessage<FaultActionsReport> faultActionsReport(pub_fault_actions_report_);
+  faultActionsReport->header.stamp = msg->header.stamp;
+
+  faultActionsReport->autonomous_disabled_no_brakes = message->GetSignal(
+    sig.DBW_FltAct_AutonDsblNoBrakes)->GetRaw();
+
+  faultActionsReport->autonomous_disabled_apply_brakes = message->GetSignal(
+    sig.DBW_FltAct_AutonDsblApplyBrakes)->GetRaw();
+  faultActionsReport->can_gateway_disabled =
+    message->GetSignal(sig.DBW_FltAct_CANGatewayDsbl)->GetRaw();
+  faultActionsReport->inverter_contactor_disabled = message->GetSignal(
+    sig.DBW_FltAct_InvtrCntctrDsbl)->GetRaw();
+  faultActionsReport->prevent_enter_autonomous_mode = message->GetSignal(
+    sig.DBW_FltAct_PreventEnterAutonMode)->GetRaw();
+  faultActionsReport->warn_driver_only =
+    message->GetSignal(sig.DBW_FltAct_WarnDriverOnly)->GetRaw();
+  faultActionsReport->chime_fcw_beeps =
+    message->GetSignal(sig.DBW_FltAct_Chime_FcwBeeps)->GetRaw();
+  faultActionsReport->last_active_fault_idx =
+    message->GetSignal(sig.DBW_IdxOfLastActiveFault)->GetRaw();
+  faultActionsReport->estop_btn_pressed =
+    message->GetSignal(sig.DBW_EmgrStopBtnPrssd)->GetRaw();
+  faultActionsReport->remote_estop_btn_pressed.value =
+    message->GetSignal(sig.DBW_RemoteEmgrStopBtnPrssd)->GetRaw();
+
+  faultActionsReport.publish();
 }
 
 void RaptorDbwCAN::recvOtherActuatorsRpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_OTHER_ACTUATORS_REPORT);
-
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
-
-    OtherActuatorsReport out;
-    out.header.stamp = msg->header.stamp;
-
-    out.ignition_state.status = message->GetSignal(
-      "DBW_IgnitionState")->GetResult();
-    out.horn_state.status = message->GetSignal(
-      "DBW_HornState")->GetResult();
-
-    out.turn_signal_state.value = message->GetSignal(
-      "DBW_TurnSignalState")->GetResult();
-    out.turn_signal_sync = message->GetSignal(
-      "DBW_TurnSignalSyncBit")->GetResult() ? true : false;
-    out.high_beam_state.value = message->GetSignal(
-      "DBW_HighBeamState")->GetResult();
-    out.low_beam_state.status = message->GetSignal(
-      "DBW_LowBeamState")->GetResult();
-
-    out.front_wiper_state.status = message->GetSignal(
-      "DBW_FrontWiperState")->GetResult();
-    out.rear_wiper_state.status = message->GetSignal(
-      "DBW_RearWiperState")->GetResult();
-
-    out.right_rear_door_state.value = message->GetSignal(
-      "DBW_RightRearDoorState")->GetResult();
-    out.left_rear_door_state.value = message->GetSignal(
-      "DBW_LeftRearDoorState")->GetResult();
-    out.liftgate_door_state.value = message->GetSignal(
-      "DBW_LiftgateDoorState")->GetResult();
-    out.door_lock_state.value = message->GetSignal(
-      "DBW_DoorLockState")->GetResult();
-
-    pub_other_actuators_report_->publish(out);
-  }
+  const OtherActuatorsRptSignals & sig = other_actuators_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
+
+  ReportMessage<OtherActuatorsReport> out(pub_other_actuators_report_);
+  out->header.stamp = msg->header.stamp;
+
+  out->ignition_state.status = message->GetSignal(
+    sig.DBW_IgnitionState)->GetRaw();
+  out->horn_state.status = message->GetSignal(
+    sig.DBW_HornState)->GetRaw();
+
+  out->turn_signal_state.value = message->GetSignal(
+    sig.DBW_TurnSignalState)->GetRaw();
+  out->turn_signal_sync = message->GetSignal(
+    sig.DBW_TurnSignalSyncBit)->GetRaw() ? true : false;
+  out->high_beam_state.value = message->GetSignal(
+    sig.DBW_HighBeamState)->GetRaw();
+  out->low_beam_state.status = message->GetSignal(
+    sig.DBW_LowBeamState)->GetRaw();
+
+  out->front_wiper_state.status = message->GetSignal(
+    sig.DBW_FrontWiperState)->GetRaw();
+  out->rear_wiper_state.status = message->GetSignal(
+    sig.DBW_RearWiperState)->GetRaw();
+
+  out->right_rear_door_state.value = message->GetSignal(
+    sig.DBW_RightRearDoorState)->GetRaw();
+  out->left_rear_door_state.value = message->GetSignal(
+    sig.DBW_LeftRearDoorState)->GetRaw();
+  out->liftgate_door_state.value = message->GetSignal(
+    sig.DBW_LiftgateDoorState)->GetRaw();
+  out->door_lock_state.value = message->GetSignal(
+    sig.DBW_DoorLockState)->GetRaw();
+
+  out.publish();
 }
 
 void RaptorDbwCAN::recvGpsReferenceRpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_GPS_REFERENCE_REPORT);
+  const GpsReferenceRptSignals & sig = gps_reference_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
 
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
+  ReportMessage<GpsReferenceReport> out(pub_gps_reference_report_);
+  out->header.stamp = msg->header.stamp;
 
-    GpsReferenceReport out;
-    out.header.stamp = msg->header.stamp;
+  out->ref_latitude = message->GetSignal(
+    sig.DBW_GpsRefLat)->GetResult();
 
-    out.ref_latitude = message->GetSignal(
-      "DBW_GpsRefLat")->GetResult();
+  out->ref_longitude = message->GetSignal(
+    sig.DBW_GpsRefLong)->GetResult();
 
-    out.ref_longitude = message->GetSignal(
-      "DBW_GpsRefLong")->GetResult();
+  out->ref_heading = message->GetSignal(
+    sig.Dbw_GpsHeading)->GetResult();
 
-    out.ref_heading = message->GetSignal(
-      "Dbw_GpsHeading")->GetResult();
-
-    pub_gps_reference_report_->publish(out);
-  }
+  out.publish();
 }
 
 void RaptorDbwCAN::recvGpsRemainderRpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_GPS_REMAINDER_REPORT);
-
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
+  const GpsRemainderRptSignals & sig = gps_remainder_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
 
-    GpsRemainderReport out;
-    out.header.stamp = msg->header.stamp;
+  ReportMessage<GpsRemainderReport> out(pub_gps_remainder_report_);
+  out->header.stamp = msg->header.stamp;
 
-    out.rem_latitude = message->GetSignal(
-      "DBW_GpsRemainderLat")->GetResult();
+  out->rem_latitude = message->GetSignal(
+    sig.DBW_GpsRemainderLat)->GetResult();
 
-    out.rem_longitude = message->GetSignal(
-      "DBW_GpsRemainderLong")->GetResult();
+  out->rem_longitude = message->GetSignal(
+    sig.DBW_GpsRemainderLong)->GetResult();
 
-    pub_gps_remainder_report_->publish(out);
-  }
+  out.publish();
 }
 
 void RaptorDbwCAN::recvExitRpt(const Frame::SharedPtr msg)
 {
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessageById(ID_EXIT_REPORT);
-
-  if (msg->dlc >= message->GetDlc()) {
-    message->SetFrame(msg);
+  const ExitRptSignals & sig = exit_rpt_signals_;
+  NewEagle::DbcMessage * message = sig.message;
 
-    ExitReport out;
-    out.header.stamp = msg->header.stamp;
+  ReportMessage<ExitReport> out(pub_exit_report_);
+  out->header.stamp = msg->header.stamp;
 
-    out.akit_disable = message->GetSignal(
-      "DBW_Exit_AKitDsbl")->GetResult();
+  out->akit_disable = message->GetSignal(
+    sig.DBW_Exit_AKitDsbl)->GetRaw();
 
-    out.driver_in_control = message->GetSignal(
-      "DBW_Exit_DrvInCtrl")->GetResult();
+  out->driver_in_control = message->GetSignal(
+    sig.DBW_Exit_DrvInCtrl)->GetRaw();
 
-    out.idx_auton_disable_no_brakes = message->GetSignal(
-      "DBW_Exit_AutonDsblNoBrakes")->GetResult();
+  out->idx_auton_disable_no_brakes = message->GetSignal(
+    sig.DBW_Exit_AutonDsblNoBrakes)->GetRaw();
 
-    out.idx_auton_disable_apply_brakes = message->GetSignal(
-      "DBW_Exit_AutonDsblAppyBrakes")->GetResult();
+  out->idx_auton_disable_apply_brakes = message->GetSignal(
+    sig.DBW_Exit_AutonDsblAppyBrakes)->GetRaw();
 
-    out.auton_counter = message->GetSignal(
-      "DBW_Exit_Cntr")->GetResult();
+  out->auton_counter = message->GetSignal(
+    sig.DBW_Exit_Cntr)->GetRaw();
 
-    pub_exit_report_->publish(out);
-  }
+  out.publish();
 }
 
 void RaptorDbwCAN::recvBrakeCmd(const BrakeCmd::SharedPtr msg)
 {
-  // TODO(NERaptor): add checksum support
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessage("AKit_BrakeRequest");
-
-  message->GetSignal("AKit_BrakePedalReq")->SetResult(0);
-  message->GetSignal("AKit_BrakeCtrlEnblReq")->SetResult(0);
-  message->GetSignal("AKit_BrakeCtrlReqType")->SetResult(0);
-  message->GetSignal("AKit_BrakePcntTorqueReq")->SetResult(0);
-  message->GetSignal("AKit_SpeedModeDecelLim")->SetResult(0);
-  message->GetSignal("AKit_SpeedModeNegJerkLim")->SetResult(0);
-  message->GetSignal("AKit_ParkingBrkReq")->SetResult(0);
-
-  if (enabled()) {
+  std::lock_guard<std::mutex> lock(command_mutex_);
+
+  const BrakeCmdSignals & sig = brake_cmd_signals_;
+  NewEagle::DbcMessage * message = sig.message;
+
+  message->GetSignal(sig.AKit_BrakePedalReq)->SetResult(0);
+  message->GetSignal(sig.AKit_BrakeCtrlEnblReq)->SetResult(0);
+  message->GetSignal(sig.AKit_BrakeCtrlReqType)->SetResult(0);
+  message->GetSignal(sig.AKit_BrakePcntTorqueReq)->SetResult(0);
+  message->GetSignal(sig.AKit_SpeedModeDecelLim)->SetResult(0);
+  message->GetSignal(sig.AKit_SpeedModeNegJerkLim)->SetResult(0);
+  message->GetSignal(sig.AKit_ParkingBrkReq)->SetResult(0);
+
+  if (state_.get().enabled()) {
     if (msg->control_type.value == ActuatorControlMode::OPEN_LOOP) {
-      message->GetSignal("AKit_BrakeCtrlReqType")->SetResult(0);
-      message->GetSignal("AKit_BrakePedalReq")->SetResult(msg->pedal_cmd);
+      message->GetSignal(sig.AKit_BrakeCtrlReqType)->SetResult(0);
+      message->GetSignal(sig.AKit_BrakePedalReq)->SetResult(msg->pedal_cmd);
     } else if (msg->control_type.value == ActuatorControlMode::CLOSED_LOOP_ACTUATOR) {
-      message->GetSignal("AKit_BrakeCtrlReqType")->SetResult(1);
-      message->GetSignal("AKit_BrakePcntTorqueReq")->SetResult(msg->torque_cmd);
+      message->GetSignal(sig.AKit_BrakeCtrlReqType)->SetResult(1);
+      message->GetSignal(sig.AKit_BrakePcntTorqueReq)->SetResult(msg->torque_cmd);
     } else if (msg->control_type.value == ActuatorControlMode::CLOSED_LOOP_VEHICLE) {
-      message->GetSignal("AKit_BrakeCtrlReqType")->SetResult(2);
-      message->GetSignal("AKit_SpeedModeDecelLim")->SetResult(msg->decel_limit);
-      message->GetSignal("AKit_SpeedModeNegJerkLim")->SetResult(msg->decel_negative_jerk_limit);
+      message->GetSignal(sig.AKit_BrakeCtrlReqType)->SetResult(2);
+      message->GetSignal(sig.AKit_SpeedModeDecelLim)->SetResult(msg->decel_limit);
+      message->GetSignal(sig.AKit_SpeedModeNegJerkLim)->SetResult(msg->decel_negative_jerk_limit);
     } else {
-      message->GetSignal("AKit_BrakeCtrlReqType")->SetResult(0);
+      message->GetSignal(sig.AKit_BrakeCtrlReqType)->SetResult(0);
     }
 
     if (msg->enable) {
-      message->GetSignal("AKit_BrakeCtrlEnblReq")->SetResult(1);
+      message->GetSignal(sig.AKit_BrakeCtrlEnblReq)->SetResult(1);
     }
 
     if ((msg->control_type.value == ActuatorControlMode::OPEN_LOOP) ||
       (msg->control_type.value == ActuatorControlMode::CLOSED_LOOP_ACTUATOR) ||
       (msg->control_type.value == ActuatorControlMode::CLOSED_LOOP_VEHICLE))
     {
-      message->GetSignal("AKit_ParkingBrkReq")->SetResult(msg->park_brake_cmd.status);
+      message->GetSignal(sig.AKit_ParkingBrkReq)->SetResult(msg->park_brake_cmd.status);
     }
   }
 
-  NewEagle::DbcSignal * cnt = message->GetSignal("AKit_BrakeRollingCntr");
-  cnt->SetResult(msg->rolling_counter);
+  message->GetSignal(sig.AKit_BrakeRollingCntr)->SetResult(msg->rolling_counter);
 
   Frame frame = message->GetFrame();
 
-  pub_can_->publish(frame);
+  sendFrames(&frame, 1);
 }
 
 void RaptorDbwCAN::recvAcceleratorPedalCmd(
   const AcceleratorPedalCmd::SharedPtr msg)
 {
-  // TODO(NERaptor): add checksum support
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessage("AKit_AccelPdlRequest");
-
-  message->GetSignal("AKit_AccelPdlReq")->SetResult(0);
-  message->GetSignal("AKit_AccelPdlEnblReq")->SetResult(0);
-  message->GetSignal("Akit_AccelPdlIgnoreDriverOvrd")->SetResult(0);
-  message->GetSignal("AKit_AccelPdlRollingCntr")->SetResult(0);
-  message->GetSignal("AKit_AccelReqType")->SetResult(0);
-  message->GetSignal("AKit_AccelPcntTorqueReq")->SetResult(0);
-  message->GetSignal("AKit_AccelPdlChecksum")->SetResult(0);
-  message->GetSignal("AKit_SpeedReq")->SetResult(0);
-  message->GetSignal("AKit_SpeedModeRoadSlope")->SetResult(0);
-  message->GetSignal("AKit_SpeedModeAccelLim")->SetResult(0);
-  message->GetSignal("AKit_SpeedModePosJerkLim")->SetResult(0);
-
-  if (enabled()) {
+  std::lock_guard<std::mutex> lock(command_mutex_);
+
+  const AcceleratorPedalCmdSignals & sig = accelerator_pedal_cmd_signals_;
+  NewEagle::DbcMessage * message = sig.message;
+
+  message->GetSignal(sig.AKit_AccelPdlReq)->SetResult(0);
+  message->GetSignal(sig.AKit_AccelPdlEnblReq)->SetResult(0);
+  message->GetSignal(sig.Akit_AccelPdlIgnoreDriverOvrd)->SetResult(0);
+  message->GetSignal(sig.AKit_AccelReqType)->SetResult(0);
+  message->GetSignal(sig.AKit_AccelPcntTorqueReq)->SetResult(0);
+  message->GetSignal(sig.AKit_AccelPdlChecksum)->SetResult(0);
+  message->GetSignal(sig.AKit_SpeedReq)->SetResult(0);
+  message->GetSignal(sig.AKit_SpeedModeRoadSlope)->SetResult(0);
+  message->GetSignal(sig.AKit_SpeedModeAccelLim)->SetResult(0);
+  message->GetSignal(sig.AKit_SpeedModePosJerkLim)->SetResult(0);
+
+  if (state_.get().enabled()) {
     if (msg->control_type.value == ActuatorControlMode::OPEN_LOOP) {
-      message->GetSignal("AKit_AccelReqType")->SetResult(0);
-      message->GetSignal("AKit_AccelPdlReq")->SetResult(msg->pedal_cmd);
+      message->GetSignal(sig.AKit_AccelReqType)->SetResult(0);
+      message->GetSignal(sig.AKit_AccelPdlReq)->SetResult(msg->pedal_cmd);
     } else if (msg->control_type.value == ActuatorControlMode::CLOSED_LOOP_ACTUATOR) {
-      message->GetSignal("AKit_AccelReqType")->SetResult(1);
-      message->GetSignal("AKit_AccelPcntTorqueReq")->SetResult(msg->torque_cmd);
+      message->GetSignal(sig.AKit_AccelReqType)->SetResult(1);
+      message->GetSignal(sig.AKit_AccelPcntTorqueReq)->SetResult(msg->torque_cmd);
     } else if (msg->control_type.value == ActuatorControlMode::CLOSED_LOOP_VEHICLE) {
-      message->GetSignal("AKit_AccelReqType")->SetResult(2);
-      message->GetSignal("AKit_SpeedReq")->SetResult(msg->speed_cmd);
-      message->GetSignal("AKit_SpeedModeRoadSlope")->SetResult(msg->road_slope);
-      message->GetSignal("AKit_SpeedModeAccelLim")->SetResult(msg->accel_limit);
-      message->GetSignal("AKit_SpeedModePosJerkLim")->SetResult(msg->accel_positive_jerk_limit);
+      message->GetSignal(sig.AKit_AccelReqType)->SetResult(2);
+      message->GetSignal(sig.AKit_SpeedReq)->SetResult(msg->speed_cmd);
+      message->GetSignal(sig.AKit_SpeedModeRoadSlope)->SetResult(msg->road_slope);
+      message->GetSignal(sig.AKit_SpeedModeAccelLim)->SetResult(msg->accel_limit);
+      message->GetSignal(sig.AKit_SpeedModePosJerkLim)->SetResult(msg->accel_positive_jerk_limit);
     } else {
-      message->GetSignal("AKit_AccelReqType")->SetResult(0);
+      message->GetSignal(sig.AKit_AccelReqType)->SetResult(0);
     }
 
     if (msg->enable) {
-      message->GetSignal("AKit_AccelPdlEnblReq")->SetResult(1);
+      message->GetSignal(sig.AKit_AccelPdlEnblReq)->SetResult(1);
     }
   }
 
-  NewEagle::DbcSignal * cnt = message->GetSignal("AKit_AccelPdlRollingCntr");
-  cnt->SetResult(msg->rolling_counter);
+  message->GetSignal(sig.AKit_AccelPdlRollingCntr)->SetResult(msg->rolling_counter);
 
   if (msg->ignore) {
-    message->GetSignal("Akit_AccelPdlIgnoreDriverOvrd")->SetResult(1);
-    ignores_[IGNORE_ACCEL] = true;
+    message->GetSignal(sig.Akit_AccelPdlIgnoreDriverOvrd)->SetResult(1);
+    state_.setIgnore(IGNORE_ACCEL, true);
   } else {
-    ignores_[IGNORE_ACCEL] = false;
+    state_.setIgnore(IGNORE_ACCEL, false);
   }
 
   Frame frame = message->GetFrame();
 
-  pub_can_->publish(frame);
+  sendFrames(&frame, 1);
 }
 
 void RaptorDbwCAN::recvSteeringCmd(const SteeringCmd::SharedPtr msg)
 {
-  // TODO(NERaptor): add checksum support
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessage("AKit_SteeringRequest");
-
-  message->GetSignal("AKit_SteeringWhlAngleReq")->SetResult(0);
-  message->GetSignal("AKit_SteeringWhlAngleVelocityLim")->SetResult(0);
-  message->GetSignal("AKit_SteerCtrlEnblReq")->SetResult(0);
-  message->GetSignal("AKit_SteeringWhlIgnoreDriverOvrd")->SetResult(0);
-  message->GetSignal("AKit_SteeringWhlPcntTrqReq")->SetResult(0);
-  message->GetSignal("AKit_SteeringReqType")->SetResult(0);
-  message->GetSignal("AKit_SteeringVehCurvatureReq")->SetResult(0);
-  message->GetSignal("AKit_SteeringChecksum")->SetResult(0);
-
-  if (enabled()) {
+  std::lock_guard<std::mutex> lock(command_mutex_);
+
+  const SteeringCmdSignals & sig = steering_cmd_signals_;
+  NewEagle::DbcMessage * message = sig.message;
+
+  message->GetSignal(sig.AKit_SteeringWhlAngleReq)->SetResult(0);
+  message->GetSignal(sig.AKit_SteeringWhlAngleVelocityLim)->SetResult(0);
+  message->GetSignal(sig.AKit_SteerCtrlEnblReq)->SetResult(0);
+  message->GetSignal(sig.AKit_SteeringWhlIgnoreDriverOvrd)->SetResult(0);
+  message->GetSignal(sig.AKit_SteeringWhlPcntTrqReq)->SetResult(0);
+  message->GetSignal(sig.AKit_SteeringReqType)->SetResult(0);
+  message->GetSignal(sig.AKit_SteeringVehCurvatureReq)->SetResult(0);
+  message->GetSignal(sig.AKit_SteeringChecksum)->SetResult(0);
+
+  if (state_.get().enabled()) {
     if (msg->control_type.value == ActuatorControlMode::OPEN_LOOP) {
-      message->GetSignal("AKit_SteeringReqType")->SetResult(0);
-      message->GetSignal("AKit_SteeringWhlPcntTrqReq")->SetResult(msg->torque_cmd);
+      message->GetSignal(sig.AKit_SteeringReqType)->SetResult(0);
+      message->GetSignal(sig.AKit_SteeringWhlPcntTrqReq)->SetResult(msg->torque_cmd);
     } else if (msg->control_type.value == ActuatorControlMode::CLOSED_LOOP_ACTUATOR) {
-      message->GetSignal("AKit_SteeringReqType")->SetResult(1);
+      message->GetSignal(sig.AKit_SteeringReqType)->SetResult(1);
       double scmd =
         std::max(
         -1.0F * max_steer_angle_,
         std::min(
           max_steer_angle_ * 1.0F, static_cast<float>(
             msg->angle_cmd * 1.0F)));
-      message->GetSignal("AKit_SteeringWhlAngleReq")->SetResult(scmd);
+      message->GetSignal(sig.AKit_SteeringWhlAngleReq)->SetResult(scmd);
     } else if (msg->control_type.value == ActuatorControlMode::CLOSED_LOOP_VEHICLE) {
-      message->GetSignal("AKit_SteeringReqType")->SetResult(2);
-      message->GetSignal("AKit_SteeringVehCurvatureReq")->SetResult(msg->vehicle_curvature_cmd);
+      message->GetSignal(sig.AKit_SteeringReqType)->SetResult(2);
+      message->GetSignal(sig.AKit_SteeringVehCurvatureReq)->SetResult(msg->vehicle_curvature_cmd);
     } else {
-      message->GetSignal("AKit_SteeringReqType")->SetResult(0);
+      message->GetSignal(sig.AKit_SteeringReqType)->SetResult(0);
     }
 
     if (fabsf(msg->angle_velocity) > 0) {
@@ -1086,132 +1528,137 @@ void RaptorDbwCAN::recvSteeringCmd(const SteeringCmd::SharedPtr msg)
           254.0F, static_cast<float>(
             std::roundf(std::fabs(msg->angle_velocity) / 2.0F))));
 
-      message->GetSignal("AKit_SteeringWhlAngleVelocityLim")->SetResult(vcmd);
+      message->GetSignal(sig.AKit_SteeringWhlAngleVelocityLim)->SetResult(vcmd);
     }
     if (msg->enable) {
-      message->GetSignal("AKit_SteerCtrlEnblReq")->SetResult(1);
+      message->GetSignal(sig.AKit_SteerCtrlEnblReq)->SetResult(1);
     }
   }
 
   if (msg->ignore) {
-    message->GetSignal("AKit_SteeringWhlIgnoreDriverOvrd")->SetResult(1);
-    ignores_[IGNORE_STEER] = true;
+    message->GetSignal(sig.AKit_SteeringWhlIgnoreDriverOvrd)->SetResult(1);
+    state_.setIgnore(IGNORE_STEER, true);
   } else {
-    ignores_[IGNORE_STEER] = false;
+    state_.setIgnore(IGNORE_STEER, false);
   }
 
-  message->GetSignal("AKit_SteerRollingCntr")->SetResult(msg->rolling_counter);
+  message->GetSignal(sig.AKit_SteerRollingCntr)->SetResult(msg->rolling_counter);
 
   Frame frame = message->GetFrame();
 
-  pub_can_->publish(frame);
+  sendFrames(&frame, 1);
 }
 
 void RaptorDbwCAN::recvGearCmd(const GearCmd::SharedPtr msg)
 {
-  // TODO(NERaptor): add checksum support
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessage("AKit_PrndRequest");
+  std::lock_guard<std::mutex> lock(command_mutex_);
+
+  const GearCmdSignals & sig = gear_cmd_signals_;
+  NewEagle::DbcMessage * message = sig.message;
 
-  message->GetSignal("AKit_PrndCtrlEnblReq")->SetResult(0);
-  message->GetSignal("AKit_PrndStateReq")->SetResult(0);
-  message->GetSignal("AKit_PrndChecksum")->SetResult(0);
+  message->GetSignal(sig.AKit_PrndCtrlEnblReq)->SetResult(0);
+  message->GetSignal(sig.AKit_PrndStateReq)->SetResult(0);
+  message->GetSignal(sig.AKit_PrndChecksum)->SetResult(0);
 
-  if (enabled()) {
+  if (state_.get().enabled()) {
     if (msg->enable) {
-      message->GetSignal("AKit_PrndCtrlEnblReq")->SetResult(1);
+      message->GetSignal(sig.AKit_PrndCtrlEnblReq)->SetResult(1);
     }
 
-    message->GetSignal("AKit_PrndStateReq")->SetResult(msg->cmd.gear);
+    message->GetSignal(sig.AKit_PrndStateReq)->SetResult(msg->cmd.gear);
   }
 
-  message->GetSignal("AKit_PrndRollingCntr")->SetResult(msg->rolling_counter);
+  message->GetSignal(sig.AKit_PrndRollingCntr)->SetResult(msg->rolling_counter);
 
   Frame frame = message->GetFrame();
 
-  pub_can_->publish(frame);
+  sendFrames(&frame, 1);
 }
 
 void RaptorDbwCAN::recvGlobalEnableCmd(const GlobalEnableCmd::SharedPtr msg)
 {
-  // TODO(NERaptor): add checksum support
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessage("AKit_GlobalEnbl");
+  std::lock_guard<std::mutex> lock(command_mutex_);
 
-  message->GetSignal("AKit_GlobalEnblRollingCntr")->SetResult(0);
-  message->GetSignal("AKit_GlobalByWireEnblReq")->SetResult(0);
-  message->GetSignal("AKit_EnblJoystickLimits")->SetResult(0);
-  message->GetSignal("AKit_SoftwareBuildNumber")->SetResult(0);
-  message->GetSignal("Akit_GlobalEnblChecksum")->SetResult(0);
+  const GlobalEnableCmdSignals & sig = global_enable_cmd_signals_;
+  NewEagle::DbcMessage * message = sig.message;
 
-  if (enabled()) {
+  message->GetSignal(sig.AKit_GlobalByWireEnblReq)->SetResult(0);
+  message->GetSignal(sig.AKit_EnblJoystickLimits)->SetResult(0);
+  message->GetSignal(sig.AKit_SoftwareBuildNumber)->SetResult(0);
+  message->GetSignal(sig.Akit_GlobalEnblChecksum)->SetResult(0);
+
+  if (state_.get().enabled()) {
     if (msg->global_enable) {
-      message->GetSignal("AKit_GlobalByWireEnblReq")->SetResult(1);
+      message->GetSignal(sig.AKit_GlobalByWireEnblReq)->SetResult(1);
     }
 
     if (msg->enable_joystick_limits) {
-      message->GetSignal("AKit_EnblJoystickLimits")->SetResult(1);
+      message->GetSignal(sig.AKit_EnblJoystickLimits)->SetResult(1);
     }
 
-    message->GetSignal("AKit_SoftwareBuildNumber")->SetResult(msg->ecu_build_number);
+    message->GetSignal(sig.AKit_SoftwareBuildNumber)->SetResult(msg->ecu_build_number);
   }
 
-  message->GetSignal("AKit_GlobalEnblRollingCntr")->SetResult(msg->rolling_counter);
+  message->GetSignal(sig.AKit_GlobalEnblRollingCntr)->SetResult(msg->rolling_counter);
 
   Frame frame = message->GetFrame();
 
-  pub_can_->publish(frame);
+  sendFrames(&frame, 1);
 }
 
 void RaptorDbwCAN::recvMiscCmd(const MiscCmd::SharedPtr msg)
 {
-  // TODO(NERaptor): add checksum support
-  NewEagle::DbcMessage * message = dbwDbc_.GetMessage("AKit_OtherActuators");
-
-  message->GetSignal("AKit_TurnSignalReq")->SetResult(0);
-  message->GetSignal("AKit_RightRearDoorReq")->SetResult(0);
-  message->GetSignal("AKit_HighBeamReq")->SetResult(0);
-  message->GetSignal("AKit_FrontWiperReq")->SetResult(0);
-  message->GetSignal("AKit_RearWiperReq")->SetResult(0);
-  message->GetSignal("AKit_IgnitionReq")->SetResult(0);
-  message->GetSignal("AKit_LeftRearDoorReq")->SetResult(0);
-  message->GetSignal("AKit_LiftgateDoorReq")->SetResult(0);
-  message->GetSignal("AKit_BlockBasicCruiseCtrlBtns")->SetResult(0);
-  message->GetSignal("AKit_BlockAdapCruiseCtrlBtns")->SetResult(0);
-  message->GetSignal("AKit_BlockTurnSigStalkInpts")->SetResult(0);
-  message->GetSignal("AKit_OtherChecksum")->SetResult(0);
-  message->GetSignal("AKit_HornReq")->SetResult(0);
-  message->GetSignal("AKit_LowBeamReq")->SetResult(0);
-  message->GetSignal("AKit_DoorLockReq")->SetResult(0);
-
-  if (enabled()) {
-    message->GetSignal("AKit_TurnSignalReq")->SetResult(msg->cmd.value);
-
-    message->GetSignal("AKit_RightRearDoorReq")->SetResult(msg->door_request_right_rear.value);
-    message->GetSignal("AKit_HighBeamReq")->SetResult(msg->high_beam_cmd.status);
-
-    message->GetSignal("AKit_FrontWiperReq")->SetResult(msg->front_wiper_cmd.status);
-    message->GetSignal("AKit_RearWiperReq")->SetResult(msg->rear_wiper_cmd.status);
-
-    message->GetSignal("AKit_IgnitionReq")->SetResult(msg->ignition_cmd.status);
-
-    message->GetSignal("AKit_LeftRearDoorReq")->SetResult(msg->door_request_left_rear.value);
-    message->GetSignal("AKit_LiftgateDoorReq")->SetResult(msg->door_request_lift_gate.value);
-
-    message->GetSignal("AKit_BlockBasicCruiseCtrlBtns")->SetResult(
+  std::lock_guard<std::mutex> lock(command_mutex_);
+
+  const MiscCmdSignals & sig = misc_cmd_signals_;
+  NewEagle::DbcMessage * message = sig.message;
+
+  message->GetSignal(sig.AKit_TurnSignalReq)->SetResult(0);
+  message->GetSignal(sig.AKit_RightRearDoorReq)->SetResult(0);
+  message->GetSignal(sig.AKit_HighBeamReq)->SetResult(0);
+  message->GetSignal(sig.AKit_FrontWiperReq)->SetResult(0);
+  message->GetSignal(sig.AKit_RearWiperReq)->SetResult(0);
+  message->GetSignal(sig.AKit_IgnitionReq)->SetResult(0);
+  message->GetSignal(sig.AKit_LeftRearDoorReq)->SetResult(0);
+  message->GetSignal(sig.AKit_LiftgateDoorReq)->SetResult(0);
+  message->GetSignal(sig.AKit_BlockBasicCruiseCtrlBtns)->SetResult(0);
+  message->GetSignal(sig.AKit_BlockAdapCruiseCtrlBtns)->SetResult(0);
+  message->GetSignal(sig.AKit_BlockTurnSigStalkInpts)->SetResult(0);
+  message->GetSignal(sig.AKit_OtherChecksum)->SetResult(0);
+  message->GetSignal(sig.AKit_HornReq)->SetResult(0);
+  message->GetSignal(sig.AKit_LowBeamReq)->SetResult(0);
+  message->GetSignal(sig.AKit_DoorLockReq)->SetResult(0);
+
+  if (state_.get().enabled()) {
+    message->GetSignal(sig.AKit_TurnSignalReq)->SetResult(msg->cmd.value);
+
+    message->GetSignal(sig.AKit_RightRearDoorReq)->SetResult(msg->door_request_right_rear.value);
+    message->GetSignal(sig.AKit_HighBeamReq)->SetResult(msg->high_beam_cmd.status);
+
+    message->GetSignal(sig.AKit_FrontWiperReq)->SetResult(msg->front_wiper_cmd.status);
+    message->GetSignal(sig.AKit_RearWiperReq)->SetResult(msg->rear_wiper_cmd.status);
+
+    message->GetSignal(sig.AKit_IgnitionReq)->SetResult(msg->ignition_cmd.status);
+
+    message->GetSignal(sig.AKit_LeftRearDoorReq)->SetResult(msg->door_request_left_rear.value);
+    message->GetSignal(sig.AKit_LiftgateDoorReq)->SetResult(msg->door_request_lift_gate.value);
+
+    message->GetSignal(sig.AKit_BlockBasicCruiseCtrlBtns)->SetResult(
       msg->block_standard_cruise_buttons);
-    message->GetSignal("AKit_BlockAdapCruiseCtrlBtns")->SetResult(
+    message->GetSignal(sig.AKit_BlockAdapCruiseCtrlBtns)->SetResult(
       msg->block_adaptive_cruise_buttons);
-    message->GetSignal("AKit_BlockTurnSigStalkInpts")->SetResult(msg->block_turn_signal_stalk);
+    message->GetSignal(sig.AKit_BlockTurnSigStalkInpts)->SetResult(msg->block_turn_signal_stalk);
 
-    message->GetSignal("AKit_HornReq")->SetResult(msg->horn_cmd);
-    message->GetSignal("AKit_LowBeamReq")->SetResult(msg->low_beam_cmd.status);
-    message->GetSignal("AKit_DoorLockReq")->SetResult(msg->door_lock_cmd.value);
+    message->GetSignal(sig.AKit_HornReq)->SetResult(msg->horn_cmd);
+    message->GetSignal(sig.AKit_LowBeamReq)->SetResult(msg->low_beam_cmd.status);
+    message->GetSignal(sig.AKit_DoorLockReq)->SetResult(msg->door_lock_cmd.value);
   }
 
-  message->GetSignal("AKit_OtherRollingCntr")->SetResult(msg->rolling_counter);
+  message->GetSignal(sig.AKit_OtherRollingCntr)->SetResult(msg->rolling_counter);
 
   Frame frame = message->GetFrame();
 
-  pub_can_->publish(frame);
+  sendFrames(&frame, 1);
 }
 
 /// \brief DBW Enabled needs to publish when its state changes.
@@ -1219,71 +1666,82 @@ void RaptorDbwCAN::recvMiscCmd(const MiscCmd::SharedPtr msg)
 bool RaptorDbwCAN::publishDbwEnabled()
 {
   bool change = false;
-  bool en = enabled();
-  if (enables_[EN_DBW_PREV] != en) {
-    Bool msg;
-    msg.data = en;
-    pub_sys_enable_->publish(msg);
+  DbwState::Change published = state_.publish();
+  if (published.before.published() != published.after.published()) {
+    // Another group may record a newer change before this one goes out; send the
+    // latest under the lock, so the last message is always the current state.
+    std::lock_guard<std::mutex> lock(publish_mutex_);
+    auto msg = std::make_unique<Bool>();
+    msg->data = state_.get().published();
+    pub_sys_enable_->publish(std::move(msg));
     change = true;
   }
-  enables_[EN_DBW_PREV] = en;
   return change;
 }
 
 void RaptorDbwCAN::timerCallback()
 {
-  if (clear()) {
-    Frame out;
-    out.is_extended = false;
+  std::lock_guard<std::mutex> lock(command_mutex_);
+
+  DbwState::Flags flags = state_.get();
+  if (flags.clear()) {
+    Frame out[NUM_OVERRIDES];
+    size_t count = 0;
 
-    if (overrides_[OVR_BRAKE]) {
+    if (flags.override (OVR_BRAKE)) {
       // Might have an issue with WatchdogCntr when these are set.
-      NewEagle::DbcMessage * message = dbwDbc_.GetMessage("AKit_BrakeRequest");
-      message->GetSignal("AKit_BrakePedalReq")->SetResult(0);
-      message->GetSignal("AKit_BrakeCtrlEnblReq")->SetResult(0);
+      const BrakeCmdSignals & sig = brake_cmd_signals_;
+      NewEagle::DbcMessage * message = sig.message;
+      message->GetSignal(sig.AKit_BrakePedalReq)->SetResult(0);
+      message->GetSignal(sig.AKit_BrakeCtrlEnblReq)->SetResult(0);
       // message->GetSignal("AKit_BrakePedalCtrlMode")->SetResult(0);
-      pub_can_->publish(message->GetFrame());
+      out[count++] = message->GetFrame();
     }
 
-    if (overrides_[OVR_ACCEL] && !ignores_[IGNORE_ACCEL]) {
+    if (flags.override (OVR_ACCEL) && !flags.ignore(IGNORE_ACCEL)) {
       // Might have an issue with WatchdogCntr when these are set.
-      NewEagle::DbcMessage * message = dbwDbc_.GetMessage("AKit_AccelPdlRequest");
-      message->GetSignal("AKit_AccelPdlReq")->SetResult(0);
-      message->GetSignal("AKit_AccelPdlEnblReq")->SetResult(0);
-      message->GetSignal("Akit_AccelPdlIgnoreDriverOvrd")->SetResult(0);
+      const AcceleratorPedalCmdSignals & sig = accelerator_pedal_cmd_signals_;
+      NewEagle::DbcMessage * message = sig.message;
+      message->GetSignal(sig.AKit_AccelPdlReq)->SetResult(0);
+      message->GetSignal(sig.AKit_AccelPdlEnblReq)->SetResult(0);
+      message->GetSignal(sig.Akit_AccelPdlIgnoreDriverOvrd)->SetResult(0);
       // message->GetSignal("AKit_AccelPdlCtrlMode")->SetResult(0);
-      pub_can_->publish(message->GetFrame());
+      out[count++] = message->GetFrame();
     }
 
-    if (overrides_[OVR_STEER] && !ignores_[IGNORE_STEER]) {
+    if (flags.override (OVR_STEER) && !flags.ignore(IGNORE_STEER)) {
       // Might have an issue with WatchdogCntr when these are set.
-      NewEagle::DbcMessage * message = dbwDbc_.GetMessage("AKit_SteeringRequest");
-      message->GetSignal("AKit_SteeringWhlAngleReq")->SetResult(0);
-      message->GetSignal("AKit_SteeringWhlAngleVelocityLim")->SetResult(0);
-      message->GetSignal("AKit_SteeringWhlIgnoreDriverOvrd")->SetResult(0);
-      message->GetSignal("AKit_SteeringWhlPcntTrqReq")->SetResult(0);
+      const SteeringCmdSignals & sig = steering_cmd_signals_;
+      NewEagle::DbcMessage * message = sig.message;
+      message->GetSignal(sig.AKit_SteeringWhlAngleReq)->SetResult(0);
+      message->GetSignal(sig.AKit_SteeringWhlAngleVelocityLim)->SetResult(0);
+      message->GetSignal(sig.AKit_SteeringWhlIgnoreDriverOvrd)->SetResult(0);
+      message->GetSignal(sig.AKit_SteeringWhlPcntTrqReq)->SetResult(0);
       // message->GetSignal("AKit_SteeringWhlCtrlMode")->SetResult(0);
       // message->GetSignal("AKit_SteeringWhlCmdType")->SetResult(0);
 
-      pub_can_->publish(message->GetFrame());
+      out[count++] = message->GetFrame();
     }
 
-    if (overrides_[OVR_GEAR]) {
-      NewEagle::DbcMessage * message = dbwDbc_.GetMessage("AKit_GearRequest");
-      message->GetSignal("AKit_PrndStateCmd")->SetResult(0);
-      message->GetSignal("AKit_PrndChecksum")->SetResult(0);
-      pub_can_->publish(message->GetFrame());
+    if (flags.override (OVR_GEAR)) {
+      const GearCmdSignals & sig = gear_cmd_signals_;
+      NewEagle::DbcMessage * message = sig.message;
+      message->GetSignal(sig.AKit_PrndStateReq)->SetResult(0);
+      out[count++] = message->GetFrame();
     }
+
+    sendFrames(out, count);
   }
 }
 
 void RaptorDbwCAN::enableSystem()
 {
-  if (!enables_[EN_DBW]) {
-    if (fault()) {
+  DbwState::Change change = state_.enable();
+  if (!change.before.enable()) {
+    if (!change.after.enable()) {
       int i{0};
       for (i = FAULT_ACCEL; i < NUM_SERIOUS_FAULTS; i++) {
-        if (faults_[i]) {
+        if (change.after.fault(static_cast<ListFaults>(i))) {
           std::string err_msg("DBW system disabled - ");
           err_msg = err_msg + FAULT_SYSTEM[i];
           err_msg = err_msg + " fault.";
@@ -1292,7 +1750,6 @@ void RaptorDbwCAN::enableSystem()
         }
       }
     } else {
-      enables_[EN_DBW] = true;
       if (publishDbwEnabled()) {
         RCLCPP_INFO_THROTTLE(
           this->get_logger(), m_clock, CLOCK_1_SEC,
@@ -1308,8 +1765,7 @@ void RaptorDbwCAN::enableSystem()
 
 void RaptorDbwCAN::disableSystem()
 {
-  if (enables_[EN_DBW]) {
-    enables_[EN_DBW] = false;
+  if (state_.disable().before.enable()) {
     publishDbwEnabled();
     RCLCPP_INFO_THROTTLE(
       this->get_logger(), m_clock, CLOCK_1_SEC,
@@ -1317,14 +1773,12 @@ void RaptorDbwCAN::disableSystem()
   }
 }
 
-void RaptorDbwCAN::setOverride(ListOverrides which_ovr, bool override, bool ignore)
+void RaptorDbwCAN::setOverride(ListOverrides which_ovr, bool override)
 {
   if (which_ovr < NUM_OVERRIDES) {
-    bool en = enabled();
-    if (override && en && !ignore) {
-      enables_[EN_DBW] = false;
-    }
-    overrides_[which_ovr] = override;
+    DbwState::Change change = state_.setOverride(which_ovr, override);
+    bool en = change.before.enabled();
+    bool ignore = change.before.ignored(which_ovr);
     if (publishDbwEnabled()) {
       if (en && !ignore) {
         std::string err_msg("DBW system disabled - ");
@@ -1352,25 +1806,13 @@ void RaptorDbwCAN::setOverride(ListOverrides which_ovr, bool override, bool igno
 void RaptorDbwCAN::setFault(ListFaults which_fault, bool fault)
 {
   if (which_fault < NUM_SERIOUS_FAULTS) {
-    bool en = enabled();
-    if (fault && en) {
-      enables_[EN_DBW] = false;
-    }
-    faults_[which_fault] = fault;
-    if (publishDbwEnabled()) {
-      if (en) {
-        std::string err_msg("DBW system disabled - ");
-        err_msg = err_msg + FAULT_SYSTEM[which_fault];
-        err_msg = err_msg + " fault.";
-        RCLCPP_ERROR_THROTTLE(
-          this->get_logger(), m_clock, CLOCK_1_SEC, err_msg.c_str());
-      } else {
-        std::string err_msg("DBW system enabled - no ");
-        err_msg = err_msg + FAULT_SYSTEM[which_fault];
-        err_msg = err_msg + " fault.";
-        RCLCPP_INFO_THROTTLE(
-          this->get_logger(), m_clock, CLOCK_1_SEC, err_msg.c_str());
-      }
+    DbwState::Change change = state_.setFault(which_fault, fault);
+    if (publishDbwEnabled() && change.before.enabled()) {
+      std::string err_msg("DBW system disabled - ");
+      err_msg = err_msg + FAULT_SYSTEM[which_fault];
+      err_msg = err_msg + " fault.";
+      RCLCPP_ERROR_THROTTLE(
+        this->get_logger(), m_clock, CLOCK_1_SEC, err_msg.c_str());
     }
   }
 }
@@ -1379,27 +1821,30 @@ void RaptorDbwCAN::faultWatchdog(bool fault, uint8_t src, bool braking)
 {
   setFault(FAULT_WATCH, fault);
 
-  if (braking && !faults_[FAULT_WATCH_BRAKES]) {
+  DbwState::Flags flags = state_.get();
+  if (braking && !flags.fault(FAULT_WATCH_BRAKES)) {
     RCLCPP_ERROR_THROTTLE(
       this->get_logger(), m_clock, CLOCK_1_SEC,
       "Watchdog - new braking fault.");
-  } else if (!braking && faults_[FAULT_WATCH_BRAKES]) {
+  } else if (!braking && flags.fault(FAULT_WATCH_BRAKES)) {
     RCLCPP_INFO_THROTTLE(
       this->get_logger(), m_clock, CLOCK_1_SEC,
       "Watchdog - braking fault is cleared.");
   } else {}
 
-  if (fault && src && !faults_[FAULT_WATCH_WARN]) {
+  bool warn = flags.fault(FAULT_WATCH_WARN);
+  if (fault && src && !warn) {
     RCLCPP_WARN_THROTTLE(
       this->get_logger(), m_clock, CLOCK_1_SEC,
       "Watchdog - new fault warning.");
-    faults_[FAULT_WATCH_WARN] = true;
+    warn = true;
   } else if (!fault) {
-    faults_[FAULT_WATCH_WARN] = false;
+    warn = false;
   } else {}
+  state_.setFault(FAULT_WATCH_WARN, warn);
 
-  faults_[FAULT_WATCH_BRAKES] = braking;
-  if (fault && !faults_[FAULT_WATCH_BRAKES] && faults_[FAULT_WATCH_WARN]) {
+  state_.setFault(FAULT_WATCH_BRAKES, braking);
+  if (fault && !braking && warn) {
     RCLCPP_ERROR_THROTTLE(
       this->get_logger(), m_clock, CLOCK_1_SEC,
       "Watchdog - new non-braking fault.");
@@ -1408,12 +1853,13 @@ void RaptorDbwCAN::faultWatchdog(bool fault, uint8_t src, bool braking)
 
 void RaptorDbwCAN::faultWatchdog(bool fault, uint8_t src)
 {
-  faultWatchdog(fault, src, faults_[FAULT_WATCH_BRAKES]);   // No change to 'using brakes' status
+  // No change to 'using brakes' status
+  faultWatchdog(fault, src, state_.get().fault(FAULT_WATCH_BRAKES));
 }
 
 void RaptorDbwCAN::publishJointStates(
   const rclcpp::Time stamp,
-  const WheelSpeedReport wheels)
+  const WheelSpeedReport & wheels)
 {
   double dt = stamp.seconds() - joint_state_.header.stamp.sec;
   joint_state_.velocity[JOINT_FL] = wheels.front_left;
@@ -1429,12 +1875,14 @@ void RaptorDbwCAN::publishJointStates(
     }
   }
   joint_state_.header.stamp = rclcpp::Time(stamp);
-  pub_joint_states_->publish(joint_state_);
+  ReportMessage<JointState> jointState(pub_joint_states_);
+  *jointState = joint_state_;
+  jointState.publish();
 }
 
 void RaptorDbwCAN::publishJointStates(
   const rclcpp::Time stamp,
-  const SteeringReport steering)
+  const SteeringReport & steering)
 {
   double dt = stamp.seconds() - joint_state_.header.stamp.sec;
   const double L = acker_wheelbase_;
@@ -1451,6 +1899,12 @@ void RaptorDbwCAN::publishJointStates(
     }
   }
   joint_state_.header.stamp = rclcpp::Time(stamp);
-  pub_joint_states_->publish(joint_state_);
+  ReportMessage<JointState> jointState(pub_joint_states_);
+  *jointState = joint_state_;
+  jointState.publish();
 }
 }  // namespace raptor_dbw_can
+
+#include <rclcpp_components/register_node_macro.hpp>
+
+RCLCPP_COMPONENTS_REGISTER_NODE(raptor_dbw_can::RaptorDbwCAN)
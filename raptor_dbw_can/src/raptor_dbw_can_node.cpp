@@ -35,22 +35,11 @@ int main(int argc, char ** argv)
 {
   rclcpp::init(argc, argv);
   rclcpp::NodeOptions options{};
-  rclcpp::executors::SingleThreadedExecutor exec{};
+  // One thread per callback group: commands, reports and the timer
+  rclcpp::executors::MultiThreadedExecutor exec{rclcpp::ExecutorOptions(), 3};
 
-  // Get parameter values
-  auto temp = std::make_shared<rclcpp::Node>("get_dbw_params_node", options);
-  temp->declare_parameter("dbw_dbc_file");
-  temp->declare_parameter("max_steer_angle");
-
-  std::string n_dbw_dbc_file = temp->get_parameter("dbw_dbc_file").as_string();
-  float n_max_steer_angle = temp->get_parameter("max_steer_angle").as_double();
-
-  // Create RaptorDbwCAN class
-  auto node = std::make_shared<raptor_dbw_can::RaptorDbwCAN>(
-    options,
-    n_dbw_dbc_file,
-    n_max_steer_angle
-  );
+  // Create RaptorDbwCAN class; it reads its own parameters
+  auto node = std::make_shared<raptor_dbw_can::RaptorDbwCAN>(options);
   exec.add_node(node->get_node_base_interface());
   exec.spin();
 
@@ -0,0 +1,247 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "raptor_dbw_can/socket_can.hpp"
+
+#include <errno.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace raptor_dbw_can
+{
+
+// Frames read or written per system call.
+static constexpr int MAX_BATCH = 64;
+
+// How long send() keeps retrying while no frame gets into the transmit queue.
+static constexpr int SEND_TIMEOUT_MS = 20;
+
+SocketCAN::SocketCAN(const std::string & interface)
+: fd_{-1}
+{
+  unsigned int index = if_nametoindex(interface.c_str());
+  if (0 == index) {
+    throw std::runtime_error("CAN interface " + interface + " not found");
+  }
+
+  fd_ = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+  if (fd_ < 0) {
+    throw std::runtime_error("Unable to open CAN socket: " + std::string(strerror(errno)));
+  }
+
+  // Older kernels do not know CAN FD; classic frames still work there.
+  int enable = 1;
+  setsockopt(fd_, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable));
+  enableTimestamps();
+
+  struct sockaddr_can addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.can_family = AF_CAN;
+  addr.can_ifindex = static_cast<int>(index);
+
+  if (bind(fd_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+    std::string error = strerror(errno);
+    close(fd_);
+    throw std::runtime_error("Unable to bind CAN socket to " + interface + ": " + error);
+  }
+}
+
+SocketCAN::SocketCAN(int fd)
+: fd_{fd}
+{
+  enableTimestamps();
+}
+
+SocketCAN::~SocketCAN()
+{
+  close(fd_);
+}
+
+void SocketCAN::enableTimestamps()
+{
+  // Without kernel timestamps receive() falls back to the time of the read.
+  int enable = 1;
+  setsockopt(fd_, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+}
+
+int SocketCAN::receive(ReceivedFrame * frames, int max_frames, int timeout_ms)
+{
+  struct pollfd pfd;
+  pfd.fd = fd_;
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+
+  int ready = poll(&pfd, 1, timeout_ms);
+  if (ready <= 0) {
+    return ready;
+  }
+
+  int count = (max_frames < MAX_BATCH) ? max_frames : MAX_BATCH;
+
+  struct mmsghdr msgs[MAX_BATCH];
+  struct iovec iovs[MAX_BATCH];
+  char control[MAX_BATCH][CMSG_SPACE(sizeof(struct timespec))];
+
+  memset(msgs, 0, sizeof(msgs[0]) * count);
+  for (int i = 0; i < count; i++) {
+    iovs[i].iov_base = &frames[i].frame;
+    iovs[i].iov_len = sizeof(frames[i].frame);
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_hdr.msg_control = control[i];
+    msgs[i].msg_hdr.msg_controllen = sizeof(control[i]);
+  }
+
+  int received = recvmmsg(fd_, msgs, count, MSG_DONTWAIT, NULL);
+  if (received < 0) {
+    return (EAGAIN == errno || EWOULDBLOCK == errno) ? 0 : -1;
+  }
+
+  struct timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+
+  // Drop records that are neither a classic nor an FD frame, including ones
+  // too long for the buffer.
+  int kept = 0;
+  for (int i = 0; i < received; i++) {
+    if ((CAN_MTU != msgs[i].msg_len && CANFD_MTU != msgs[i].msg_len) ||
+      (msgs[i].msg_hdr.msg_flags & MSG_TRUNC))
+    {
+      continue;
+    }
+
+    ReceivedFrame & out = frames[kept];
+    if (kept != i) {
+      memcpy(&out.frame, &frames[i].frame, msgs[i].msg_len);
+    }
+    out.fd = (CANFD_MTU == msgs[i].msg_len);
+    out.stamp = now;
+
+    for (struct cmsghdr * cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cmsg != NULL;
+      cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg))
+    {
+      if (SOL_SOCKET == cmsg->cmsg_level && SCM_TIMESTAMPNS == cmsg->cmsg_type) {
+        memcpy(&out.stamp, CMSG_DATA(cmsg), sizeof(out.stamp));
+      }
+    }
+
+    kept++;
+  }
+
+  return kept;
+}
+
+// Sets deadline to SEND_TIMEOUT_MS from now (CLOCK_MONOTONIC).
+static void sendDeadline(struct timespec * deadline)
+{
+  clock_gettime(CLOCK_MONOTONIC, deadline);
+  deadline->tv_nsec += SEND_TIMEOUT_MS * 1000000L;
+  if (deadline->tv_nsec >= 1000000000L) {
+    deadline->tv_sec += 1;
+    deadline->tv_nsec -= 1000000000L;
+  }
+}
+
+// Waits for room in the transmit queue after a send failed with error.
+// Returns false once deadline (CLOCK_MONOTONIC) has passed.
+static bool waitForRoom(int fd, int error, const struct timespec & deadline)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  int64_t remaining_ns = (deadline.tv_sec - now.tv_sec) * 1000000000LL +
+    (deadline.tv_nsec - now.tv_nsec);
+  if (remaining_ns <= 0) {
+    return false;
+  }
+
+  if (ENOBUFS == error) {
+    // A full qdisc does not clear POLLOUT, so back off instead of spinning.
+    poll(NULL, 0, 1);
+  } else {
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLOUT;
+    pfd.revents = 0;
+    poll(&pfd, 1, static_cast<int>((remaining_ns + 999999) / 1000000));
+  }
+  return true;
+}
+
+int SocketCAN::send(const struct can_frame * frames, int count)
+{
+  int sent = 0;
+
+  struct timespec deadline;
+  sendDeadline(&deadline);
+
+  while (sent < count) {
+    int batch = (count - sent < MAX_BATCH) ? count - sent : MAX_BATCH;
+
+    struct mmsghdr msgs[MAX_BATCH];
+    struct iovec iovs[MAX_BATCH];
+
+    memset(msgs, 0, sizeof(msgs[0]) * batch);
+    for (int i = 0; i < batch; i++) {
+      iovs[i].iov_base = const_cast<struct can_frame *>(&frames[sent + i]);
+      iovs[i].iov_len = CAN_MTU;
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    int result = sendmmsg(fd_, msgs, batch, 0);
+    if (result < 0) {
+      // Interrupted, or the queue is full: try the rest again.
+      if (EINTR == errno) {
+        continue;
+      }
+      if ((EAGAIN == errno || EWOULDBLOCK == errno || ENOBUFS == errno) &&
+        waitForRoom(fd_, errno, deadline))
+      {
+        continue;
+      }
+      return (0 == sent) ? -1 : sent;
+    }
+
+    sent += result;
+    sendDeadline(&deadline);
+  }
+
+  return sent;
+}
+
+}  // namespace raptor_dbw_can
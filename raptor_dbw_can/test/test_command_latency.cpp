@@ -0,0 +1,255 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+
+// Runs a RaptorDbwCAN node the way raptor_dbw_can_node does, on a three-thread
+// MultiThreadedExecutor, and times steering commands from publication to their
+// AKit_SteeringRequest frame on can_rx while brake report frames flood can_tx.
+// With commands and reports in separate callback groups, every command must
+// get its frame while the reports are still being handled. The latencies are
+// recorded as test properties rather than checked against wall-clock bounds,
+// which depend on the machine and its load.
+
+#include <gtest/gtest.h>
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <can_msgs/msg/frame.hpp>
+#include <raptor_dbw_msgs/msg/brake_report.hpp>
+#include <raptor_dbw_msgs/msg/steering_cmd.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "raptor_dbw_can/raptor_dbw_can.hpp"
+
+#ifndef RAPTOR_DBW_CAN_TEST_DBC
+#define RAPTOR_DBW_CAN_TEST_DBC ""
+#endif
+
+using can_msgs::msg::Frame;
+using raptor_dbw_msgs::msg::BrakeReport;
+using raptor_dbw_msgs::msg::SteeringCmd;
+
+namespace
+{
+const int LATENCY_COMMANDS = 200;
+
+// Only a command that never gets its frame should come near this; it is not a
+// latency bound.
+const std::chrono::milliseconds FRAME_TIMEOUT(5000);
+
+double Microseconds(std::chrono::nanoseconds latency)
+{
+  return std::chrono::duration<double, std::micro>(latency).count();
+}
+
+// A RaptorDbwCAN node on its own executor, plus a node standing in for the CAN
+// bridge and a controller, as in the command latency benchmark.
+class CommandLatencyRig
+{
+public:
+  CommandLatencyRig()
+  : dbw_exec_(rclcpp::ExecutorOptions(), 3)
+  {
+    rclcpp::NodeOptions options;
+    options.parameter_overrides(
+      {
+        rclcpp::Parameter("dbw_dbc_file", std::string(RAPTOR_DBW_CAN_TEST_DBC)),
+        rclcpp::Parameter("dbw_dbc_cache_file", std::string("")),
+      });
+    dbw_ = std::make_shared<raptor_dbw_can::RaptorDbwCAN>(options);
+
+    bridge_ = std::make_shared<rclcpp::Node>("raptor_dbw_can_test_latency");
+    pub_reports_ = bridge_->create_publisher<Frame>("can_tx", 500);
+    pub_steering_ = bridge_->create_publisher<SteeringCmd>("steering_cmd", 1);
+    sub_frames_ = bridge_->create_subscription<Frame>(
+      "can_rx", 100, [this](const Frame::SharedPtr msg)
+      {
+        if (raptor_dbw_can::ID_STEERING_CMD == msg->id) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          received_ = std::chrono::steady_clock::now();
+          frames_++;
+          frame_cv_.notify_one();
+        }
+      });
+    sub_reports_ = bridge_->create_subscription<BrakeReport>(
+      "brake_report", 20, [this](const BrakeReport::SharedPtr)
+      {
+        reports_++;
+      });
+
+    dbw_exec_.add_node(dbw_->get_node_base_interface());
+    bridge_exec_.add_node(bridge_);
+    dbw_thread_ = std::thread([this] {dbw_exec_.spin();});
+    bridge_thread_ = std::thread([this] {bridge_exec_.spin();});
+  }
+
+  ~CommandLatencyRig()
+  {
+    load_running_ = false;
+    if (load_thread_.joinable()) {
+      load_thread_.join();
+    }
+    dbw_exec_.cancel();
+    bridge_exec_.cancel();
+    dbw_thread_.join();
+    bridge_thread_.join();
+  }
+
+  // Waits for discovery, so the first timed command is not lost.
+  bool connect()
+  {
+    std::chrono::nanoseconds latency;
+    for (int i = 0; i < 50; i++) {
+      if (sendCommand(std::chrono::milliseconds(100), latency)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Floods can_tx with brake reports until the rig is destroyed.
+  void startLoad()
+  {
+    load_running_ = true;
+    load_thread_ = std::thread(
+      [this]
+      {
+        Frame frame;
+        frame.id = raptor_dbw_can::ID_BRAKE_REPORT;
+        frame.dlc = 8;
+        while (load_running_) {
+          pub_reports_->publish(frame);
+        }
+      });
+  }
+
+  // Brake reports the node has published so far.
+  size_t reports() const
+  {
+    return reports_.load();
+  }
+
+  // Publishes a steering command and waits for its frame; false on timeout.
+  bool sendCommand(std::chrono::milliseconds timeout, std::chrono::nanoseconds & latency)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    size_t before = frames_;
+    auto sent = std::chrono::steady_clock::now();
+    pub_steering_->publish(SteeringCmd());
+
+    if (!frame_cv_.wait_for(lock, timeout, [&] {return frames_ != before;})) {
+      return false;
+    }
+    latency = received_ - sent;
+    return true;
+  }
+
+private:
+  rclcpp::executors::MultiThreadedExecutor dbw_exec_;
+  rclcpp::executors::SingleThreadedExecutor bridge_exec_;
+  std::shared_ptr<raptor_dbw_can::RaptorDbwCAN> dbw_;
+  rclcpp::Node::SharedPtr bridge_;
+  rclcpp::Publisher<Frame>::SharedPtr pub_reports_;
+  rclcpp::Publisher<SteeringCmd>::SharedPtr pub_steering_;
+  rclcpp::Subscription<Frame>::SharedPtr sub_frames_;
+  rclcpp::Subscription<BrakeReport>::SharedPtr sub_reports_;
+  std::thread dbw_thread_;
+  std::thread bridge_thread_;
+  std::thread load_thread_;
+  std::atomic<bool> load_running_{false};
+  std::atomic<size_t> reports_{0};
+
+  std::mutex mutex_;
+  std::condition_variable frame_cv_;
+  size_t frames_ = 0;
+  std::chrono::steady_clock::time_point received_;
+};
+
+class CommandLatency : public ::testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestSuite()
+  {
+    rclcpp::shutdown();
+  }
+};
+}  // namespace
+
+TEST_F(CommandLatency, CommandsAreAnsweredUnderReportLoad)
+{
+  std::string file = RAPTOR_DBW_CAN_TEST_DBC;
+  if (file.empty() || !std::filesystem::exists(file)) {
+    GTEST_SKIP() << "DBC file not found: " << file;
+  }
+
+  CommandLatencyRig rig;
+  ASSERT_TRUE(rig.connect()) << "RaptorDbwCAN did not answer a steering command";
+
+  // Wait until the node is busy with the flood before timing anything.
+  rig.startLoad();
+  auto deadline = std::chrono::steady_clock::now() + FRAME_TIMEOUT;
+  while ((0 == rig.reports()) && (std::chrono::steady_clock::now() < deadline)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_GT(rig.reports(), 0u) << "RaptorDbwCAN did not handle the brake report frames";
+
+  size_t reportsBefore = rig.reports();
+  std::vector<std::chrono::nanoseconds> latencies;
+  latencies.reserve(LATENCY_COMMANDS);
+  for (int i = 0; i < LATENCY_COMMANDS; i++) {
+    std::chrono::nanoseconds latency;
+    ASSERT_TRUE(rig.sendCommand(FRAME_TIMEOUT, latency)) <<
+      "no AKit_SteeringRequest frame for command " << i;
+    latencies.push_back(latency);
+  }
+  size_t reportsDuring = rig.reports() - reportsBefore;
+
+  // The reports kept flowing while the commands were answered.
+  EXPECT_GT(reportsDuring, 0u);
+
+  std::sort(latencies.begin(), latencies.end());
+  RecordProperty("reports", static_cast<int>(reportsDuring));
+  RecordProperty(
+    "median_us", std::to_string(Microseconds(latencies[latencies.size() / 2])));
+  RecordProperty(
+    "p99_us", std::to_string(Microseconds(latencies[latencies.size() * 99 / 100])));
+  RecordProperty("max_us", std::to_string(Microseconds(latencies.back())));
+}
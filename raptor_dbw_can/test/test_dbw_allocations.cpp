@@ -0,0 +1,184 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Counts heap allocations on the per-frame DBC work of RaptorDbwCAN, through a
+// replacement operator new: loading a received report and reading its signals,
+// and filling in an AKit command and building its frame. After the first frame
+// of each message none of it may allocate. The ROS messages the node publishes
+// are not covered; BM_PublishReport in the benchmarks counts those.
+
+#include <gtest/gtest.h>
+
+#include <can_dbc_parser/Dbc.hpp>
+#include <can_dbc_parser/DbcBuilder.hpp>
+#include <can_dbc_parser/DbcMessage.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include "raptor_dbw_can/dispatch.hpp"
+
+#ifndef RAPTOR_DBW_CAN_TEST_DBC
+#define RAPTOR_DBW_CAN_TEST_DBC ""
+#endif
+
+namespace
+{
+std::atomic<size_t> allocations{0};
+}  // namespace
+
+void * operator new(size_t size)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  void * p = std::malloc(size ? size : 1);
+  if (nullptr == p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void * p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void * p, size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace
+{
+const int FRAMES = 16;
+
+// Reports RaptorDbwCAN dispatches, and the commands it sends.
+const uint32_t REPORT_IDS[] = {
+#define REPORT_ID(id, handler, minDlc) raptor_dbw_can::id,
+  RAPTOR_DBW_CAN_REPORTS(REPORT_ID)
+#undef REPORT_ID
+};
+
+const char * const COMMAND_NAMES[] = {
+  "AKit_BrakeRequest",
+  "AKit_AccelPdlRequest",
+  "AKit_SteeringRequest",
+  "AKit_PrndRequest",
+  "AKit_GlobalEnbl",
+  "AKit_OtherActuators",
+};
+
+// Keeps decoded values alive so the reads are not optimized out.
+volatile double sink;
+
+// As recvCAN and a report handler do: load the payload, read the signals.
+void ReceiveReport(NewEagle::DbcMessage & message, int frame)
+{
+  uint8_t payload[8];
+  for (size_t i = 0; i < sizeof(payload); i++) {
+    payload[i] = static_cast<uint8_t>(frame * 31 + i * 7);
+  }
+
+  message.SetFrame(payload, message.GetDlc());
+
+  for (uint32_t h = 0; h < message.GetSignalCount(); h++) {
+    const NewEagle::DbcSignal * signal = message.GetSignal(static_cast<NewEagle::SignalHandle>(h));
+    sink = signal->GetResult() + static_cast<double>(signal->GetRaw());
+  }
+}
+
+// As a command handler does: set the signals, build the frame to send.
+void SendCommand(NewEagle::DbcMessage & message, int frame)
+{
+  for (uint32_t h = 0; h < message.GetSignalCount(); h++) {
+    message.GetSignal(static_cast<NewEagle::SignalHandle>(h))->SetResult(frame & 1);
+  }
+
+  Frame out = message.GetFrame();
+  sink = out.data[0];
+}
+
+class DbwAllocations : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    std::string file = RAPTOR_DBW_CAN_TEST_DBC;
+    if (file.empty() || !std::filesystem::exists(file)) {
+      GTEST_SKIP() << "DBC file not found: " << file;
+    }
+
+    // DbcBuilder reports the size of the DBC on stdout.
+    std::streambuf * saved = std::cout.rdbuf(nullptr);
+    dbc_ = NewEagle::DbcBuilder().NewDbc(file);
+    std::cout.rdbuf(saved);
+  }
+
+  // Allocations made by FRAMES calls of process after a first, warm-up call.
+  template<typename Process>
+  size_t CountAllocations(NewEagle::DbcMessage & message, Process process)
+  {
+    process(message, 0);
+
+    size_t before = allocations.load();
+    for (int frame = 1; frame <= FRAMES; frame++) {
+      process(message, frame);
+    }
+    return allocations.load() - before;
+  }
+
+  NewEagle::Dbc dbc_;
+};
+}  // namespace
+
+TEST_F(DbwAllocations, ReportsDoNotAllocate)
+{
+  for (uint32_t id : REPORT_IDS) {
+    NewEagle::DbcMessage * message = dbc_.GetMessageById(id);
+    ASSERT_NE(nullptr, message) << "report 0x" << std::hex << id;
+
+    for (bool lazy : {false, true}) {
+      message->SetLazyDecode(lazy);
+      EXPECT_EQ(0u, CountAllocations(*message, ReceiveReport)) <<
+        message->GetName() << (lazy ? " (lazy)" : "");
+    }
+  }
+}
+
+TEST_F(DbwAllocations, CommandsDoNotAllocate)
+{
+  for (const char * name : COMMAND_NAMES) {
+    NewEagle::DbcMessage * message = dbc_.GetMessage(name);
+    ASSERT_NE(nullptr, message) << name;
+
+    EXPECT_EQ(0u, CountAllocations(*message, SendCommand)) << name;
+  }
+}
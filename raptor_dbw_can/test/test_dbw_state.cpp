@@ -0,0 +1,242 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Checks the DBW enable state machine that RaptorDbwCAN's report, command and
+// timer callback groups share: the transitions one at a time, then with faults,
+// overrides and enables racing on separate threads. test_command_latency times
+// commands through the node itself.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "raptor_dbw_can/dbw_state.hpp"
+
+using raptor_dbw_can::DbwState;
+
+namespace
+{
+const std::chrono::milliseconds RACE_TIME(200);
+}  // namespace
+
+TEST(DbwState, StartsDisabled)
+{
+  DbwState state;
+  EXPECT_FALSE(state.get().enable());
+  EXPECT_FALSE(state.get().enabled());
+
+  // The first publish announces "disabled".
+  EXPECT_TRUE(state.get().published());
+  DbwState::Change change = state.publish();
+  EXPECT_TRUE(change.before.published());
+  EXPECT_FALSE(change.after.published());
+}
+
+TEST(DbwState, PublishReportsEachChangeOnce)
+{
+  DbwState state;
+  state.publish();
+
+  state.enable();
+  DbwState::Change change = state.publish();
+  EXPECT_FALSE(change.before.published());
+  EXPECT_TRUE(change.after.published());
+
+  change = state.publish();
+  EXPECT_EQ(change.before.published(), change.after.published());
+
+  state.disable();
+  change = state.publish();
+  EXPECT_TRUE(change.before.published());
+  EXPECT_FALSE(change.after.published());
+}
+
+TEST(DbwState, EnableIsRefusedWhileFaulted)
+{
+  DbwState state;
+  state.setFault(raptor_dbw_can::FAULT_STEER, true);
+
+  DbwState::Change change = state.enable();
+  EXPECT_FALSE(change.after.enable());
+
+  state.setFault(raptor_dbw_can::FAULT_STEER, false);
+  EXPECT_FALSE(state.get().enabled());
+  EXPECT_TRUE(state.enable().after.enabled());
+}
+
+TEST(DbwState, WatchdogWarningsDoNotDisable)
+{
+  DbwState state;
+  state.enable();
+
+  state.setFault(raptor_dbw_can::FAULT_WATCH_WARN, true);
+  state.setFault(raptor_dbw_can::FAULT_WATCH_BRAKES, true);
+  EXPECT_TRUE(state.get().enabled());
+  EXPECT_TRUE(state.get().fault(raptor_dbw_can::FAULT_WATCH_WARN));
+
+  state.setFault(raptor_dbw_can::FAULT_WATCH, true);
+  EXPECT_FALSE(state.get().enable());
+}
+
+TEST(DbwState, FaultReleasesControl)
+{
+  DbwState state;
+  state.enable();
+  ASSERT_TRUE(state.get().enabled());
+
+  DbwState::Change change = state.setFault(raptor_dbw_can::FAULT_BRAKE, true);
+  EXPECT_TRUE(change.before.enabled());
+  EXPECT_FALSE(change.after.enable());
+
+  state.setFault(raptor_dbw_can::FAULT_BRAKE, false);
+  EXPECT_FALSE(state.get().enabled());
+}
+
+TEST(DbwState, FaultReleasesAnOverriddenEnable)
+{
+  // An enable requested during an override is held until the override clears,
+  // but a fault in the meantime must drop it. This is a change from the node
+  // before DbwState, whose setFault only cleared EN_DBW while DBW was enabled:
+  // there, the held enable survived the fault and took control once the
+  // override and the fault had both cleared.
+  DbwState state;
+  state.setOverride(raptor_dbw_can::OVR_BRAKE, true);
+  ASSERT_TRUE(state.enable().after.enable());
+  ASSERT_FALSE(state.get().enabled());
+
+  state.setFault(raptor_dbw_can::FAULT_ACCEL, true);
+  state.setOverride(raptor_dbw_can::OVR_BRAKE, false);
+  state.setFault(raptor_dbw_can::FAULT_ACCEL, false);
+  EXPECT_FALSE(state.get().enabled());
+}
+
+TEST(DbwState, OverrideReleasesControl)
+{
+  DbwState state;
+  state.enable();
+
+  DbwState::Change change = state.setOverride(raptor_dbw_can::OVR_GEAR, true);
+  EXPECT_TRUE(change.before.enabled());
+  EXPECT_FALSE(change.after.enable());
+
+  state.setOverride(raptor_dbw_can::OVR_GEAR, false);
+  EXPECT_FALSE(state.get().enabled());
+}
+
+TEST(DbwState, EnableHeldDuringAnOverrideTakesControlAfterIt)
+{
+  DbwState state;
+  state.setOverride(raptor_dbw_can::OVR_STEER, true);
+  state.enable();
+  EXPECT_TRUE(state.get().clear());
+  EXPECT_FALSE(state.get().enabled());
+
+  state.setOverride(raptor_dbw_can::OVR_STEER, false);
+  EXPECT_TRUE(state.get().enabled());
+}
+
+TEST(DbwState, IgnoredOverrideKeepsControl)
+{
+  DbwState state;
+  state.setIgnore(raptor_dbw_can::IGNORE_STEER, true);
+  state.enable();
+
+  DbwState::Change change = state.setOverride(raptor_dbw_can::OVR_STEER, true);
+  EXPECT_TRUE(change.before.ignored(raptor_dbw_can::OVR_STEER));
+  EXPECT_TRUE(change.after.enabled());
+
+  // Only the accelerator pedal & steering overrides can be ignored.
+  EXPECT_FALSE(change.after.ignored(raptor_dbw_can::OVR_BRAKE));
+  state.setOverride(raptor_dbw_can::OVR_BRAKE, true);
+  EXPECT_FALSE(state.get().enable());
+}
+
+TEST(DbwState, EnableNeverOutlivesAFault)
+{
+  // One thread raises & clears a fault, another keeps enabling, a third toggles
+  // an override. While the fault is up the system must stay released, and
+  // clearing the fault must never hand control back by itself.
+  // Every thread yields between steps, so they interleave even on one core.
+  DbwState state;
+  std::atomic<bool> running{true};
+  std::atomic<int> violations{0};
+  std::atomic<size_t> enables{0};
+
+  std::thread enabler([&]() {
+      while (running) {
+        DbwState::Change change = state.enable();
+        if (change.after.enable() && change.after.fault()) {
+          violations++;
+        }
+        if (change.after.enable() && !change.before.enable()) {
+          enables++;
+        }
+        std::this_thread::yield();
+      }
+    });
+  std::thread overrider([&]() {
+      bool override = false;
+      while (running) {
+        override = !override;
+        state.setOverride(raptor_dbw_can::OVR_BRAKE, override);
+        std::this_thread::yield();
+      }
+    });
+
+  size_t rounds = 0;
+  auto end = std::chrono::steady_clock::now() + RACE_TIME;
+  while (std::chrono::steady_clock::now() < end) {
+    DbwState::Change raised = state.setFault(raptor_dbw_can::FAULT_STEER, true);
+    if (raised.after.enable()) {
+      violations++;
+    }
+    std::this_thread::yield();
+    if (state.get().enable()) {
+      violations++;
+    }
+    state.setFault(raptor_dbw_can::FAULT_STEER, false);
+    std::this_thread::yield();
+    rounds++;
+  }
+
+  running = false;
+  enabler.join();
+  overrider.join();
+  EXPECT_EQ(0, violations.load());
+  RecordProperty("fault_rounds", static_cast<int>(rounds));
+  RecordProperty("enables", static_cast<int>(enables.load()));
+  EXPECT_GT(enables.load(), 0u) << "the enabler never got between two faults";
+
+  // With nothing enabling it, clearing every fault & override leaves it released.
+  state.setFault(raptor_dbw_can::FAULT_STEER, true);
+  state.setOverride(raptor_dbw_can::OVR_BRAKE, false);
+  state.setFault(raptor_dbw_can::FAULT_STEER, false);
+  EXPECT_FALSE(state.get().enabled());
+}
@@ -0,0 +1,267 @@
+// Copyright (c) 2020 New Eagle, All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the {copyright_holder} nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Runs SocketCAN over a socketpair(AF_UNIX, SOCK_SEQPACKET), which keeps record
+// boundaries like a raw CAN socket, with the test holding the other end as the
+// bus: batched receive of classic and FD frames, dropping records of any other
+// size, and batched send, including while the transmit queue is full.
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <raptor_dbw_can/socket_can.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using raptor_dbw_can::ReceivedFrame;
+using raptor_dbw_can::SocketCAN;
+
+class SocketCANPair : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    int fds[2];
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds)) << strerror(errno);
+    fd_ = fds[0];
+    bus_ = fds[1];
+    can_ = new SocketCAN(fd_);
+  }
+
+  void TearDown() override
+  {
+    delete can_;
+    close(bus_);
+  }
+
+  // Puts one record on the bus end.
+  void write(const void * record, size_t size)
+  {
+    ASSERT_EQ(static_cast<ssize_t>(size), ::send(bus_, record, size, 0)) << strerror(errno);
+  }
+
+  static struct can_frame classicFrame(uint32_t id)
+  {
+    struct can_frame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.can_id = id;
+    frame.can_dlc = 8;
+    for (int i = 0; i < 8; i++) {
+      frame.data[i] = static_cast<uint8_t>(id + i);
+    }
+    return frame;
+  }
+
+  static struct canfd_frame fdFrame(uint32_t id)
+  {
+    struct canfd_frame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.can_id = id;
+    frame.len = CANFD_MAX_DLEN;
+    for (int i = 0; i < CANFD_MAX_DLEN; i++) {
+      frame.data[i] = static_cast<uint8_t>(id * 3 + i);
+    }
+    return frame;
+  }
+
+  SocketCAN * can_;
+  int fd_;   // The end can_ owns
+  int bus_;
+};
+
+TEST_F(SocketCANPair, ReceivesClassicAndFdFrames)
+{
+  struct can_frame classic = classicFrame(0x123);
+  struct canfd_frame fd = fdFrame(0x456);
+  write(&classic, CAN_MTU);
+  write(&fd, CANFD_MTU);
+
+  ReceivedFrame frames[4];
+  ASSERT_EQ(2, can_->receive(frames, 4, 1000));
+
+  EXPECT_FALSE(frames[0].fd);
+  EXPECT_EQ(0x123u, frames[0].frame.can_id);
+  EXPECT_EQ(8, frames[0].frame.len);
+  EXPECT_EQ(0, memcmp(classic.data, frames[0].frame.data, 8));
+
+  EXPECT_TRUE(frames[1].fd);
+  EXPECT_EQ(0x456u, frames[1].frame.can_id);
+  EXPECT_EQ(CANFD_MAX_DLEN, frames[1].frame.len);
+  EXPECT_EQ(0, memcmp(fd.data, frames[1].frame.data, CANFD_MAX_DLEN));
+
+  for (int i = 0; i < 2; i++) {
+    EXPECT_TRUE(frames[i].stamp.tv_sec != 0 || frames[i].stamp.tv_nsec != 0);
+  }
+}
+
+TEST_F(SocketCANPair, DropsRecordsOfOtherSizes)
+{
+  uint8_t record[CANFD_MTU + 8];
+  memset(record, 0, sizeof(record));
+
+  struct can_frame first = classicFrame(0x100);
+  struct canfd_frame second = fdFrame(0x200);
+  struct can_frame third = classicFrame(0x300);
+
+  write(record, CAN_MTU - 1);
+  write(&first, CAN_MTU);
+  write(record, CAN_MTU + 1);
+  write(&second, CANFD_MTU);
+  write(record, sizeof(record));
+  write(&third, CAN_MTU);
+  write(record, 1);
+
+  ReceivedFrame frames[8];
+  ASSERT_EQ(3, can_->receive(frames, 8, 1000));
+
+  // Kept frames are packed to the front in order, with their payloads intact.
+  EXPECT_EQ(0x100u, frames[0].frame.can_id);
+  EXPECT_FALSE(frames[0].fd);
+  EXPECT_EQ(0, memcmp(first.data, frames[0].frame.data, 8));
+  EXPECT_EQ(0x200u, frames[1].frame.can_id);
+  EXPECT_TRUE(frames[1].fd);
+  EXPECT_EQ(0, memcmp(second.data, frames[1].frame.data, CANFD_MAX_DLEN));
+  EXPECT_EQ(0x300u, frames[2].frame.can_id);
+  EXPECT_FALSE(frames[2].fd);
+  EXPECT_EQ(0, memcmp(third.data, frames[2].frame.data, 8));
+}
+
+TEST_F(SocketCANPair, ReceiveTimesOut)
+{
+  ReceivedFrame frames[1];
+  EXPECT_EQ(0, can_->receive(frames, 1, 10));
+}
+
+TEST_F(SocketCANPair, ReceiveStopsAtCapacity)
+{
+  for (uint32_t id = 0; id < 5; id++) {
+    struct can_frame frame = classicFrame(id);
+    write(&frame, CAN_MTU);
+  }
+
+  ReceivedFrame frames[3];
+  ASSERT_EQ(3, can_->receive(frames, 3, 1000));
+  EXPECT_EQ(2u, frames[2].frame.can_id);
+  ASSERT_EQ(2, can_->receive(frames, 3, 1000));
+  EXPECT_EQ(3u, frames[0].frame.can_id);
+  EXPECT_EQ(4u, frames[1].frame.can_id);
+}
+
+TEST_F(SocketCANPair, SendsClassicFramesInOrder)
+{
+  // More than one sendmmsg batch.
+  std::vector<struct can_frame> frames;
+  for (uint32_t id = 0; id < 150; id++) {
+    frames.push_back(classicFrame(id));
+  }
+
+  // Read on another thread so the pair's buffer never limits the batch.
+  std::vector<struct can_frame> read;
+  std::thread reader([&]() {
+      while (read.size() < frames.size()) {
+        uint8_t record[CANFD_MTU];
+        ssize_t size = recv(bus_, record, sizeof(record), 0);
+        ASSERT_EQ(static_cast<ssize_t>(CAN_MTU), size);
+        struct can_frame frame;
+        memcpy(&frame, record, sizeof(frame));
+        read.push_back(frame);
+      }
+    });
+
+  EXPECT_EQ(static_cast<int>(frames.size()), can_->send(frames.data(), frames.size()));
+  reader.join();
+
+  ASSERT_EQ(frames.size(), read.size());
+  for (size_t i = 0; i < frames.size(); i++) {
+    EXPECT_EQ(0, memcmp(&frames[i], &read[i], sizeof(frames[i]))) << "frame " << i;
+  }
+}
+
+TEST_F(SocketCANPair, SendWaitsForAFullQueue)
+{
+  // Non-blocking with a small send buffer, sendmmsg sends a few frames and then
+  // fails with EAGAIN until the bus end reads some.
+  int sndbuf = 1024;
+  ASSERT_EQ(0, fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) | O_NONBLOCK));
+  ASSERT_EQ(0, setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf)));
+
+  std::vector<struct can_frame> frames;
+  for (uint32_t id = 0; id < 500; id++) {
+    frames.push_back(classicFrame(id));
+  }
+
+  // Drain slowly, a frame at a time, starting once the queue is full.
+  std::vector<struct can_frame> read;
+  std::thread reader([&]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      while (read.size() < frames.size()) {
+        struct can_frame frame;
+        ASSERT_EQ(static_cast<ssize_t>(CAN_MTU), recv(bus_, &frame, sizeof(frame), 0));
+        read.push_back(frame);
+        if (0 == read.size() % 50) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      }
+    });
+
+  EXPECT_EQ(static_cast<int>(frames.size()), can_->send(frames.data(), frames.size()));
+  reader.join();
+
+  ASSERT_EQ(frames.size(), read.size());
+  for (size_t i = 0; i < frames.size(); i++) {
+    EXPECT_EQ(frames[i].can_id, read[i].can_id) << "frame " << i;
+  }
+}
+
+TEST_F(SocketCANPair, SendGivesUpOnAStuckQueue)
+{
+  int sndbuf = 1024;
+  ASSERT_EQ(0, fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) | O_NONBLOCK));
+  ASSERT_EQ(0, setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf)));
+
+  std::vector<struct can_frame> frames(500, classicFrame(0x10));
+
+  // Nothing reads the bus end, so only what fits in the buffer goes out.
+  auto start = std::chrono::steady_clock::now();
+  int sent = can_->send(frames.data(), frames.size());
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_GT(sent, 0);
+  EXPECT_LT(sent, static_cast<int>(frames.size()));
+  EXPECT_GE(elapsed, std::chrono::milliseconds(20));
+  EXPECT_LT(elapsed, std::chrono::seconds(1));
+}
+}  // namespace
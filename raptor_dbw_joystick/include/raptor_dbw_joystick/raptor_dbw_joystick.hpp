@@ -80,19 +80,14 @@ typedef struct
 class RaptorDbwJoystick : public rclcpp::Node
 {
 public:
-/** \brief Default constructor.
+/** \brief Default constructor. Also registered as the rclcpp component
+ *    raptor_dbw_joystick::RaptorDbwJoystick.
+ *    Reads the parameters ignore (ignore driver overrides), enable (joystick
+ *    can enable/disable), svel (steering angle velocity, deg/s) and
+ *    max_steer_angle (maximum steering angle allowed, deg).
  * \param[in] options The options for this node.
- * \param[in] ignore Whether driver overrides should be ignored
- * \param[in] enable Whether joystick node can control enable/disable
- * \param[in] svel Steering angle velocity, deg/s
- * \param[in] max_steer_angle Maximum steering angle allowed, deg
  */
-  explicit RaptorDbwJoystick(
-    const rclcpp::NodeOptions & options,
-    bool ignore,
-    bool enable,
-    double svel,
-    float max_steer_angle);
+  explicit RaptorDbwJoystick(const rclcpp::NodeOptions & options);
 
 private:
   rclcpp::Clock m_clock;
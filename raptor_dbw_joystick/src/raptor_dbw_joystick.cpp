@@ -29,21 +29,17 @@
 #include "raptor_dbw_joystick/raptor_dbw_joystick.hpp"
 
 #include <memory>
+#include <utility>
 
 namespace raptor_dbw_joystick
 {
 
-RaptorDbwJoystick::RaptorDbwJoystick(
-  const rclcpp::NodeOptions & options,
-  bool ignore,
-  bool enable,
-  double svel,
-  float max_steer_angle)
+RaptorDbwJoystick::RaptorDbwJoystick(const rclcpp::NodeOptions & options)
 : Node("raptor_dbw_joystick_node", options),
-  ignore_{ignore},
-  enable_{enable},
-  svel_{svel},
-  max_steer_angle_{max_steer_angle}
+  ignore_{this->declare_parameter<bool>("ignore", false)},
+  enable_{this->declare_parameter<bool>("enable", true)},
+  svel_{this->declare_parameter<double>("svel", 0.0)},
+  max_steer_angle_{static_cast<float>(this->declare_parameter<double>("max_steer_angle", 470.0))}
 {
   data_.brake_joy = 0.0;
   data_.gear_cmd = Gear::NONE;
@@ -94,54 +90,55 @@ void RaptorDbwJoystick::cmdCallback()
   }
 
   // Accelerator Pedal
-  AcceleratorPedalCmd accelerator_pedal_msg;
-  accelerator_pedal_msg.enable = true;
-  accelerator_pedal_msg.ignore = ignore_;
-  accelerator_pedal_msg.rolling_counter = counter_;
-  accelerator_pedal_msg.pedal_cmd = data_.accelerator_pedal_joy * 100;
-  accelerator_pedal_msg.control_type.value = raptor_dbw_msgs::msg::ActuatorControlMode::OPEN_LOOP;
-  pub_accelerator_pedal_->publish(accelerator_pedal_msg);
+  auto accelerator_pedal_msg = std::make_unique<AcceleratorPedalCmd>();
+  accelerator_pedal_msg->enable = true;
+  accelerator_pedal_msg->ignore = ignore_;
+  accelerator_pedal_msg->rolling_counter = counter_;
+  accelerator_pedal_msg->pedal_cmd = data_.accelerator_pedal_joy * 100;
+  accelerator_pedal_msg->control_type.value = raptor_dbw_msgs::msg::ActuatorControlMode::OPEN_LOOP;
+  pub_accelerator_pedal_->publish(std::move(accelerator_pedal_msg));
 
   // Brake
-  BrakeCmd brake_msg;
-  brake_msg.enable = true;
-  brake_msg.rolling_counter = counter_;
-  brake_msg.pedal_cmd = data_.brake_joy * 100;
-  brake_msg.control_type.value = raptor_dbw_msgs::msg::ActuatorControlMode::OPEN_LOOP;
-  pub_brake_->publish(brake_msg);
+  auto brake_msg = std::make_unique<BrakeCmd>();
+  brake_msg->enable = true;
+  brake_msg->rolling_counter = counter_;
+  brake_msg->pedal_cmd = data_.brake_joy * 100;
+  brake_msg->control_type.value = raptor_dbw_msgs::msg::ActuatorControlMode::OPEN_LOOP;
+  pub_brake_->publish(std::move(brake_msg));
 
   // Steering
-  SteeringCmd steering_msg;
-  steering_msg.enable = true;
-  steering_msg.ignore = ignore_;
-  steering_msg.rolling_counter = counter_;
-  steering_msg.angle_cmd = data_.steering_joy;
-  steering_msg.angle_velocity = svel_;
-
-  steering_msg.control_type.value = raptor_dbw_msgs::msg::ActuatorControlMode::CLOSED_LOOP_ACTUATOR;
+  auto steering_msg = std::make_unique<SteeringCmd>();
+  steering_msg->enable = true;
+  steering_msg->ignore = ignore_;
+  steering_msg->rolling_counter = counter_;
+  steering_msg->angle_cmd = data_.steering_joy;
+  steering_msg->angle_velocity = svel_;
+
+  steering_msg->control_type.value =
+    raptor_dbw_msgs::msg::ActuatorControlMode::CLOSED_LOOP_ACTUATOR;
   if (!data_.steering_mult) {
-    steering_msg.angle_cmd *= 0.5;
+    steering_msg->angle_cmd *= 0.5;
   }
-  pub_steering_->publish(steering_msg);
+  pub_steering_->publish(std::move(steering_msg));
 
   // Gear
-  GearCmd gear_msg;
-  gear_msg.cmd.gear = data_.gear_cmd;
-  gear_msg.enable = true;
-  gear_msg.rolling_counter = counter_;
-  pub_gear_->publish(gear_msg);
+  auto gear_msg = std::make_unique<GearCmd>();
+  gear_msg->cmd.gear = data_.gear_cmd;
+  gear_msg->enable = true;
+  gear_msg->rolling_counter = counter_;
+  pub_gear_->publish(std::move(gear_msg));
 
   // Turn signal
-  MiscCmd misc_msg;
-  misc_msg.cmd.value = data_.turn_signal_cmd;
-  misc_msg.rolling_counter = counter_;
-  pub_misc_->publish(misc_msg);
-
-  GlobalEnableCmd globalEnable_msg;
-  globalEnable_msg.global_enable = true;
-  globalEnable_msg.enable_joystick_limits = true;
-  globalEnable_msg.rolling_counter = counter_;
-  pub_global_enable_->publish(globalEnable_msg);
+  auto misc_msg = std::make_unique<MiscCmd>();
+  misc_msg->cmd.value = data_.turn_signal_cmd;
+  misc_msg->rolling_counter = counter_;
+  pub_misc_->publish(std::move(misc_msg));
+
+  auto globalEnable_msg = std::make_unique<GlobalEnableCmd>();
+  globalEnable_msg->global_enable = true;
+  globalEnable_msg->enable_joystick_limits = true;
+  globalEnable_msg->rolling_counter = counter_;
+  pub_global_enable_->publish(std::move(globalEnable_msg));
 }
 
 void RaptorDbwJoystick::recvJoy(const Joy::SharedPtr msg)
@@ -224,12 +221,11 @@ void RaptorDbwJoystick::recvJoy(const Joy::SharedPtr msg)
 
   // Optional enable and disable buttons
   if (enable_) {
-    const Empty empty;
     if (msg->buttons[BTN_ENABLE]) {
-      pub_enable_->publish(empty);
+      pub_enable_->publish(std::make_unique<Empty>());
     }
     if (msg->buttons[BTN_DISABLE]) {
-      pub_disable_->publish(empty);
+      pub_disable_->publish(std::make_unique<Empty>());
     }
   }
 
@@ -238,3 +234,7 @@ void RaptorDbwJoystick::recvJoy(const Joy::SharedPtr msg)
 }
 
 }  // namespace raptor_dbw_joystick
+
+#include <rclcpp_components/register_node_macro.hpp>
+
+RCLCPP_COMPONENTS_REGISTER_NODE(raptor_dbw_joystick::RaptorDbwJoystick)
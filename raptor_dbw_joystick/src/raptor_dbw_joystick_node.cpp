@@ -37,26 +37,8 @@ int main(int argc, char ** argv)
   rclcpp::NodeOptions options{};
   rclcpp::executors::SingleThreadedExecutor exec{};
 
-  // Get parameter values
-  auto temp = std::make_shared<rclcpp::Node>("get_joy_params_node", options);
-  temp->declare_parameter("ignore");
-  temp->declare_parameter("enable");
-  temp->declare_parameter("svel");
-  temp->declare_parameter("max_steer_angle");
-
-  bool n_ignore = temp->get_parameter("ignore").as_bool();
-  bool n_enable = temp->get_parameter("enable").as_bool();
-  double n_svel = temp->get_parameter("svel").as_double();
-  float n_max_steer_angle = temp->get_parameter("max_steer_angle").as_double();
-
-  // Create RaptorDbwJoystick class
-  auto node = std::make_shared<raptor_dbw_joystick::RaptorDbwJoystick>(
-    options,
-    n_ignore,
-    n_enable,
-    n_svel,
-    n_max_steer_angle
-  );
+  // Create RaptorDbwJoystick class; it reads its own parameters
+  auto node = std::make_shared<raptor_dbw_joystick::RaptorDbwJoystick>(options);
 
   exec.add_node(node->get_node_base_interface());
   exec.spin();
@@ -47,6 +47,7 @@
 
 #include <can_dbc_parser/Dbc.hpp>
 #include <can_dbc_parser/DbcBuilder.hpp>
+#include <can_dbc_parser/DbcCache.hpp>
 #include <can_dbc_parser/DbcMessage.hpp>
 #include <can_dbc_parser/DbcSignal.hpp>
 #include <can_dbc_parser/LineParser.hpp>
@@ -71,8 +72,12 @@ class raptor_pdu : public rclcpp::Node
     RELAY_COMMAND_BASE_ADDR = 0x18ef0000  /**< Relay command message base address */
   };
 
+  static constexpr size_t RELAY_COUNT = 8;
+  static constexpr size_t FUSE_COUNT = 16;
+
 public:
-/** \brief Default constructor.
+/** \brief Default constructor. Also registered as the rclcpp component
+ *    NewEagle::raptor_pdu.
  * \param[in] options The options for this node.
  */
   explicit raptor_pdu(const rclcpp::NodeOptions & options);
@@ -91,6 +96,21 @@ private:
   NewEagle::Dbc pduDbc_;
   std::string pduFile_;
 
+  // DBC messages & signals, resolved once at startup
+  NewEagle::DbcMessage * relayStatusMessage_;
+  NewEagle::DbcMessage * fuseStatusMessage_;
+  NewEagle::DbcMessage * relayCommandMessage_;
+  NewEagle::SignalHandle relayStatusSignals_[RELAY_COUNT];
+  NewEagle::SignalHandle fuseStatusSignals_[FUSE_COUNT];
+  NewEagle::SignalHandle relayCommandSignals_[RELAY_COUNT];
+  NewEagle::SignalHandle relayCommandIdSignal_;
+  NewEagle::SignalHandle relayCommandGridSignal_;
+
+/** \brief Looks up the PDU messages & signals in the DBC file.
+ *    Throws std::runtime_error if any of them are missing.
+ */
+  void resolveDbcSignals();
+
 /** \brief Convert reports received over CAN into ROS messages.
  * \param[in] msg The message received over CAN.
  */
@@ -31,7 +31,11 @@
 // msg.relay_1.value = raptor_pdu_msgs::msg::RelayState::RELAY_ON;
 // pdu1_relay_pub_.publish(msg);
 
+#include <memory>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 #include "raptor_pdu/raptor_pdu.hpp"
 
@@ -47,8 +51,18 @@ raptor_pdu::raptor_pdu(const rclcpp::NodeOptions & options)
   relayStatusAddr_ = RELAY_STATUS_BASE_ADDR + id_;
   fuseStatusAddr_ = FUSE_STATUS_BASE_ADDR + id_;
 
+  // Compiled copy of the DBC, rebuilt automatically when the DBC file changes.
+  // Kept under $ROS_HOME by default; an empty path disables the cache.
+  std::string pduCacheFile = this->declare_parameter(
+    "pdu_dbc_cache_file", NewEagle::DbcCache::DefaultFile(pduFile_));
+
   // This should be a class, initialized with a unique CAN ID
-  pduDbc_ = NewEagle::DbcBuilder().NewDbc(pduFile_);
+  if (pduCacheFile.empty()) {
+    pduDbc_ = NewEagle::DbcBuilder().NewDbc(pduFile_);
+  } else {
+    pduDbc_ = NewEagle::DbcBuilder().NewDbc(pduFile_, pduCacheFile);
+  }
+  resolveDbcSignals();
 
   count_ = 0;
   // Set up Publishers
@@ -63,6 +77,36 @@ raptor_pdu::raptor_pdu(const rclcpp::NodeOptions & options)
     "relay_cmd", 1, std::bind(&raptor_pdu::recvRelayCmd, this, std::placeholders::_1));
 }
 
+static NewEagle::DbcMessage * requireMessage(
+  NewEagle::DbcMessage * message,
+  const std::string & name)
+{
+  if (message == NULL) {
+    throw std::runtime_error("Message " + name + " not found in DBC file");
+  }
+  return message;
+}
+
+void raptor_pdu::resolveDbcSignals()
+{
+  relayStatusMessage_ = requireMessage(pduDbc_.GetMessage("RelayStatus"), "RelayStatus");
+  fuseStatusMessage_ = requireMessage(pduDbc_.GetMessage("FuseStatus"), "FuseStatus");
+  relayCommandMessage_ = requireMessage(pduDbc_.GetMessage("RelayCommand"), "RelayCommand");
+
+  for (size_t i = 0; i < RELAY_COUNT; i++) {
+    std::string name = "Relay" + std::to_string(i + 1);
+    relayStatusSignals_[i] = relayStatusMessage_->GetSignalHandle(name);
+    relayCommandSignals_[i] = relayCommandMessage_->GetSignalHandle(name);
+  }
+
+  for (size_t i = 0; i < FUSE_COUNT; i++) {
+    fuseStatusSignals_[i] = fuseStatusMessage_->GetSignalHandle("Fuse" + std::to_string(i + 1));
+  }
+
+  relayCommandIdSignal_ = relayCommandMessage_->GetSignalHandle("MessageID");
+  relayCommandGridSignal_ = relayCommandMessage_->GetSignalHandle("GridAddress");
+}
+
 void raptor_pdu::recvCAN(const Frame::SharedPtr msg)
 {
   if (!msg->is_rtr && !msg->is_error && msg->is_extended) {
@@ -71,49 +115,49 @@ void raptor_pdu::recvCAN(const Frame::SharedPtr msg)
         this->get_logger(), m_clock, CLOCK_1_SEC,
         "Relay Status");
 
-      NewEagle::DbcMessage * message = pduDbc_.GetMessage("RelayStatus");
+      NewEagle::DbcMessage * message = relayStatusMessage_;
       message->SetFrame(msg);
 
-      RelayReport out;
+      auto out = std::make_unique<RelayReport>();
 
-      out.relay_1.value = message->GetSignal("Relay1")->GetResult();
-      out.relay_2.value = message->GetSignal("Relay2")->GetResult();
-      out.relay_3.value = message->GetSignal("Relay3")->GetResult();
-      out.relay_4.value = message->GetSignal("Relay4")->GetResult();
-      out.relay_5.value = message->GetSignal("Relay5")->GetResult();
-      out.relay_6.value = message->GetSignal("Relay6")->GetResult();
-      out.relay_7.value = message->GetSignal("Relay7")->GetResult();
-      out.relay_8.value = message->GetSignal("Relay8")->GetResult();
+      out->relay_1.value = message->GetSignal(relayStatusSignals_[0])->GetRaw();
+      out->relay_2.value = message->GetSignal(relayStatusSignals_[1])->GetRaw();
+      out->relay_3.value = message->GetSignal(relayStatusSignals_[2])->GetRaw();
+      out->relay_4.value = message->GetSignal(relayStatusSignals_[3])->GetRaw();
+      out->relay_5.value = message->GetSignal(relayStatusSignals_[4])->GetRaw();
+      out->relay_6.value = message->GetSignal(relayStatusSignals_[5])->GetRaw();
+      out->relay_7.value = message->GetSignal(relayStatusSignals_[6])->GetRaw();
+      out->relay_8.value = message->GetSignal(relayStatusSignals_[7])->GetRaw();
 
-      relay_report_pub_->publish(out);
+      relay_report_pub_->publish(std::move(out));
     } else if (msg->id == fuseStatusAddr_) {
       RCLCPP_INFO_THROTTLE(
         this->get_logger(), m_clock, CLOCK_1_SEC,
         "Fuse Status");
 
-      NewEagle::DbcMessage * message = pduDbc_.GetMessage("FuseStatus");
+      NewEagle::DbcMessage * message = fuseStatusMessage_;
       message->SetFrame(msg);
 
-      FuseReport out;
-
-      out.fuse_1.value = message->GetSignal("Fuse1")->GetResult();
-      out.fuse_2.value = message->GetSignal("Fuse2")->GetResult();
-      out.fuse_3.value = message->GetSignal("Fuse3")->GetResult();
-      out.fuse_4.value = message->GetSignal("Fuse4")->GetResult();
-      out.fuse_5.value = message->GetSignal("Fuse5")->GetResult();
-      out.fuse_6.value = message->GetSignal("Fuse6")->GetResult();
-      out.fuse_7.value = message->GetSignal("Fuse7")->GetResult();
-      out.fuse_8.value = message->GetSignal("Fuse8")->GetResult();
-      out.fuse_9.value = message->GetSignal("Fuse9")->GetResult();
-      out.fuse_10.value = message->GetSignal("Fuse10")->GetResult();
-      out.fuse_11.value = message->GetSignal("Fuse11")->GetResult();
-      out.fuse_12.value = message->GetSignal("Fuse12")->GetResult();
-      out.fuse_13.value = message->GetSignal("Fuse13")->GetResult();
-      out.fuse_14.value = message->GetSignal("Fuse14")->GetResult();
-      out.fuse_15.value = message->GetSignal("Fuse15")->GetResult();
-      out.fuse_16.value = message->GetSignal("Fuse16")->GetResult();
-
-      fuse_report_pub_->publish(out);
+      auto out = std::make_unique<FuseReport>();
+
+      out->fuse_1.value = message->GetSignal(fuseStatusSignals_[0])->GetRaw();
+      out->fuse_2.value = message->GetSignal(fuseStatusSignals_[1])->GetRaw();
+      out->fuse_3.value = message->GetSignal(fuseStatusSignals_[2])->GetRaw();
+      out->fuse_4.value = message->GetSignal(fuseStatusSignals_[3])->GetRaw();
+      out->fuse_5.value = message->GetSignal(fuseStatusSignals_[4])->GetRaw();
+      out->fuse_6.value = message->GetSignal(fuseStatusSignals_[5])->GetRaw();
+      out->fuse_7.value = message->GetSignal(fuseStatusSignals_[6])->GetRaw();
+      out->fuse_8.value = message->GetSignal(fuseStatusSignals_[7])->GetRaw();
+      out->fuse_9.value = message->GetSignal(fuseStatusSignals_[8])->GetRaw();
+      out->fuse_10.value = message->GetSignal(fuseStatusSignals_[9])->GetRaw();
+      out->fuse_11.value = message->GetSignal(fuseStatusSignals_[10])->GetRaw();
+      out->fuse_12.value = message->GetSignal(fuseStatusSignals_[11])->GetRaw();
+      out->fuse_13.value = message->GetSignal(fuseStatusSignals_[12])->GetRaw();
+      out->fuse_14.value = message->GetSignal(fuseStatusSignals_[13])->GetRaw();
+      out->fuse_15.value = message->GetSignal(fuseStatusSignals_[14])->GetRaw();
+      out->fuse_16.value = message->GetSignal(fuseStatusSignals_[15])->GetRaw();
+
+      fuse_report_pub_->publish(std::move(out));
     }
   }
 }
@@ -124,25 +168,29 @@ void raptor_pdu::recvRelayCmd(const RelayCommand::SharedPtr msg)
     this->get_logger(), m_clock, CLOCK_1_SEC,
     "Relay Command");
 
-  NewEagle::DbcMessage * message = pduDbc_.GetMessage("RelayCommand");
+  NewEagle::DbcMessage * message = relayCommandMessage_;
 
-  message->GetSignal("MessageID")->SetResult(0x80);   // Always 0x80
-  message->GetSignal("GridAddress")->SetResult(0x00);   // Always 0x00
+  message->GetSignal(relayCommandIdSignal_)->SetResult(0x80);   // Always 0x80
+  message->GetSignal(relayCommandGridSignal_)->SetResult(0x00);   // Always 0x00
 
-  message->GetSignal("Relay1")->SetResult(msg->relay_1.value);
-  message->GetSignal("Relay2")->SetResult(msg->relay_2.value);
-  message->GetSignal("Relay3")->SetResult(msg->relay_3.value);
-  message->GetSignal("Relay4")->SetResult(msg->relay_4.value);
-  message->GetSignal("Relay5")->SetResult(msg->relay_5.value);
-  message->GetSignal("Relay6")->SetResult(msg->relay_6.value);
-  message->GetSignal("Relay7")->SetResult(msg->relay_7.value);
-  message->GetSignal("Relay8")->SetResult(msg->relay_8.value);
+  message->GetSignal(relayCommandSignals_[0])->SetResult(msg->relay_1.value);
+  message->GetSignal(relayCommandSignals_[1])->SetResult(msg->relay_2.value);
+  message->GetSignal(relayCommandSignals_[2])->SetResult(msg->relay_3.value);
+  message->GetSignal(relayCommandSignals_[3])->SetResult(msg->relay_4.value);
+  message->GetSignal(relayCommandSignals_[4])->SetResult(msg->relay_5.value);
+  message->GetSignal(relayCommandSignals_[5])->SetResult(msg->relay_6.value);
+  message->GetSignal(relayCommandSignals_[6])->SetResult(msg->relay_7.value);
+  message->GetSignal(relayCommandSignals_[7])->SetResult(msg->relay_8.value);
 
-  Frame frame = message->GetFrame();
+  auto frame = std::make_unique<Frame>(message->GetFrame());
 
   // DBC file has the base address.  Modify the ID to send to correct device
-  frame.id = relayCommandAddr_;
+  frame->id = relayCommandAddr_;
 
-  pub_can_->publish(frame);
+  pub_can_->publish(std::move(frame));
 }
 }  // namespace NewEagle
+
+#include <rclcpp_components/register_node_macro.hpp>
+
+RCLCPP_COMPONENTS_REGISTER_NODE(NewEagle::raptor_pdu)